@@ -0,0 +1,296 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <iterator>
+
+#include "bitmap.h"
+
+// Definitions of the static constants:
+const int Bitmap::BITS_PER_CHUNK;
+const int Bitmap::WORDS_PER_CHUNK;
+const int Bitmap::MAX_SPARSE_CARDINALITY;
+
+Bitmap::Chunk::Chunk() : cardinality(0) {
+}
+
+bool Bitmap::Chunk::is_dense() const {
+    return !words.empty();
+}
+
+Bitmap::Bitmap() : _chunk_bytes(0) {
+}
+
+int Bitmap::popcount(uint64_t word) {
+    return __builtin_popcountll(word);
+}
+
+std::vector<uint64_t> Bitmap::words_of(const Chunk& chunk) {
+    if (chunk.is_dense())
+        return chunk.words;
+    std::vector<uint64_t> words(WORDS_PER_CHUNK, 0);
+    for (auto it = chunk.offsets.begin(); it != chunk.offsets.end(); it++)
+        words[*it >> 6] |= uint64_t(1) << (*it & 63);
+    return words;
+}
+
+size_t Bitmap::bytes_of(const Chunk& chunk) {
+    return chunk.offsets.capacity() * sizeof(uint16_t) + chunk.words.capacity() * sizeof(uint64_t);
+}
+
+void Bitmap::normalize(Chunk& chunk) {
+    if (chunk.is_dense() && chunk.cardinality <= MAX_SPARSE_CARDINALITY) {
+        chunk.offsets.clear();
+        chunk.offsets.reserve(chunk.cardinality);
+        for (int i = 0; i < WORDS_PER_CHUNK; i++)
+            for (uint64_t word = chunk.words[i]; word != 0; word &= word - 1)
+                chunk.offsets.push_back(uint16_t(i * 64 + __builtin_ctzll(word)));
+        std::vector<uint64_t>().swap(chunk.words);
+    }
+    else if (!chunk.is_dense() && chunk.cardinality > MAX_SPARSE_CARDINALITY) {
+        chunk.words = words_of(chunk);
+        std::vector<uint16_t>().swap(chunk.offsets);
+    }
+}
+
+int Bitmap::count_in_chunk(const Chunk& chunk, int from_offset, int to_offset) {
+    if (from_offset >= to_offset)
+        return 0;
+    if (!chunk.is_dense())
+        return int(std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), to_offset) -
+                   std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), from_offset));
+    if (from_offset == 0 && to_offset == BITS_PER_CHUNK)
+        return chunk.cardinality;
+    int count = 0, first_word = from_offset >> 6, last_word = (to_offset - 1) >> 6;
+    for (int i = first_word; i <= last_word; i++) {
+        uint64_t word = chunk.words[i];
+        if (i == first_word)
+            word &= ~uint64_t(0) << (from_offset & 63);
+        if (i == last_word && (to_offset & 63) != 0)
+            word &= ~uint64_t(0) >> (64 - (to_offset & 63));
+        count += popcount(word);
+    }
+    return count;
+}
+
+Bitmap::Chunk Bitmap::combine(const Chunk& lhs, const Chunk& rhs, Operation operation) {
+    Chunk result;
+    if (!lhs.is_dense() && !rhs.is_dense()) {
+        auto output = std::back_inserter(result.offsets);
+        if (operation == AND)
+            std::set_intersection(lhs.offsets.begin(), lhs.offsets.end(), rhs.offsets.begin(), rhs.offsets.end(),
+                                  output);
+        else if (operation == OR)
+            std::set_union(lhs.offsets.begin(), lhs.offsets.end(), rhs.offsets.begin(), rhs.offsets.end(), output);
+        else
+            std::set_symmetric_difference(lhs.offsets.begin(), lhs.offsets.end(), rhs.offsets.begin(),
+                                          rhs.offsets.end(), output);
+        result.cardinality = int(result.offsets.size());
+    }
+    else {
+        std::vector<uint64_t> lhs_words = words_of(lhs), rhs_words = words_of(rhs);
+        result.words.resize(WORDS_PER_CHUNK);
+        for (int i = 0; i < WORDS_PER_CHUNK; i++) {
+            if (operation == AND)
+                result.words[i] = lhs_words[i] & rhs_words[i];
+            else if (operation == OR)
+                result.words[i] = lhs_words[i] | rhs_words[i];
+            else
+                result.words[i] = lhs_words[i] ^ rhs_words[i];
+            result.cardinality += popcount(result.words[i]);
+        }
+    }
+    normalize(result);
+    return result;
+}
+
+void Bitmap::combine_with(const Bitmap& other, Operation operation) {
+    if (operation == AND) {
+        for (auto it = _chunks.begin(); it != _chunks.end();) {
+            auto other_it = other._chunks.find(it->first);
+            if (other_it != other._chunks.end())
+                it->second = combine(it->second, other_it->second, operation);
+            if (other_it == other._chunks.end() || it->second.cardinality == 0)
+                it = _chunks.erase(it);
+            else
+                it++;
+        }
+    }
+    else {
+        for (auto other_it = other._chunks.begin(); other_it != other._chunks.end(); other_it++) {
+            auto it = _chunks.find(other_it->first);
+            if (it == _chunks.end())
+                _chunks[other_it->first] = other_it->second;
+            else {
+                it->second = combine(it->second, other_it->second, operation);
+                if (it->second.cardinality == 0)
+                    _chunks.erase(it);
+            }
+        }
+    }
+    _chunk_bytes = 0;
+    for (auto it = _chunks.begin(); it != _chunks.end(); it++)
+        _chunk_bytes += bytes_of(it->second);
+}
+
+bool Bitmap::empty() const {
+    return _chunks.empty();
+}
+
+bool Bitmap::test(int index) const {
+    auto it = _chunks.find(index >> 16);
+    if (it == _chunks.end())
+        return false;
+    uint16_t offset = uint16_t(index & (BITS_PER_CHUNK - 1));
+    if (it->second.is_dense())
+        return (it->second.words[offset >> 6] >> (offset & 63)) & 1;
+    return std::binary_search(it->second.offsets.begin(), it->second.offsets.end(), offset);
+}
+
+bool Bitmap::set(int index) {
+    Chunk& chunk = _chunks[index >> 16];
+    size_t bytes = bytes_of(chunk);
+    uint16_t offset = uint16_t(index & (BITS_PER_CHUNK - 1));
+    if (chunk.is_dense()) {
+        uint64_t& word = chunk.words[offset >> 6];
+        if ((word >> (offset & 63)) & 1)
+            return false;
+        word |= uint64_t(1) << (offset & 63);
+    }
+    else {
+        auto it = std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), offset);
+        if (it != chunk.offsets.end() && *it == offset)
+            return false;
+        chunk.offsets.insert(it, offset);
+    }
+    chunk.cardinality++;
+    normalize(chunk);
+    _chunk_bytes = _chunk_bytes - bytes + bytes_of(chunk);
+    return true;
+}
+
+bool Bitmap::unset(int index) {
+    auto it = _chunks.find(index >> 16);
+    if (it == _chunks.end())
+        return false;
+    Chunk& chunk = it->second;
+    size_t bytes = bytes_of(chunk);
+    uint16_t offset = uint16_t(index & (BITS_PER_CHUNK - 1));
+    if (chunk.is_dense()) {
+        uint64_t& word = chunk.words[offset >> 6];
+        if (((word >> (offset & 63)) & 1) == 0)
+            return false;
+        word &= ~(uint64_t(1) << (offset & 63));
+    }
+    else {
+        auto offset_it = std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), offset);
+        if (offset_it == chunk.offsets.end() || *offset_it != offset)
+            return false;
+        chunk.offsets.erase(offset_it);
+    }
+    if (--chunk.cardinality == 0) {
+        _chunks.erase(it);
+        _chunk_bytes -= bytes;
+    }
+    else {
+        normalize(chunk);
+        _chunk_bytes = _chunk_bytes - bytes + bytes_of(chunk);
+    }
+    return true;
+}
+
+size_t Bitmap::memory_usage() const {
+    return _chunks.size() * (sizeof(std::pair<const int, Chunk>) + 4 * sizeof(void*)) + _chunk_bytes;
+}
+
+void Bitmap::clear() {
+    _chunks.clear();
+    _chunk_bytes = 0;
+}
+
+int Bitmap::count() const {
+    int count = 0;
+    for (auto it = _chunks.begin(); it != _chunks.end(); it++)
+        count += it->second.cardinality;
+    return count;
+}
+
+int Bitmap::count_range(int from_index, int to_index) const {
+    if (from_index >= to_index)
+        return 0;
+    int count = 0;
+    for (auto it = _chunks.lower_bound(from_index >> 16); it != _chunks.end() && it->first <= (to_index - 1) >> 16;
+         it++) {
+        int chunk_begin = it->first * BITS_PER_CHUNK;
+        count += count_in_chunk(it->second, std::max(from_index - chunk_begin, 0),
+                                std::min(to_index - chunk_begin, BITS_PER_CHUNK));
+    }
+    return count;
+}
+
+int Bitmap::first_set() const {
+    if (_chunks.empty())
+        return -1;
+    const Chunk& chunk = _chunks.begin()->second;
+    int chunk_begin = _chunks.begin()->first * BITS_PER_CHUNK;
+    if (!chunk.is_dense())
+        return chunk_begin + chunk.offsets.front();
+    for (int i = 0; i < WORDS_PER_CHUNK; i++)
+        if (chunk.words[i] != 0)
+            return chunk_begin + i * 64 + __builtin_ctzll(chunk.words[i]);
+    return -1;
+}
+
+std::vector<int> Bitmap::indexes() const {
+    std::vector<int> indexes;
+    for (auto it = _chunks.begin(); it != _chunks.end(); it++) {
+        int chunk_begin = it->first * BITS_PER_CHUNK;
+        if (!it->second.is_dense())
+            for (auto offset = it->second.offsets.begin(); offset != it->second.offsets.end(); offset++)
+                indexes.push_back(chunk_begin + *offset);
+        else
+            for (int i = 0; i < WORDS_PER_CHUNK; i++)
+                for (uint64_t word = it->second.words[i]; word != 0; word &= word - 1)
+                    indexes.push_back(chunk_begin + i * 64 + __builtin_ctzll(word));
+    }
+    return indexes;
+}
+
+void Bitmap::and_with(const Bitmap& other) {
+    if (&other != this)
+        combine_with(other, AND);
+}
+
+void Bitmap::or_with(const Bitmap& other) {
+    if (&other != this)
+        combine_with(other, OR);
+}
+
+void Bitmap::xor_with(const Bitmap& other) {
+    if (&other == this)
+        clear();
+    else
+        combine_with(other, XOR);
+}
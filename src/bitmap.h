@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_BITMAP_H
+#define KNUCKLEBALL_BITMAP_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Compressed bitmap of non-negative integers. The bits are split into chunks of 2^16 bits: sparse chunks store the
+// sorted offsets of their set bits, and dense chunks store 64-bit words, so that counting costs one population count
+// per word. Empty chunks are not stored at all.
+class Bitmap {
+private:
+    // Number of bits, words and maximum number of offsets of a sparse chunk:
+    static const int BITS_PER_CHUNK = 1 << 16;
+    static const int WORDS_PER_CHUNK = BITS_PER_CHUNK / 64;
+    static const int MAX_SPARSE_CARDINALITY = 4096;
+
+    // Binary operations between chunks:
+    enum Operation { AND, OR, XOR };
+
+    struct Chunk {
+        // Attributes:
+        int cardinality;
+        std::vector<uint16_t> offsets;
+        std::vector<uint64_t> words;
+
+        // Constructor:
+        Chunk();
+
+        // Check whether the set bits are stored as words.
+        bool is_dense() const;
+    };
+
+    // Attributes:
+    std::map<int, Chunk> _chunks;
+    size_t _chunk_bytes;
+
+    // Number of set bits in a word.
+    static int popcount(uint64_t word);
+
+    // Number of bytes of the offsets and words of chunk.
+    static size_t bytes_of(const Chunk& chunk);
+
+    // Words of chunk, whatever its representation is.
+    static std::vector<uint64_t> words_of(const Chunk& chunk);
+
+    // Switch chunk to the representation that fits its cardinality.
+    static void normalize(Chunk& chunk);
+
+    // Number of set bits of chunk whose offsets lie in [from_offset, to_offset).
+    static int count_in_chunk(const Chunk& chunk, int from_offset, int to_offset);
+
+    // Chunk holding the result of the operation between lhs and rhs.
+    static Chunk combine(const Chunk& lhs, const Chunk& rhs, Operation operation);
+
+    // Apply the operation between this bitmap and other, chunk by chunk.
+    void combine_with(const Bitmap& other, Operation operation);
+public:
+    // Constructor:
+    Bitmap();
+
+    // Check whether no bit is set.
+    bool empty() const;
+
+    // Check whether the bit at index is set.
+    bool test(int index) const;
+
+    // Set the bit at index and return true, or return false if it was already set.
+    bool set(int index);
+
+    // Unset the bit at index and return true, or return false if it was not set.
+    bool unset(int index);
+
+    // Number of bytes of the chunks.
+    size_t memory_usage() const;
+
+    // Unset all the bits.
+    void clear();
+
+    // Number of set bits.
+    int count() const;
+
+    // Number of set bits whose indexes lie in [from_index, to_index).
+    int count_range(int from_index, int to_index) const;
+
+    // Lowest index of a set bit, or -1 if no bit is set.
+    int first_set() const;
+
+    // Indexes of the set bits, in ascending order.
+    std::vector<int> indexes() const;
+
+    // Keep only the bits that are also set in other.
+    void and_with(const Bitmap& other);
+
+    // Set the bits that are set in other.
+    void or_with(const Bitmap& other);
+
+    // Flip the bits that are set in other.
+    void xor_with(const Bitmap& other);
+};
+
+#endif
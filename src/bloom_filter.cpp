@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "bloom_filter.h"
+
+// Definitions of the static constants:
+const int BloomFilter::BITS_PER_BLOCK;
+const int BloomFilter::WORDS_PER_BLOCK;
+const long long BloomFilter::MAX_BITS;
+
+BloomFilter::BloomFilter() : _offset(0), _blocks(0), _hashes(0), _count(0) {
+}
+
+BloomFilter::BloomFilter(int capacity, double false_positive_rate) : _count(0) {
+    double bits = std::min(bits_for(capacity, false_positive_rate), double(MAX_BITS));
+    _blocks = std::max(int(std::ceil(bits / BITS_PER_BLOCK)), 1);
+    _hashes = std::min(std::max(int(std::lround(bits / std::max(capacity, 1) * std::log(2.0))), 1), 16);
+    // Over-allocate one block so that the first block can start at a cache line boundary.
+    _words.assign((_blocks + 1) * WORDS_PER_BLOCK, 0);
+    _offset = int(((64 - uintptr_t(_words.data()) % 64) % 64) / sizeof(uint64_t));
+}
+
+double BloomFilter::bits_for(int capacity, double false_positive_rate) {
+    return -std::max(capacity, 1) * std::log(false_positive_rate) / (std::log(2.0) * std::log(2.0));
+}
+
+uint64_t* BloomFilter::block_of(uint64_t hash) {
+    return &_words[_offset + int((uint64_t(uint32_t(hash)) * uint64_t(_blocks)) >> 32) * WORDS_PER_BLOCK];
+}
+
+const uint64_t* BloomFilter::block_of(uint64_t hash) const {
+    return &_words[_offset + int((uint64_t(uint32_t(hash)) * uint64_t(_blocks)) >> 32) * WORDS_PER_BLOCK];
+}
+
+int BloomFilter::next_bit(uint64_t& state) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return int(state >> 55);
+}
+
+long long BloomFilter::bit_count() const {
+    return (long long) _blocks * BITS_PER_BLOCK;
+}
+
+int BloomFilter::hash_count() const {
+    return _hashes;
+}
+
+int BloomFilter::count() const {
+    return _count;
+}
+
+bool BloomFilter::add(uint64_t hash) {
+    if (_blocks == 0)
+        return false;
+    uint64_t *block = block_of(hash), state = hash;
+    bool is_new = false;
+    for (int i = 0; i < _hashes; i++) {
+        int bit = next_bit(state);
+        uint64_t mask = uint64_t(1) << (bit & 63);
+        if ((block[bit >> 6] & mask) == 0) {
+            block[bit >> 6] |= mask;
+            is_new = true;
+        }
+    }
+    if (is_new)
+        _count++;
+    return is_new;
+}
+
+bool BloomFilter::might_contain(uint64_t hash) const {
+    if (_blocks == 0)
+        return false;
+    const uint64_t *block = block_of(hash);
+    uint64_t state = hash;
+    for (int i = 0; i < _hashes; i++) {
+        int bit = next_bit(state);
+        if ((block[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0)
+            return false;
+    }
+    return true;
+}
+
+size_t BloomFilter::memory_usage() const {
+    return _words.capacity() * sizeof(uint64_t);
+}
+
+void BloomFilter::clear() {
+    std::fill(_words.begin(), _words.end(), 0);
+    _count = 0;
+}
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_BLOOM_FILTER_H
+#define KNUCKLEBALL_BLOOM_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+// Blocked Bloom filter of hashes. Each hash selects one 512-bit block, aligned to a 64-byte cache line, and sets or
+// tests all of its bits inside that block, so that a lookup touches a single cache line.
+class BloomFilter {
+public:
+    // Maximum number of bits of a filter, which is 128 MiB.
+    static const long long MAX_BITS = 1LL << 30;
+private:
+    // Number of bits and words of a block:
+    static const int BITS_PER_BLOCK = 512;
+    static const int WORDS_PER_BLOCK = BITS_PER_BLOCK / 64;
+
+    // Attributes:
+    std::vector<uint64_t> _words;
+    int _offset, _blocks, _hashes, _count;
+
+    // First word of the block selected by hash.
+    uint64_t* block_of(uint64_t hash);
+    const uint64_t* block_of(uint64_t hash) const;
+
+    // Bit of the block set by the i-th probe of hash, given the state of the previous probe.
+    static int next_bit(uint64_t& state);
+
+    // Delete copy constructor and assignment operator:
+    BloomFilter(const BloomFilter& other) = delete;
+    BloomFilter& operator=(const BloomFilter& other) = delete;
+public:
+    // Constructors:
+    BloomFilter();
+    BloomFilter(int capacity, double false_positive_rate);
+
+    // Move constructor and assignment operator:
+    BloomFilter(BloomFilter&& other) = default;
+    BloomFilter& operator=(BloomFilter&& other) = default;
+
+    // Number of bits needed to hold capacity hashes with the false positive rate, before rounding up to whole blocks.
+    static double bits_for(int capacity, double false_positive_rate);
+
+    // Number of bits and of bits set per hash.
+    long long bit_count() const;
+    int hash_count() const;
+
+    // Number of hashes added that were not reported as already present.
+    int count() const;
+
+    // Add hash and return true, or return false if it might have been added before.
+    bool add(uint64_t hash);
+
+    // Check whether hash might have been added, which is certain to be true if it was.
+    bool might_contain(uint64_t hash) const;
+
+    // Number of bytes of the bit array.
+    size_t memory_usage() const;
+
+    // Forget all the hashes added.
+    void clear();
+};
+
+#endif
@@ -23,17 +23,25 @@ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWIS
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
+#include <chrono>
 #include <ctime>
 #include <iostream>
 
 #include "context.h"
 #include "exceptions.h"
 #include "grammar.h"
+#include "interning.h"
+#include "pool.h"
 #include "str_utils.h"
 
 // Initialize the singleton instance.
 Context* Context::_instance = NULL;
 
+// Definitions of the static constants:
+const int Context::REHASH_STEPS_PER_EXECUTION;
+const int Context::EVICTION_SAMPLES;
+
 Context* Context::get_instance(const std::string& logfile_name, int float_precision, float float_comparison_tolerance,
                                bool is_quiet_mode) {
     delete _instance;
@@ -48,7 +56,10 @@ Context* Context::get_instance() {
 Context::Context(const std::string& logfile_name, int float_precision, float float_comparison_tolerance,
                  bool is_quiet_mode) : _float_precision(float_precision),
                                        _float_comparison_tolerance(float_comparison_tolerance),
-                                       _is_quiet_mode(is_quiet_mode) {
+                                       _is_quiet_mode(is_quiet_mode),
+                                       _timer_wheel(now_in_milliseconds()), _max_memory(0),
+                                       _eviction_policy("lru"), _deadlines_cursor(0),
+                                       _is_interning_strings(false) {
     if (logfile_name != "")
         _logfile.open(logfile_name, std::ios::out | std::ios::app);
 }
@@ -75,36 +86,176 @@ void Context::set_float_comparison_tolerance(float float_comparison_tolerance) {
     _float_comparison_tolerance = float_comparison_tolerance;
 }
 
+void Context::set_max_memory(size_t max_memory, const std::string& eviction_policy,
+                             const std::string& eviction_namespace) {
+    if (eviction_policy != "lru" && eviction_policy != "lfu" && eviction_policy != "ttl")
+        throw EXC_INVALID_ARGUMENT;
+    _max_memory = max_memory;
+    _eviction_policy = eviction_policy;
+    _eviction_namespace = eviction_namespace;
+}
+
+bool Context::is_interning_strings() {
+    return _is_interning_strings;
+}
+
+void Context::set_interning_strings(bool is_interning_strings) {
+    _is_interning_strings = is_interning_strings;
+}
+
+int64_t Context::now_in_milliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Context::set_deadline(const std::string& name, int64_t deadline) {
+    _deadlines[name] = deadline;
+    _timer_wheel.schedule(name, deadline);
+}
+
+bool Context::expire_if_due(const std::string& name) {
+    auto it = _deadlines.find(name);
+    if (it == _deadlines.end() || it->second > now_in_milliseconds())
+        return false;
+    _deadlines.erase(it);
+    _keyspace.erase(name);
+    return true;
+}
+
+std::vector<std::string> Context::sample_deadlines() {
+    std::vector<std::string> names;
+    size_t buckets = _deadlines.bucket_count();
+    for (size_t i = 0; i < buckets && !_deadlines.empty() && int(names.size()) < EVICTION_SAMPLES; i++) {
+        size_t bucket = _deadlines_cursor++ % buckets;
+        for (auto it = _deadlines.begin(bucket); it != _deadlines.end(bucket); it++)
+            if (_eviction_namespace == "" || Keyspace::namespace_of(it->first) == _eviction_namespace)
+                names.push_back(it->first);
+    }
+    return names;
+}
+
+std::string Context::eviction_candidate() {
+    std::string candidate;
+    if (_eviction_policy == "ttl") {
+        std::vector<std::string> names = sample_deadlines();
+        for (auto it = names.begin(); it != names.end(); it++)
+            if (candidate == "" || _deadlines[*it] < _deadlines[candidate])
+                candidate = *it;
+        if (candidate != "")
+            return candidate;
+    }
+    std::vector<std::string> names = _keyspace.sample(EVICTION_SAMPLES, _eviction_namespace);
+    for (auto it = names.begin(); it != names.end(); it++) {
+        if (candidate == "")
+            candidate = *it;
+        else if (_eviction_policy == "lfu" && _keyspace.frequency(*it) != _keyspace.frequency(candidate)) {
+            if (_keyspace.frequency(*it) < _keyspace.frequency(candidate))
+                candidate = *it;
+        }
+        else if (_keyspace.idle_time(*it) > _keyspace.idle_time(candidate))
+            candidate = *it;
+    }
+    return candidate;
+}
+
+int64_t Context::memory_usage() const {
+    return _keyspace.memory_usage() + int64_t(interning::bytes());
+}
+
+void Context::evict_if_needed() {
+    while (_max_memory > 0 && memory_usage() > int64_t(_max_memory)) {
+        std::string name = eviction_candidate();
+        if (name == "")
+            return;
+        _keyspace.erase(name);
+        _deadlines.erase(name);
+    }
+}
+
+std::shared_ptr<Instance> Context::get_variable(const std::string& name) {
+    expire_if_due(name);
+    std::shared_ptr<Instance> instance = _keyspace.find(name);
+    if (!instance)
+        throw EXC_UNEXISTENT_VARIABLE;
+    return instance;
+}
+
 std::string Context::execute_in_type(const Parser& parser) {
     std::shared_ptr<Instance> instance;
     std::string type = str_utils::remove_spaces(parser.actor());
     std::string message_name = parser.message_name();
+    std::vector<std::string> arguments = parser.arguments();
+    int ttl = -1;
+    if (str_utils::ends_with(message_name, "withTTL:")) {
+        ttl = IntegerInstance(arguments.back()).value();
+        if (ttl < 0)
+            throw EXC_INVALID_ARGUMENT;
+        message_name = message_name.substr(0, int(message_name.size()) - 8);
+        arguments.pop_back();
+    }
     if (type == "Boolean")
-        instance = std::make_shared<BooleanInstance>(message_name, parser.arguments());
+        instance = std::make_shared<BooleanInstance>(message_name, arguments);
     else if (type == "Character")
-        instance = std::make_shared<CharacterInstance>(message_name, parser.arguments());
+        instance = std::make_shared<CharacterInstance>(message_name, arguments);
     else if (type == "Integer")
-        instance = std::make_shared<IntegerInstance>(message_name, parser.arguments());
+        instance = std::make_shared<IntegerInstance>(message_name, arguments);
     else if (type == "Float")
-        instance = std::make_shared<FloatInstance>(message_name, parser.arguments());
+        instance = std::make_shared<FloatInstance>(message_name, arguments);
     else if (type == "String")
-        instance = std::make_shared<StringInstance>(message_name, parser.arguments());
+        instance = std::make_shared<StringInstance>(message_name, arguments);
     else if (str_utils::starts_with(type, "Vector"))
         instance = std::make_shared<VectorInstance>(type.substr(7, int(type.size()) - 8), message_name,
-                                                    parser.arguments());
+                                                    arguments);
     else if (str_utils::starts_with(type, "Set"))
         instance = std::make_shared<SetInstance>(type.substr(4, int(type.size()) - 5), message_name,
-                                                 parser.arguments());
+                                                 arguments);
+    else if (str_utils::starts_with(type, "SortedSet"))
+        instance = std::make_shared<SortedSetInstance>(type.substr(10, int(type.size()) - 11), message_name,
+                                                       arguments);
+    else if (str_utils::starts_with(type, "Multiset"))
+        instance = std::make_shared<MultisetInstance>(type.substr(9, int(type.size()) - 10), message_name,
+                                                      arguments);
     else if (str_utils::starts_with(type, "Dictionary")) {
         std::string types_of_dictionary = type.substr(11, int(type.size()) - 12);
         for (int i = 0; i < int(types_of_dictionary.size()); i++)
             if (types_of_dictionary[i] == ',')
                 instance = std::make_shared<DictionaryInstance>(types_of_dictionary.substr(0, i),
                                                                 types_of_dictionary.substr(i + 1),
-                                                                message_name, parser.arguments());
+                                                                message_name, arguments);
+    }
+    else if (str_utils::starts_with(type, "Multidictionary")) {
+        std::string types_of_multidictionary = type.substr(16, int(type.size()) - 17);
+        for (int i = 0; i < int(types_of_multidictionary.size()); i++)
+            if (types_of_multidictionary[i] == ',')
+                instance = std::make_shared<MultidictionaryInstance>(types_of_multidictionary.substr(0, i),
+                                                                     types_of_multidictionary.substr(i + 1),
+                                                                     message_name, arguments);
     }
-    if (_instances.find(instance->name()) == _instances.end()) {
-        _instances[instance->name()] = instance;
+    else if (str_utils::starts_with(type, "PriorityQueue"))
+        instance = std::make_shared<PriorityQueueInstance>(type.substr(14, int(type.size()) - 15), message_name,
+                                                           arguments);
+    else if (str_utils::starts_with(type, "Stream"))
+        instance = std::make_shared<StreamInstance>(type.substr(7, int(type.size()) - 8), message_name,
+                                                    arguments);
+    else if (type == "Bitmap")
+        instance = std::make_shared<BitmapInstance>(message_name, arguments);
+    else if (type == "TimeSeries")
+        instance = std::make_shared<TimeSeriesInstance>(message_name, arguments);
+    else if (str_utils::starts_with(type, "HyperLogLog"))
+        instance = std::make_shared<HyperLogLogInstance>(type.substr(12, int(type.size()) - 13), message_name,
+                                                         arguments);
+    else if (str_utils::starts_with(type, "BloomFilter"))
+        instance = std::make_shared<BloomFilterInstance>(type.substr(12, int(type.size()) - 13), message_name,
+                                                         arguments);
+    else if (str_utils::starts_with(type, "CountMinSketch"))
+        instance = std::make_shared<CountMinSketchInstance>(type.substr(15, int(type.size()) - 16), message_name,
+                                                            arguments);
+    const std::string& name = arguments[0];
+    expire_if_due(name);
+    if (_keyspace.insert(name, instance)) {
+        _keyspace.set_memory_usage(name, instance->memory_usage());
+        if (ttl >= 0)
+            set_deadline(name, now_in_milliseconds() + ttl);
         return "null";
     }
     if (str_utils::starts_with(message_name, "createIfNotExists:"))
@@ -124,6 +275,22 @@ std::string Context::execute_in_context(const Parser& parser) {
         return op_deleteVariable(parser.arguments());
     else if (message_name == "deleteVariablesOfNamespace:")
         return op_deleteVariablesOfNamespace(parser.arguments());
+    else if (message_name == "expireVariable:afterMilliseconds:")
+        return op_expireVariable_afterMilliseconds(parser.arguments());
+    else if (message_name == "ttlOfVariable:")
+        return op_ttlOfVariable(parser.arguments());
+    else if (message_name == "getAll:")
+        return op_getAll(parser.arguments());
+    else if (message_name == "keyspaceStats")
+        return op_keyspaceStats(parser.arguments());
+    else if (message_name == "memoryByNamespace")
+        return op_memoryByNamespace(parser.arguments());
+    else if (message_name == "biggestVariables:")
+        return op_biggestVariables(parser.arguments());
+    else if (message_name == "poolStats")
+        return op_poolStats(parser.arguments());
+    else if (message_name == "internStats")
+        return op_internStats(parser.arguments());
     else if (message_name == "getFloatPrecision")
         return op_getFloatPrecision(parser.arguments());
     else if (message_name == "setFloatPrecision:")
@@ -136,13 +303,38 @@ std::string Context::execute_in_context(const Parser& parser) {
 }
 
 std::string Context::execute_in_variable(const Parser& parser) {
-    auto instance = _instances.find(parser.actor());
-    if (instance == _instances.end())
-        throw EXC_UNEXISTENT_VARIABLE;
-    return instance->second->receive(parser.message_name(), parser.arguments());
+    std::string name = parser.actor();
+    std::shared_ptr<Instance> instance = get_variable(name);
+    if (parser.message_name() == "memoryUsage")
+        return std::to_string(_keyspace.memory_usage(name));
+    std::string output;
+    try {
+        output = instance->receive(parser.message_name(), parser.arguments());
+    }
+    catch (...) {
+        _keyspace.set_memory_usage(name, instance->memory_usage());
+        throw;
+    }
+    _keyspace.set_memory_usage(name, instance->memory_usage());
+    return output;
+}
+
+void Context::rehash_keyspace(int milliseconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    while (_keyspace.rehash(100))
+        if (std::chrono::steady_clock::now() >= deadline)
+            break;
+}
+
+void Context::expire_variables() {
+    std::vector<std::string> names = _timer_wheel.advance(now_in_milliseconds());
+    for (auto it = names.begin(); it != names.end(); it++)
+        expire_if_due(*it);
 }
 
 std::string Context::execute(const std::string& input, std::shared_ptr<Session> session) {
+    _keyspace.rehash(REHASH_STEPS_PER_EXECUTION);
+    int64_t previous_memory_usage = memory_usage();
     std::string output;
     try {
         Parser parser(input);
@@ -162,6 +354,8 @@ std::string Context::execute(const std::string& input, std::shared_ptr<Session>
     catch (...) {
         output = std::string(EXC_UNKNOWN_ERROR);
     }
+    if (memory_usage() > previous_memory_usage)
+        evict_if_needed();
     char timestamp[32];
     time_t now = time(NULL);
     strftime(timestamp, sizeof(timestamp), "[%F %T]", localtime(&now));
@@ -175,11 +369,8 @@ std::string Context::execute(const std::string& input, std::shared_ptr<Session>
 std::string Context::op_listNamespaces(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::set<std::string> namespaces;
-    for (auto it = _instances.begin(); it != _instances.end(); it++)
-        for (int i = 0; i < int(it->first.size()) - 1; i++)
-            if (it->first[i] == ':' && it->first[i + 1] == ':')
-                namespaces.insert(it->first.substr(0, i));
+    expire_variables();
+    std::vector<std::string> namespaces = _keyspace.namespaces();
     std::string elements_str;
     for (auto it = namespaces.begin(); it != namespaces.end(); it++) {
         if (it != namespaces.begin())
@@ -192,11 +383,13 @@ std::string Context::op_listNamespaces(const std::vector<std::string>& arguments
 std::string Context::op_listVariables(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    expire_variables();
+    std::vector<std::string> names = _keyspace.names();
     std::string elements_str;
-    for (auto it = _instances.begin(); it != _instances.end(); it++) {
-        if (it != _instances.begin())
+    for (auto it = names.begin(); it != names.end(); it++) {
+        if (it != names.begin())
             elements_str += ",";
-        elements_str += it->first;
+        elements_str += *it;
     }
     return "[" + elements_str + "]";
 }
@@ -206,13 +399,13 @@ std::string Context::op_listVariablesOfNamespace(const std::vector<std::string>&
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     if (!Grammar::is_namespace(arguments[0]))
         throw EXC_INVALID_ARGUMENT;
+    expire_variables();
+    std::vector<std::string> names = _keyspace.names_of_namespace(arguments[0]);
     std::string elements_str;
-    for (auto it = _instances.begin(); it != _instances.end(); it++) {
-        if (!str_utils::starts_with(it->first, arguments[0] + "::"))
-            continue;
-        if (elements_str.size() > 0)
+    for (auto it = names.begin(); it != names.end(); it++) {
+        if (it != names.begin())
             elements_str += ",";
-        elements_str += it->first;
+        elements_str += *it;
     }
     return "[" + elements_str + "]";
 }
@@ -222,12 +415,10 @@ std::string Context::op_deleteVariable(const std::vector<std::string>& arguments
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     if (!Grammar::is_variable(arguments[0]))
         throw EXC_INVALID_ARGUMENT;
-    for (auto it = _instances.begin(); it != _instances.end(); it++)
-        if (it->first == arguments[0]) {
-            _instances.erase(it);
-            return "null";
-        }
-    throw EXC_UNEXISTENT_VARIABLE;
+    if (expire_if_due(arguments[0]) || !_keyspace.erase(arguments[0]))
+        throw EXC_UNEXISTENT_VARIABLE;
+    _deadlines.erase(arguments[0]);
+    return "null";
 }
 
 std::string Context::op_deleteVariablesOfNamespace(const std::vector<std::string>& arguments) {
@@ -235,15 +426,129 @@ std::string Context::op_deleteVariablesOfNamespace(const std::vector<std::string
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     if (!Grammar::is_namespace(arguments[0]))
         throw EXC_INVALID_ARGUMENT;
-    std::vector<std::map<std::string, std::shared_ptr<Instance>>::iterator> instances_to_be_deleted;
-    for (auto it = _instances.begin(); it != _instances.end(); it++)
-        if (str_utils::starts_with(it->first, arguments[0] + "::"))
-            instances_to_be_deleted.push_back(it);
-    for (auto it = instances_to_be_deleted.begin(); it != instances_to_be_deleted.end(); it++)
-        _instances.erase(*it);
+    if (!_deadlines.empty()) {
+        std::vector<std::string> names = _keyspace.names_of_namespace(arguments[0]);
+        for (auto it = names.begin(); it != names.end(); it++)
+            _deadlines.erase(*it);
+    }
+    _keyspace.erase_namespace(arguments[0]);
+    return "null";
+}
+
+std::string Context::op_expireVariable_afterMilliseconds(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_variable(arguments[0]))
+        throw EXC_INVALID_ARGUMENT;
+    int milliseconds = IntegerInstance(arguments[1]).value();
+    if (milliseconds < 0)
+        throw EXC_INVALID_ARGUMENT;
+    get_variable(arguments[0]);
+    set_deadline(arguments[0], now_in_milliseconds() + milliseconds);
     return "null";
 }
 
+std::string Context::op_ttlOfVariable(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_variable(arguments[0]))
+        throw EXC_INVALID_ARGUMENT;
+    get_variable(arguments[0]);
+    auto it = _deadlines.find(arguments[0]);
+    if (it == _deadlines.end())
+        return IntegerInstance(-1).representation();
+    return IntegerInstance(int(std::max(it->second - now_in_milliseconds(), int64_t(0)))).representation();
+}
+
+std::string Context::op_getAll(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_list_value(arguments[0]))
+        throw EXC_INVALID_ARGUMENT;
+    std::string names = arguments[0].substr(1, int(arguments[0].size()) - 2);
+    if (Grammar::is_spaces(names))
+        return "[]";
+    std::vector<std::string> variables = str_utils::split_list(names);
+    for (auto it = variables.begin(); it != variables.end(); it++) {
+        *it = str_utils::trim(*it);
+        if (!Grammar::is_variable(*it))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    std::string elements_str;
+    for (auto it = variables.begin(); it != variables.end(); it++) {
+        if (it != variables.begin())
+            elements_str += ",";
+        expire_if_due(*it);
+        std::shared_ptr<Instance> instance = _keyspace.find(*it);
+        elements_str += (instance) ? instance->representation() : "null";
+    }
+    return "[" + elements_str + "]";
+}
+
+std::string Context::op_keyspaceStats(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return "((\"size\"," + IntegerInstance(_keyspace.size()).representation() + ")," +
+           "(\"buckets\"," + IntegerInstance(_keyspace.buckets()).representation() + ")," +
+           "(\"loadFactor\"," + FloatInstance(_keyspace.load_factor()).representation() + ")," +
+           "(\"isRehashing\"," + (_keyspace.is_rehashing() ? "true" : "false") + ")," +
+           "(\"rehashProgress\"," + FloatInstance(_keyspace.rehash_progress()).representation() + "))";
+}
+
+std::string Context::op_memoryByNamespace(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    expire_variables();
+    std::vector<std::pair<std::string, int64_t>> memory_usage_by_namespace = _keyspace.memory_usage_by_namespace();
+    std::string elements_str;
+    for (auto it = memory_usage_by_namespace.begin(); it != memory_usage_by_namespace.end(); it++) {
+        if (it != memory_usage_by_namespace.begin())
+            elements_str += ",";
+        elements_str += "(" + it->first + "," + std::to_string(it->second) + ")";
+    }
+    return "(" + elements_str + ")";
+}
+
+std::string Context::op_biggestVariables(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int count = IntegerInstance(arguments[0]).value();
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    expire_variables();
+    std::vector<std::pair<std::string, int64_t>> biggest = _keyspace.biggest(count);
+    std::string elements_str;
+    for (auto it = biggest.begin(); it != biggest.end(); it++) {
+        if (it != biggest.begin())
+            elements_str += ",";
+        elements_str += "(" + it->first + "," + std::to_string(it->second) + ")";
+    }
+    return "(" + elements_str + ")";
+}
+
+std::string Context::op_poolStats(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<const Pool*> pools = Pool::pools();
+    std::string elements_str;
+    for (auto it = pools.begin(); it != pools.end(); it++) {
+        if (it != pools.begin())
+            elements_str += ",";
+        elements_str += "(\"" + (*it)->name() + "\"," +
+                        "((\"blockSize\"," + std::to_string((*it)->block_size()) + ")," +
+                        "(\"blocks\"," + std::to_string((*it)->blocks()) + ")," +
+                        "(\"usedBlocks\"," + std::to_string((*it)->used_blocks()) + ")))";
+    }
+    return "(" + elements_str + ")";
+}
+
+std::string Context::op_internStats(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return "((\"strings\"," + std::to_string(interning::size()) + ")," +
+           "(\"bytes\"," + std::to_string(interning::bytes()) + "))";
+}
+
 std::string Context::op_getFloatPrecision(const std::vector<std::string>& arguments) {
     return IntegerInstance(_float_precision).representation();
 }
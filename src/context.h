@@ -26,31 +26,69 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef KNUCKLEBALL_CONTEXT_H
 #define KNUCKLEBALL_CONTEXT_H
 
+#include <cstdint>
 #include <fstream>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "instance.h"
+#include "keyspace.h"
 #include "parser.h"
 #include "server.h"
+#include "timer_wheel.h"
 
 class Context {
 private:
     // Singleton instance:
     static Context *_instance;
 
+    // Number of keyspace buckets to be migrated on each execution, while a resize is in progress.
+    static const int REHASH_STEPS_PER_EXECUTION = 1;
+
+    // Number of variables sampled to choose each variable to be evicted.
+    static const int EVICTION_SAMPLES = 5;
+
     // Attributes:
     std::ofstream _logfile;
     int _float_precision;
     float _float_comparison_tolerance;
     bool _is_quiet_mode;
-    std::map<std::string, std::shared_ptr<Instance>> _instances;
+    Keyspace _keyspace;
+    std::unordered_map<std::string, int64_t> _deadlines;
+    TimerWheel _timer_wheel;
+    size_t _max_memory;
+    std::string _eviction_policy;
+    std::string _eviction_namespace;
+    size_t _deadlines_cursor;
+    bool _is_interning_strings;
 
     // Constructor:
     Context(const std::string& logfile_name, int float_precision, float float_comparison_tolerance, bool is_quiet_mode);
 
+    // Milliseconds elapsed on a monotonic clock.
+    static int64_t now_in_milliseconds();
+
+    // Set the time at which the variable with the given name expires.
+    void set_deadline(const std::string& name, int64_t deadline);
+
+    // Delete the variable with the given name if its deadline has passed, and return whether it was deleted.
+    bool expire_if_due(const std::string& name);
+
+    // Names of up to EVICTION_SAMPLES variables with deadlines, from consecutive buckets of the deadlines table.
+    std::vector<std::string> sample_deadlines();
+
+    // Name of the variable to be evicted according to the eviction policy, or an empty string if there is none. The
+    // "ttl" policy falls back to "lru" when no variable that may be evicted has a deadline.
+    std::string eviction_candidate();
+
+    // Memory used by the variables, including the strings they share through the interning pool.
+    int64_t memory_usage() const;
+
+    // Evict variables while the memory used by the variables exceeds the limit.
+    void evict_if_needed();
+
     // Input processing methods:
     std::string execute_in_type(const Parser& parser);
     std::string execute_in_context(const Parser& parser);
@@ -62,6 +100,14 @@ private:
     std::string op_listVariablesOfNamespace(const std::vector<std::string>& arguments);
     std::string op_deleteVariable(const std::vector<std::string>& arguments);
     std::string op_deleteVariablesOfNamespace(const std::vector<std::string>& arguments);
+    std::string op_expireVariable_afterMilliseconds(const std::vector<std::string>& arguments);
+    std::string op_ttlOfVariable(const std::vector<std::string>& arguments);
+    std::string op_getAll(const std::vector<std::string>& arguments);
+    std::string op_keyspaceStats(const std::vector<std::string>& arguments);
+    std::string op_memoryByNamespace(const std::vector<std::string>& arguments);
+    std::string op_biggestVariables(const std::vector<std::string>& arguments);
+    std::string op_poolStats(const std::vector<std::string>& arguments);
+    std::string op_internStats(const std::vector<std::string>& arguments);
     std::string op_getFloatPrecision(const std::vector<std::string>& arguments);
     std::string op_setFloatPrecision(const std::vector<std::string>& arguments);
     std::string op_getFloatComparisonTolerance(const std::vector<std::string>& arguments);
@@ -87,6 +133,24 @@ public:
     float get_float_comparison_tolerance();
     void set_float_comparison_tolerance(float float_comparison_tolerance);
 
+    // Limit the memory used by the variables to max_memory bytes, or remove the limit if it is 0. Interned strings
+    // count towards the limit. The limit is checked after each statement that grows the memory used, and variables are evicted according to the policy, which is
+    // either "lru", "lfu" or "ttl", and only from the namespace, if it is not empty.
+    void set_max_memory(size_t max_memory, const std::string& eviction_policy, const std::string& eviction_namespace);
+
+    // Whether the strings stored in containers are interned, so that repeated values are stored once.
+    bool is_interning_strings();
+    void set_interning_strings(bool is_interning_strings);
+
+    // Instance of the variable with the given name, or throw an exception if it does not exist.
+    std::shared_ptr<Instance> get_variable(const std::string& name);
+
+    // Spend up to milliseconds migrating keyspace buckets, while a resize is in progress.
+    void rehash_keyspace(int milliseconds);
+
+    // Delete the variables whose deadlines have passed.
+    void expire_variables();
+
     // Execute the input string and return a string or throw an exception.
     std::string execute(const std::string& input, std::shared_ptr<Session> session=nullptr);
 };
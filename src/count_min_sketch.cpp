@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <climits>
+
+#include "count_min_sketch.h"
+#include "str_utils.h"
+
+// Definitions of the static constants:
+const int CountMinSketch::MAX_COUNTERS;
+const int CountMinSketch::MAX_K;
+
+CountMinSketch::CountMinSketch(int width, int depth, int k) : _width(width), _depth(depth), _k(k), _total(0),
+                                                              _counters(width * depth, 0), _top_characters(0) {
+}
+
+int CountMinSketch::index_of(uint64_t hash, int row) const {
+    // Double hashing: the row hashes are h1 + row * h2, reduced to [0, width) by a multiplication.
+    uint32_t row_hash = uint32_t(hash) + uint32_t(row) * (uint32_t(hash >> 32) | 1);
+    return row * _width + int((uint64_t(row_hash) * uint64_t(_width)) >> 32);
+}
+
+void CountMinSketch::track(const std::string& element, int estimate) {
+    if (_k == 0)
+        return;
+    auto it = _top.find(element);
+    if (it != _top.end()) {
+        _ranking.erase(std::make_pair(it->second, element));
+        it->second = estimate;
+        _ranking.insert(std::make_pair(estimate, element));
+        return;
+    }
+    if (int(_top.size()) == _k) {
+        auto least = _ranking.begin();
+        if (least->first >= estimate)
+            return;
+        _top_characters -= least->second.size();
+        _top.erase(least->second);
+        _ranking.erase(least);
+    }
+    _top_characters += element.size();
+    _top[element] = estimate;
+    _ranking.insert(std::make_pair(estimate, element));
+}
+
+int CountMinSketch::width() const {
+    return _width;
+}
+
+int CountMinSketch::depth() const {
+    return _depth;
+}
+
+int CountMinSketch::k() const {
+    return _k;
+}
+
+long long CountMinSketch::total() const {
+    return _total;
+}
+
+int CountMinSketch::increment(const std::string& element, int count) {
+    uint64_t hash = str_utils::hash(element);
+    int estimate = INT_MAX;
+    for (int row = 0; row < _depth; row++)
+        estimate = std::min(estimate, _counters[index_of(hash, row)]);
+    int new_estimate = int(std::min((long long) estimate + count, (long long) INT_MAX));
+    for (int row = 0; row < _depth; row++) {
+        int& counter = _counters[index_of(hash, row)];
+        counter = std::max(counter, new_estimate);
+    }
+    _total += count;
+    track(element, new_estimate);
+    return new_estimate;
+}
+
+int CountMinSketch::estimate(const std::string& element) const {
+    uint64_t hash = str_utils::hash(element);
+    int estimate = INT_MAX;
+    for (int row = 0; row < _depth; row++)
+        estimate = std::min(estimate, _counters[index_of(hash, row)]);
+    return estimate;
+}
+
+std::vector<std::pair<std::string, int>> CountMinSketch::top() const {
+    std::vector<std::pair<std::string, int>> top;
+    top.reserve(_ranking.size());
+    for (auto it = _ranking.rbegin(); it != _ranking.rend(); it++)
+        top.push_back(std::make_pair(it->second, it->first));
+    return top;
+}
+
+size_t CountMinSketch::memory_usage() const {
+    // Each heavy hitter is stored twice, in a hash table node and in a ranking tree node of about four pointers.
+    return _counters.capacity() * sizeof(int) + _top.bucket_count() * sizeof(void*) +
+           _top.size() * (sizeof(std::pair<std::string, int>) * 2 + sizeof(void*) * 5) + _top_characters * 2;
+}
+
+void CountMinSketch::clear() {
+    std::fill(_counters.begin(), _counters.end(), 0);
+    _top.clear();
+    _ranking.clear();
+    _top_characters = 0;
+    _total = 0;
+}
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_COUNT_MIN_SKETCH_H
+#define KNUCKLEBALL_COUNT_MIN_SKETCH_H
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Count-min sketch of element frequencies: depth rows of width counters, stored in a single contiguous array. Each
+// element increments one counter per row (only the ones below its new estimate, which is known as conservative
+// update) and its frequency is estimated as the minimum of those counters, which never underestimates it. Optionally,
+// the elements with the k highest estimates are tracked as well.
+class CountMinSketch {
+public:
+    // Maximum number of counters, which take 64 MiB, and of tracked heavy hitters.
+    static const int MAX_COUNTERS = 1 << 24;
+    static const int MAX_K = 1000;
+private:
+    // Attributes:
+    int _width, _depth, _k;
+    long long _total;
+    std::vector<int> _counters;
+    std::unordered_map<std::string, int> _top;
+    std::set<std::pair<int, std::string>> _ranking;
+    size_t _top_characters;
+
+    // Index in the counters array of the counter of element hash in row.
+    int index_of(uint64_t hash, int row) const;
+
+    // Update the tracked heavy hitters with the new estimate of element.
+    void track(const std::string& element, int estimate);
+public:
+    // Constructor:
+    CountMinSketch(int width = 1, int depth = 1, int k = 0);
+
+    // Number of counters per row, rows and tracked heavy hitters.
+    int width() const;
+    int depth() const;
+    int k() const;
+
+    // Sum of all the increments.
+    long long total() const;
+
+    // Add count to the frequency of element and return its new estimate.
+    int increment(const std::string& element, int count);
+
+    // Estimated frequency of element.
+    int estimate(const std::string& element) const;
+
+    // Tracked heavy hitters with their estimates, from the most to the least frequent.
+    std::vector<std::pair<std::string, int>> top() const;
+
+    // Number of bytes of the counters and of the tracked heavy hitters.
+    size_t memory_usage() const;
+
+    // Reset all the frequencies to zero.
+    void clear();
+};
+
+#endif
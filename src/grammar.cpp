@@ -39,7 +39,17 @@ std::set<std::string> Grammar::RESERVED_WORDS {
     "String",
     "Vector",
     "Set",
-    "Dictionary"
+    "SortedSet",
+    "Multiset",
+    "Dictionary",
+    "Multidictionary",
+    "PriorityQueue",
+    "Stream",
+    "Bitmap",
+    "TimeSeries",
+    "HyperLogLog",
+    "BloomFilter",
+    "CountMinSketch"
 };
 
 bool Grammar::is_spaces(const std::string& str) {
@@ -146,6 +156,18 @@ bool Grammar::is_set_type(const std::string& str) {
     return is_object_type(str_utils::trim(str.substr(4, int(str.size()) - 5)));
 }
 
+bool Grammar::is_sorted_set_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "SortedSet<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(10, int(str.size()) - 11)));
+}
+
+bool Grammar::is_multiset_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "Multiset<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(9, int(str.size()) - 10)));
+}
+
 bool Grammar::is_dictionary_type(const std::string& str) {
     if (!str_utils::starts_with(str, "Dictionary<") || !str_utils::ends_with(str, ">"))
         return false;
@@ -157,12 +179,68 @@ bool Grammar::is_dictionary_type(const std::string& str) {
     return false;
 }
 
+bool Grammar::is_multidictionary_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "Multidictionary<") || !str_utils::ends_with(str, ">"))
+        return false;
+    std::string types_of_multidictionary = str.substr(16, int(str.size()) - 17);
+    for (int i = 0; i < int(types_of_multidictionary.size()); i++)
+        if (types_of_multidictionary[i] == ',')
+            return is_object_type(str_utils::trim(types_of_multidictionary.substr(0, i))) &&
+                   is_object_type(str_utils::trim(types_of_multidictionary.substr(i + 1)));
+    return false;
+}
+
+bool Grammar::is_priority_queue_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "PriorityQueue<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(14, int(str.size()) - 15)));
+}
+
+bool Grammar::is_stream_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "Stream<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(7, int(str.size()) - 8)));
+}
+
 bool Grammar::is_container_type(const std::string& str) {
-    return is_vector_type(str) || is_set_type(str) || is_dictionary_type(str);
+    return is_vector_type(str) || is_set_type(str) || is_sorted_set_type(str) || is_multiset_type(str) ||
+           is_dictionary_type(str) || is_multidictionary_type(str) || is_priority_queue_type(str) ||
+           is_stream_type(str);
+}
+
+bool Grammar::is_bitmap_type(const std::string& str) {
+    return str == "Bitmap";
+}
+
+bool Grammar::is_time_series_type(const std::string& str) {
+    return str == "TimeSeries";
+}
+
+bool Grammar::is_hyperloglog_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "HyperLogLog<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(12, int(str.size()) - 13)));
+}
+
+bool Grammar::is_bloom_filter_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "BloomFilter<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(12, int(str.size()) - 13)));
+}
+
+bool Grammar::is_count_min_sketch_type(const std::string& str) {
+    if (!str_utils::starts_with(str, "CountMinSketch<") || !str_utils::ends_with(str, ">"))
+        return false;
+    return is_object_type(str_utils::trim(str.substr(15, int(str.size()) - 16)));
+}
+
+bool Grammar::is_probabilistic_type(const std::string& str) {
+    return is_hyperloglog_type(str) || is_bloom_filter_type(str) || is_count_min_sketch_type(str);
 }
 
 bool Grammar::is_type(const std::string& str) {
-    return is_object_type(str) || is_container_type(str);
+    return is_object_type(str) || is_container_type(str) || is_bitmap_type(str) || is_time_series_type(str) ||
+           is_probabilistic_type(str);
 }
 
 bool Grammar::is_connection(const std::string& str) {
@@ -199,6 +277,19 @@ bool Grammar::is_variable(const std::string& str) {
     return is_identifier(str);
 }
 
+bool Grammar::is_list_value(const std::string& str) {
+    if (!str_utils::starts_with(str, "[") || !str_utils::ends_with(str, "]"))
+        return false;
+    std::string elements = str.substr(1, int(str.size()) - 2);
+    if (is_spaces(elements))
+        return true;
+    std::vector<std::string> items = str_utils::split_list(elements);
+    for (int i = 0; i < int(items.size()); i++)
+        if (!is_object_value(str_utils::trim(items[i])) && !is_variable(str_utils::trim(items[i])))
+            return false;
+    return true;
+}
+
 bool Grammar::is_actor(const std::string& str) {
     return is_connection(str) || is_context(str) || is_type(str) || is_variable(str);
 }
@@ -214,7 +305,7 @@ bool Grammar::is_keyword_message_token(const std::string& str) {
 }
 
 bool Grammar::is_keyword_message_argument(const std::string& str) {
-    return is_object_value(str) || is_namespace(str) || is_variable(str);
+    return is_object_value(str) || is_namespace(str) || is_variable(str) || is_list_value(str);
 }
 
 bool Grammar::is_keyword_message_part(const std::string& str) {
@@ -228,7 +319,16 @@ bool Grammar::is_keyword_message_part(const std::string& str) {
 bool Grammar::is_keyword_message(const std::string& str) {
     if (is_keyword_message_part(str))
         return true;
-    for (int i = 0; i < int(str.size()); i++)
+    // A list argument contains spaces, but the message can only be split after its closing bracket.
+    int i = 0;
+    while (i < int(str.size()) && str[i] != ':' && str[i] != '?')
+        i++;
+    i++;
+    while (i < int(str.size()) && str_utils::is_space(str[i]))
+        i++;
+    if (i < int(str.size()) && str[i] == '[')
+        i = str_utils::find_unquoted(str, ']', i);
+    for (; i < int(str.size()); i++)
         if (str_utils::is_space(str[i]) && is_keyword_message_part(str.substr(0, i)) &&
             is_keyword_message(str_utils::ltrim(str.substr(i + 1))))
             return true;
@@ -45,20 +45,34 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // <object-value> --> <boolean-value> | <character-value> | <integer-value> | <float-value> | <string-value>
 // <vector-type> --> Vector\<<spaces><object-type><spaces>\>
 // <set-type> --> Set\<<spaces><object-type><spaces>\>
+// <sorted-set-type> --> SortedSet\<<spaces><object-type><spaces>\>
+// <multiset-type> --> Multiset\<<spaces><object-type><spaces>\>
 // <dictionary-type> --> Dictionary\<<spaces><object-type><spaces>,<spaces><object-type><spaces>\>
-// <container-type> --> <vector-type> | <set-type> | <dictionary-type>
-// <type> --> <object-type> | <container-type>
+// <multidictionary-type> --> Multidictionary\<<spaces><object-type><spaces>,<spaces><object-type><spaces>\>
+// <priority-queue-type> --> PriorityQueue\<<spaces><object-type><spaces>\>
+// <stream-type> --> Stream\<<spaces><object-type><spaces>\>
+// <container-type> --> <vector-type> | <set-type> | <sorted-set-type> | <multiset-type> | <dictionary-type> |
+//                      <multidictionary-type> | <priority-queue-type> | <stream-type>
+// <bitmap-type> --> Bitmap
+// <time-series-type> --> TimeSeries
+// <hyperloglog-type> --> HyperLogLog\<<spaces><object-type><spaces>\>
+// <bloom-filter-type> --> BloomFilter\<<spaces><object-type><spaces>\>
+// <count-min-sketch-type> --> CountMinSketch\<<spaces><object-type><spaces>\>
+// <probabilistic-type> --> <hyperloglog-type> | <bloom-filter-type> | <count-min-sketch-type>
+// <type> --> <object-type> | <container-type> | <bitmap-type> | <time-series-type> | <probabilistic-type>
 // <connection> --> Connection
 // <context> --> Context
 // <reserved-word> --> null | true | false | Connection | Context | Boolean | Character | Integer | Float | String |
-//                     Vector | Set | Dictionary
+//                     Vector | Set | SortedSet | Multiset | Dictionary | Multidictionary | PriorityQueue | Stream |
+//                     Bitmap | TimeSeries | HyperLogLog | BloomFilter | CountMinSketch
 // <identifier> --> [a-zA-Z][a-zA-Z0-9_]* - <reserved_word>
 // <namespace> --> <identifier>
 // <variable> --> (<namespace>::)?<identifier>
+// <list-value> --> \[<spaces>((<object-value> | <variable>)(<spaces>,<spaces>(<object-value> | <variable>))*)?<spaces>\]
 // <actor> --> <connection> | <context> | <type> | <variable>
 // <unary-message> --> <identifier>\??
 // <keyword-message-token> --> <identifier>[:\?]{1}
-// <keyword-message-argument> --> <object-value> | <namespace> | <variable>
+// <keyword-message-argument> --> <object-value> | <namespace> | <variable> | <list-value>
 // <keyword-message-part> --> <keyword-message-token><spaces><keyword-message-argument>
 // <keyword-message> --> <keyword-message-part>(\s<spaces><keyword-message>)?
 // <statement> --> <spaces><actor>\s<spaces>(<unary-message> | <keyword-message>)<spaces>;<spaces>
@@ -118,12 +132,45 @@ bool is_vector_type(const std::string& str);
 // Grammar rule for <set-type>.
 bool is_set_type(const std::string& str);
 
+// Grammar rule for <sorted-set-type>.
+bool is_sorted_set_type(const std::string& str);
+
+// Grammar rule for <multiset-type>.
+bool is_multiset_type(const std::string& str);
+
 // Grammar rule for <dictionary-type>.
 bool is_dictionary_type(const std::string& str);
 
+// Grammar rule for <multidictionary-type>.
+bool is_multidictionary_type(const std::string& str);
+
+// Grammar rule for <priority-queue-type>.
+bool is_priority_queue_type(const std::string& str);
+
+// Grammar rule for <stream-type>.
+bool is_stream_type(const std::string& str);
+
 // Grammar rule for <container-type>.
 bool is_container_type(const std::string& str);
 
+// Grammar rule for <bitmap-type>.
+bool is_bitmap_type(const std::string& str);
+
+// Grammar rule for <time-series-type>.
+bool is_time_series_type(const std::string& str);
+
+// Grammar rule for <hyperloglog-type>.
+bool is_hyperloglog_type(const std::string& str);
+
+// Grammar rule for <bloom-filter-type>.
+bool is_bloom_filter_type(const std::string& str);
+
+// Grammar rule for <count-min-sketch-type>.
+bool is_count_min_sketch_type(const std::string& str);
+
+// Grammar rule for <probabilistic-type>.
+bool is_probabilistic_type(const std::string& str);
+
 // Grammar rule for <type>.
 bool is_type(const std::string& str);
 
@@ -145,6 +192,9 @@ bool is_namespace(const std::string& str);
 // Grammar rule for <variable>.
 bool is_variable(const std::string& str);
 
+// Grammar rule for <list-value>.
+bool is_list_value(const std::string& str);
+
 // Grammar rule for <actor>.
 bool is_actor(const std::string& str);
 
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "hyperloglog.h"
+
+// Definitions of the static constants:
+const int HyperLogLog::INDEX_BITS;
+const int HyperLogLog::REGISTERS;
+const int HyperLogLog::DENSE_BYTES;
+const int HyperLogLog::MAX_SPARSE_ENTRIES;
+
+HyperLogLog::HyperLogLog() {
+}
+
+int HyperLogLog::get_register(int index) const {
+    int bit = index * 6;
+    int word = _dense[bit >> 3] | (_dense[(bit >> 3) + 1] << 8);
+    return (word >> (bit & 7)) & 63;
+}
+
+void HyperLogLog::set_register(int index, int value) {
+    int bit = index * 6;
+    int word = _dense[bit >> 3] | (_dense[(bit >> 3) + 1] << 8);
+    word = (word & ~(63 << (bit & 7))) | (value << (bit & 7));
+    _dense[bit >> 3] = uint8_t(word);
+    _dense[(bit >> 3) + 1] = uint8_t(word >> 8);
+}
+
+bool HyperLogLog::update(int index, int rank) {
+    if (!is_sparse()) {
+        if (get_register(index) >= rank)
+            return false;
+        set_register(index, rank);
+        return true;
+    }
+    uint32_t entry = (uint32_t(index) << 8) | uint32_t(rank);
+    auto it = std::lower_bound(_sparse.begin(), _sparse.end(), uint32_t(index) << 8);
+    if (it != _sparse.end() && int(*it >> 8) == index) {
+        if (int(*it & 255) >= rank)
+            return false;
+        *it = entry;
+        return true;
+    }
+    _sparse.insert(it, entry);
+    if (int(_sparse.size()) > MAX_SPARSE_ENTRIES)
+        to_dense();
+    return true;
+}
+
+void HyperLogLog::to_dense() {
+    // One extra byte lets every register be read as two bytes.
+    _dense.assign(DENSE_BYTES + 1, 0);
+    for (auto it = _sparse.begin(); it != _sparse.end(); it++)
+        set_register(int(*it >> 8), int(*it & 255));
+    std::vector<uint32_t>().swap(_sparse);
+}
+
+bool HyperLogLog::empty() const {
+    if (is_sparse())
+        return _sparse.empty();
+    for (int i = 0; i < REGISTERS; i++)
+        if (get_register(i) != 0)
+            return false;
+    return true;
+}
+
+bool HyperLogLog::is_sparse() const {
+    return _dense.empty();
+}
+
+bool HyperLogLog::add(uint64_t hash) {
+    int index = int(hash >> (64 - INDEX_BITS));
+    // The guard bit bounds the rank by 64 - INDEX_BITS + 1 when the remaining bits are all zero.
+    uint64_t remaining_bits = (hash << INDEX_BITS) | (uint64_t(1) << (INDEX_BITS - 1));
+    return update(index, __builtin_clzll(remaining_bits) + 1);
+}
+
+int HyperLogLog::estimate() const {
+    double sum = 0;
+    int zeros = 0;
+    if (is_sparse()) {
+        zeros = REGISTERS - int(_sparse.size());
+        sum = zeros;
+        for (auto it = _sparse.begin(); it != _sparse.end(); it++)
+            sum += std::ldexp(1.0, -int(*it & 255));
+    }
+    else
+        for (int i = 0; i < REGISTERS; i++) {
+            int value = get_register(i);
+            if (value == 0)
+                zeros++;
+            sum += std::ldexp(1.0, -value);
+        }
+    double alpha = 0.7213 / (1 + 1.079 / REGISTERS);
+    double estimate = alpha * REGISTERS * REGISTERS / sum;
+    // Linear counting is more accurate while many registers are still zero.
+    if (estimate <= 2.5 * REGISTERS && zeros > 0)
+        estimate = REGISTERS * std::log(double(REGISTERS) / zeros);
+    return int(std::llround(estimate));
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (&other == this)
+        return;
+    if (is_sparse() && other.is_sparse()) {
+        for (auto it = other._sparse.begin(); it != other._sparse.end() && is_sparse(); it++)
+            update(int(*it >> 8), int(*it & 255));
+        if (is_sparse())
+            return;
+    }
+    if (is_sparse())
+        to_dense();
+    if (other.is_sparse())
+        for (auto it = other._sparse.begin(); it != other._sparse.end(); it++)
+            update(int(*it >> 8), int(*it & 255));
+    else
+        for (int i = 0; i < REGISTERS; i++)
+            update(i, other.get_register(i));
+}
+
+size_t HyperLogLog::memory_usage() const {
+    return _sparse.capacity() * sizeof(uint32_t) + _dense.capacity();
+}
+
+void HyperLogLog::clear() {
+    std::vector<uint32_t>().swap(_sparse);
+    std::vector<uint8_t>().swap(_dense);
+}
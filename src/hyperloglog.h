@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_HYPERLOGLOG_H
+#define KNUCKLEBALL_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <vector>
+
+// HyperLogLog estimator of the number of distinct hashes added to it, with 2^14 registers and a standard error of
+// about 0.81%. Small estimators store their non-zero registers as a sorted vector of (index, rank) entries, and are
+// converted to a dense array of 6-bit registers (12 KB) once that vector would take as much memory.
+class HyperLogLog {
+private:
+    // Number of index bits, registers, bytes of the dense array and maximum number of sparse entries:
+    static const int INDEX_BITS = 14;
+    static const int REGISTERS = 1 << INDEX_BITS;
+    static const int DENSE_BYTES = REGISTERS * 6 / 8;
+    static const int MAX_SPARSE_ENTRIES = DENSE_BYTES / 4;
+
+    // Attributes:
+    std::vector<uint32_t> _sparse;
+    std::vector<uint8_t> _dense;
+
+    // Value of the register at index of the dense array.
+    int get_register(int index) const;
+
+    // Store value in the register at index of the dense array.
+    void set_register(int index, int value);
+
+    // Raise the register at index to rank and return true, or return false if it is already at least rank.
+    bool update(int index, int rank);
+
+    // Move the sparse entries to the dense array.
+    void to_dense();
+public:
+    // Constructor:
+    HyperLogLog();
+
+    // Check whether no hash was added.
+    bool empty() const;
+
+    // Check whether the registers are stored as sparse entries.
+    bool is_sparse() const;
+
+    // Add hash and return true, or return false if no register changed.
+    bool add(uint64_t hash);
+
+    // Estimated number of distinct hashes added.
+    int estimate() const;
+
+    // Add all the hashes added to other.
+    void merge(const HyperLogLog& other);
+
+    // Number of bytes of the registers.
+    size_t memory_usage() const;
+
+    // Forget all the hashes added.
+    void clear();
+};
+
+#endif
@@ -24,10 +24,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -35,6 +39,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "exceptions.h"
 #include "grammar.h"
 #include "instance.h"
+#include "interning.h"
+#include "pool.h"
 #include "str_utils.h"
 
 /////////////////////////////////////////////////////// Auxiliar ///////////////////////////////////////////////////////
@@ -42,18 +48,36 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 std::shared_ptr<Instance> get_shared_instance(const std::string& type, const std::string& value) {
     std::shared_ptr<Instance> instance;
     if (type == "Boolean")
-        instance = std::make_shared<BooleanInstance>(value);
+        instance = std::allocate_shared<BooleanInstance>(PoolAllocator<BooleanInstance>("Boolean"), value);
     if (type == "Character")
-        instance = std::make_shared<CharacterInstance>(value);
+        instance = std::allocate_shared<CharacterInstance>(PoolAllocator<CharacterInstance>("Character"), value);
     if (type == "Integer")
-        instance = std::make_shared<IntegerInstance>(value);
+        instance = std::allocate_shared<IntegerInstance>(PoolAllocator<IntegerInstance>("Integer"), value);
     if (type == "Float")
-        instance = std::make_shared<FloatInstance>(value);
-    if (type == "String")
-        instance = std::make_shared<StringInstance>(value);
+        instance = std::allocate_shared<FloatInstance>(PoolAllocator<FloatInstance>("Float"), value);
+    if (type == "String") {
+        std::shared_ptr<StringInstance> string_instance =
+            std::allocate_shared<StringInstance>(PoolAllocator<StringInstance>("String"), value);
+        if (Context::get_instance()->is_interning_strings())
+            string_instance->intern();
+        instance = string_instance;
+    }
     return instance;
 }
 
+std::vector<std::shared_ptr<Instance>> get_shared_instances(const std::string& type, const std::string& list) {
+    if (!Grammar::is_list_value(list))
+        throw EXC_INVALID_ARGUMENT;
+    std::vector<std::shared_ptr<Instance>> instances;
+    if (Grammar::is_spaces(list.substr(1, int(list.size()) - 2)))
+        return instances;
+    std::vector<std::string> elements = str_utils::split_list(list.substr(1, int(list.size()) - 2));
+    instances.reserve(elements.size());
+    for (auto it = elements.begin(); it != elements.end(); it++)
+        instances.push_back(get_shared_instance(type, str_utils::trim(*it)));
+    return instances;
+}
+
 std::string vector_representation(const std::vector<std::shared_ptr<Instance>>& vector) {
     std::string elements_str;
     for (auto it = vector.begin(); it != vector.end(); it++) {
@@ -64,20 +88,117 @@ std::string vector_representation(const std::vector<std::shared_ptr<Instance>>&
     return "[" + elements_str + "]";
 }
 
+std::string set_representation(const std::vector<std::shared_ptr<Instance>>& vector) {
+    std::string elements_str;
+    for (auto it = vector.begin(); it != vector.end(); it++) {
+        if (it != vector.begin())
+            elements_str += ",";
+        elements_str += (*it)->representation();
+    }
+    return "{" + elements_str + "}";
+}
+
+std::string joined_representations(const std::vector<std::string>& representations, int from, int step) {
+    std::string elements_str;
+    for (int i = from; i < int(representations.size()); i += step) {
+        if (i > from)
+            elements_str += ",";
+        elements_str += representations[i];
+    }
+    return elements_str;
+}
+
+std::string intset_representation(const std::vector<int>& values) {
+    std::string elements_str;
+    for (auto it = values.begin(); it != values.end(); it++) {
+        if (it != values.begin())
+            elements_str += ",";
+        elements_str += IntegerInstance(*it).representation();
+    }
+    return "{" + elements_str + "}";
+}
+
+size_t string_memory_usage(const std::string& str) {
+    // Strings whose capacity is smaller than the string object are assumed to be stored inline.
+    return (str.capacity() < sizeof(std::string)) ? 0 : str.capacity() + 1;
+}
+
+size_t element_memory_usage(const std::shared_ptr<Instance>& element) {
+    // The control block shared by the pointers to the element takes about as many bytes as a shared pointer.
+    return sizeof(std::shared_ptr<Instance>) + element->memory_usage();
+}
+
+size_t tree_node_memory_usage() {
+    // Nodes of std::set and std::map hold a color and three pointers besides their value.
+    return 4 * sizeof(void*);
+}
+
+std::string cursor_representation(const std::shared_ptr<Instance>& instance) {
+    if (instance->type_tag() == Instance::FLOAT)
+        return std::static_pointer_cast<FloatInstance>(instance)->exact_representation();
+    return instance->representation();
+}
+
+std::string hash_key_of(const Instance& instance) {
+    // Sketches hash the value itself, which unlike the representation does not depend on the float precision.
+    Instance::Type type = instance.type_tag();
+    std::string key(1, char(type));
+    if (type == Instance::BOOLEAN)
+        key += char(static_cast<const BooleanInstance&>(instance).value());
+    else if (type == Instance::CHARACTER)
+        key += static_cast<const CharacterInstance&>(instance).value();
+    else if (type == Instance::INTEGER) {
+        int value = static_cast<const IntegerInstance&>(instance).value();
+        key.append(reinterpret_cast<const char*>(&value), sizeof(int));
+    }
+    else if (type == Instance::FLOAT) {
+        float value = static_cast<const FloatInstance&>(instance).value();
+        if (value == 0.0f)
+            value = 0.0f;
+        key.append(reinterpret_cast<const char*>(&value), sizeof(float));
+    }
+    else
+        key += static_cast<const StringInstance&>(instance).value();
+    return key;
+}
+
+std::string hash_key_representation(const std::string& key) {
+    Instance::Type type = Instance::Type(key[0]);
+    if (type == Instance::BOOLEAN)
+        return BooleanInstance((key[1]) ? "true" : "false").representation();
+    if (type == Instance::CHARACTER)
+        return "'" + key.substr(1, 1) + "'";
+    if (type == Instance::INTEGER) {
+        int value;
+        std::memcpy(&value, key.data() + 1, sizeof(int));
+        return IntegerInstance(value).representation();
+    }
+    if (type == Instance::FLOAT) {
+        float value;
+        std::memcpy(&value, key.data() + 1, sizeof(float));
+        return FloatInstance(value).representation();
+    }
+    return "\"" + str_utils::escape(key.substr(1), '"') + "\"";
+}
+
 /////////////////////////////////////////////////////// Instance ///////////////////////////////////////////////////////
 
-Instance::Instance(const std::string& type) : _type(type) {
+Instance::Instance(Type type) : _type(type) {
 }
 
 Instance::~Instance() {
 }
 
-std::string Instance::type() const {
+Instance::Type Instance::type_tag() const {
     return _type;
 }
 
-std::string Instance::name() const {
-    return _name;
+std::string Instance::type() const {
+    static const char* const TYPE_NAMES[] = {"Boolean", "Character", "Integer", "Float", "String", "Vector", "Set",
+                                             "SortedSet", "Multiset", "Dictionary", "Multidictionary",
+                                             "PriorityQueue", "Stream", "Bitmap", "TimeSeries", "HyperLogLog",
+                                             "BloomFilter", "CountMinSketch"};
+    return TYPE_NAMES[_type];
 }
 
 ///////////////////////////////////////////// InstanceIsEqualToComparator //////////////////////////////////////////////
@@ -91,26 +212,29 @@ bool InstanceIsEqualToComparator::operator() (const std::shared_ptr<Instance>& l
 
 bool InstanceIsLessThanComparator::operator()(const std::shared_ptr<Instance>& lhs,
                                               const std::shared_ptr<Instance>& rhs) const {
-    const std::string lhs_type = lhs->type();
-    const std::string rhs_type = rhs->type();
+    Instance::Type lhs_type = lhs->type_tag();
+    Instance::Type rhs_type = rhs->type_tag();
     float eps = Context::get_instance()->get_float_comparison_tolerance();
-    if (lhs_type == "Boolean" && rhs_type == "Boolean")
+    if (lhs_type == Instance::BOOLEAN && rhs_type == Instance::BOOLEAN)
         return static_cast<const BooleanInstance&>(*lhs).value() < static_cast<const BooleanInstance&>(*rhs).value();
-    if (lhs_type == "Character" && rhs_type == "Character")
+    if (lhs_type == Instance::CHARACTER && rhs_type == Instance::CHARACTER)
         return static_cast<const CharacterInstance&>(*lhs).value() <
                static_cast<const CharacterInstance&>(*rhs).value();
-    if (lhs_type == "Integer" && rhs_type == "Integer")
+    if (lhs_type == Instance::INTEGER && rhs_type == Instance::INTEGER)
         return static_cast<const IntegerInstance&>(*lhs).value() < static_cast<const IntegerInstance&>(*rhs).value();
-    if (lhs_type == "Integer" && rhs_type == "Float")
+    if (lhs_type == Instance::INTEGER && rhs_type == Instance::FLOAT)
         return float(static_cast<const IntegerInstance&>(*lhs).value()) -
                static_cast<const FloatInstance&>(*rhs).value() < -eps;
-    if (lhs_type == "Float" && rhs_type == "Float")
+    if (lhs_type == Instance::FLOAT && rhs_type == Instance::FLOAT)
         return static_cast<const FloatInstance&>(*lhs).value() - static_cast<const FloatInstance&>(*rhs).value() < -eps;
-    if (lhs_type == "Float" && rhs_type == "Integer")
+    if (lhs_type == Instance::FLOAT && rhs_type == Instance::INTEGER)
         return static_cast<const FloatInstance&>(*lhs).value() -
                float(static_cast<const IntegerInstance&>(*rhs).value()) < -eps;
-    if (lhs_type == "String" && rhs_type == "String")
-        return static_cast<const StringInstance&>(*lhs).value() < static_cast<const StringInstance&>(*rhs).value();
+    if (lhs_type == Instance::STRING && rhs_type == Instance::STRING) {
+        const StringInstance& lhs_string = static_cast<const StringInstance&>(*lhs);
+        const StringInstance& rhs_string = static_cast<const StringInstance&>(*rhs);
+        return !lhs_string.shares_value_with(rhs_string) && lhs_string.value() < rhs_string.value();
+    }
     throw EXC_INVALID_COMPARISON;
 }
 
@@ -125,26 +249,29 @@ bool InstanceIsLessThanOrEqualToComparator::operator()(const std::shared_ptr<Ins
 
 bool InstanceIsGreaterThanComparator::operator()(const std::shared_ptr<Instance>& lhs,
                                                  const std::shared_ptr<Instance>& rhs) const {
-    const std::string lhs_type = lhs->type();
-    const std::string rhs_type = rhs->type();
+    Instance::Type lhs_type = lhs->type_tag();
+    Instance::Type rhs_type = rhs->type_tag();
     float eps = Context::get_instance()->get_float_comparison_tolerance();
-    if (lhs_type == "Boolean" && rhs_type == "Boolean")
+    if (lhs_type == Instance::BOOLEAN && rhs_type == Instance::BOOLEAN)
         return static_cast<const BooleanInstance&>(*lhs).value() > static_cast<const BooleanInstance&>(*rhs).value();
-    if (lhs_type == "Character" && rhs_type == "Character")
+    if (lhs_type == Instance::CHARACTER && rhs_type == Instance::CHARACTER)
         return static_cast<const CharacterInstance&>(*lhs).value() >
                static_cast<const CharacterInstance&>(*rhs).value();
-    if (lhs_type == "Integer" && rhs_type == "Integer")
+    if (lhs_type == Instance::INTEGER && rhs_type == Instance::INTEGER)
         return static_cast<const IntegerInstance&>(*lhs).value() > static_cast<const IntegerInstance&>(*rhs).value();
-    if (lhs_type == "Integer" && rhs_type == "Float")
+    if (lhs_type == Instance::INTEGER && rhs_type == Instance::FLOAT)
         return float(static_cast<const IntegerInstance&>(*lhs).value()) -
                static_cast<const FloatInstance&>(*rhs).value() > eps;
-    if (lhs_type == "Float" && rhs_type == "Float")
+    if (lhs_type == Instance::FLOAT && rhs_type == Instance::FLOAT)
         return static_cast<const FloatInstance&>(*lhs).value() - static_cast<const FloatInstance&>(*rhs).value() > eps;
-    if (lhs_type == "Float" && rhs_type == "Integer")
+    if (lhs_type == Instance::FLOAT && rhs_type == Instance::INTEGER)
         return static_cast<const FloatInstance&>(*lhs).value() -
                float(static_cast<const IntegerInstance&>(*rhs).value()) > eps;
-    if (lhs_type == "String" && rhs_type == "String")
-        return static_cast<const StringInstance&>(*lhs).value() > static_cast<const StringInstance&>(*rhs).value();
+    if (lhs_type == Instance::STRING && rhs_type == Instance::STRING) {
+        const StringInstance& lhs_string = static_cast<const StringInstance&>(*lhs);
+        const StringInstance& rhs_string = static_cast<const StringInstance&>(*rhs);
+        return !lhs_string.shares_value_with(rhs_string) && lhs_string.value() > rhs_string.value();
+    }
     throw EXC_INVALID_COMPARISON;
 }
 
@@ -157,20 +284,19 @@ bool InstanceIsGreaterThanOrEqualToComparator::operator()(const std::shared_ptr<
 
 /////////////////////////////////////////////////// BooleanInstance ////////////////////////////////////////////////////
 
-BooleanInstance::BooleanInstance(const std::string& value) : Instance("Boolean") {
+BooleanInstance::BooleanInstance(const std::string& value) : Instance(BOOLEAN) {
     if (!Grammar::is_boolean_value(value))
         throw EXC_INVALID_ARGUMENT;
     _value = (value == "true");
 }
 
 BooleanInstance::BooleanInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
-    Instance("Boolean") {
+    Instance(BOOLEAN) {
     if (message_name == "create:withValue:" || message_name == "createIfNotExists:withValue:") {
         if (arguments.size() != 2)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]) || !Grammar::is_boolean_value(arguments[1]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
         _value = (arguments[1] == "true");
     }
     else
@@ -188,6 +314,10 @@ std::string BooleanInstance::representation() const {
     return (_value == true) ? "true" : "false";
 }
 
+size_t BooleanInstance::memory_usage() const {
+    return sizeof(BooleanInstance);
+}
+
 std::string BooleanInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
@@ -197,6 +327,10 @@ std::string BooleanInstance::receive(const std::string& message_name, const std:
         return op_isTrue(arguments);
     if (message_name == "isFalse?")
         return op_isFalse(arguments);
+    if (message_name == "getAndSet:")
+        return op_getAndSet(arguments);
+    if (message_name == "compareAndSet:to:")
+        return op_compareAndSet_to(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
@@ -227,22 +361,38 @@ std::string BooleanInstance::op_isFalse(const std::vector<std::string>& argument
     return (_value == false) ? "true" : "false";
 }
 
+std::string BooleanInstance::op_getAndSet(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_set(arguments);
+    return old_value;
+}
+
+std::string BooleanInstance::op_compareAndSet_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_boolean_value(arguments[0]) || !Grammar::is_boolean_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    if (_value != (arguments[0] == "true"))
+        return "false";
+    _value = (arguments[1] == "true");
+    return "true";
+}
+
 ////////////////////////////////////////////////// CharacterInstance ///////////////////////////////////////////////////
 
-CharacterInstance::CharacterInstance(const std::string& value) : Instance("Character") {
+CharacterInstance::CharacterInstance(const std::string& value) : Instance(CHARACTER) {
     if (!Grammar::is_character_value(value))
         throw EXC_INVALID_ARGUMENT;
     _value = value[1];
 }
 
 CharacterInstance::CharacterInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
-    Instance("Character") {
+    Instance(CHARACTER) {
     if (message_name == "create:withValue:" || message_name == "createIfNotExists:withValue:") {
         if (arguments.size() != 2)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]) || !Grammar::is_character_value(arguments[1]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
         _value = arguments[1][1];
     }
     else
@@ -260,6 +410,10 @@ std::string CharacterInstance::representation() const {
     return "'" + std::string(1, _value) + "'";
 }
 
+size_t CharacterInstance::memory_usage() const {
+    return sizeof(CharacterInstance);
+}
+
 std::string CharacterInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
@@ -283,6 +437,10 @@ std::string CharacterInstance::receive(const std::string& message_name, const st
         return op_isGreaterThan(arguments);
     if (message_name == "isGreaterThanOrEqualTo?")
         return op_isGreaterThanOrEqualTo(arguments);
+    if (message_name == "getAndSet:")
+        return op_getAndSet(arguments);
+    if (message_name == "compareAndSet:to:")
+        return op_compareAndSet_to(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
@@ -372,27 +530,43 @@ std::string CharacterInstance::op_isGreaterThanOrEqualTo(const std::vector<std::
            "true" : "false";
 }
 
+std::string CharacterInstance::op_getAndSet(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_set(arguments);
+    return old_value;
+}
+
+std::string CharacterInstance::op_compareAndSet_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_character_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    if (op_isEqualTo(std::vector<std::string>({arguments[0]})) == "false")
+        return "false";
+    _value = arguments[1][1];
+    return "true";
+}
+
 /////////////////////////////////////////////////// IntegerInstance ////////////////////////////////////////////////////
 
-IntegerInstance::IntegerInstance(int value) : Instance("Integer") {
+IntegerInstance::IntegerInstance(int value) : Instance(INTEGER) {
     _value = value;
 }
 
-IntegerInstance::IntegerInstance(const std::string& value) : Instance("Integer") {
+IntegerInstance::IntegerInstance(const std::string& value) : Instance(INTEGER) {
     if (!Grammar::is_integer_value(value) && !Grammar::is_float_value(value))
         throw EXC_INVALID_ARGUMENT;
     _value = (Grammar::is_integer_value(value)) ? atoi(value.c_str()) : atof(value.c_str());
 }
 
 IntegerInstance::IntegerInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
-    Instance("Integer") {
+    Instance(INTEGER) {
     if (message_name == "create:withValue:" || message_name == "createIfNotExists:withValue:") {
         if (arguments.size() != 2)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]) ||
            (!Grammar::is_integer_value(arguments[1]) && !Grammar::is_float_value(arguments[1])))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
         _value = (Grammar::is_integer_value(arguments[1])) ? atoi(arguments[1].c_str()) : atof(arguments[1].c_str());
     }
     else
@@ -410,6 +584,10 @@ std::string IntegerInstance::representation() const {
     return std::to_string(_value);
 }
 
+size_t IntegerInstance::memory_usage() const {
+    return sizeof(IntegerInstance);
+}
+
 std::string IntegerInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
@@ -433,6 +611,14 @@ std::string IntegerInstance::receive(const std::string& message_name, const std:
         return op_multiplyBy(arguments);
     if (message_name == "divideBy:")
         return op_divideBy(arguments);
+    if (message_name == "addAndGet:")
+        return op_addAndGet(arguments);
+    if (message_name == "getAndAdd:")
+        return op_getAndAdd(arguments);
+    if (message_name == "getAndSet:")
+        return op_getAndSet(arguments);
+    if (message_name == "compareAndSet:to:")
+        return op_compareAndSet_to(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
@@ -549,26 +735,53 @@ std::string IntegerInstance::op_divideBy(const std::vector<std::string>& argumen
     return "null";
 }
 
+std::string IntegerInstance::op_addAndGet(const std::vector<std::string>& arguments) {
+    op_add(arguments);
+    return representation();
+}
+
+std::string IntegerInstance::op_getAndAdd(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_add(arguments);
+    return old_value;
+}
+
+std::string IntegerInstance::op_getAndSet(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_set(arguments);
+    return old_value;
+}
+
+std::string IntegerInstance::op_compareAndSet_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_integer_value(arguments[1]) && !Grammar::is_float_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    if (op_isEqualTo(std::vector<std::string>({arguments[0]})) == "false")
+        return "false";
+    _value = (Grammar::is_integer_value(arguments[1])) ? atoi(arguments[1].c_str()) : atof(arguments[1].c_str());
+    return "true";
+}
+
 //////////////////////////////////////////////////// FloatInstance /////////////////////////////////////////////////////
 
-FloatInstance::FloatInstance(float value) : Instance("Float") {
+FloatInstance::FloatInstance(float value) : Instance(FLOAT) {
     _value = value;
 }
 
-FloatInstance::FloatInstance(const std::string& value) : Instance("Float") {
+FloatInstance::FloatInstance(const std::string& value) : Instance(FLOAT) {
     if (!Grammar::is_float_value(value))
         throw EXC_INVALID_ARGUMENT;
     _value = atof(value.c_str());
 }
 
 FloatInstance::FloatInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
-    Instance("Float") {
+    Instance(FLOAT) {
     if (message_name == "create:withValue:" || message_name == "createIfNotExists:withValue:") {
         if (arguments.size() != 2)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]) || !Grammar::is_float_value(arguments[1]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
         _value = atof(arguments[1].c_str());
     }
     else
@@ -582,12 +795,25 @@ float FloatInstance::value() const {
     return _value;
 }
 
+std::string FloatInstance::exact_representation() const {
+    if (std::isinf(_value))
+        return (_value < 0) ? "-1e39" : "1e39";
+    std::ostringstream oss;
+    oss << std::setprecision(std::numeric_limits<float>::max_digits10) << _value;
+    std::string str = oss.str();
+    return (Grammar::is_integer_value(str)) ? str + ".0" : str;
+}
+
 std::string FloatInstance::representation() const {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(Context::get_instance()->get_float_precision()) << _value;
     return oss.str();
 }
 
+size_t FloatInstance::memory_usage() const {
+    return sizeof(FloatInstance);
+}
+
 std::string FloatInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
@@ -611,6 +837,14 @@ std::string FloatInstance::receive(const std::string& message_name, const std::v
         return op_multiplyBy(arguments);
     if (message_name == "divideBy:")
         return op_divideBy(arguments);
+    if (message_name == "addAndGet:")
+        return op_addAndGet(arguments);
+    if (message_name == "getAndAdd:")
+        return op_getAndAdd(arguments);
+    if (message_name == "getAndSet:")
+        return op_getAndSet(arguments);
+    if (message_name == "compareAndSet:to:")
+        return op_compareAndSet_to(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
@@ -710,22 +944,49 @@ std::string FloatInstance::op_divideBy(const std::vector<std::string>& arguments
     return "null";
 }
 
+std::string FloatInstance::op_addAndGet(const std::vector<std::string>& arguments) {
+    op_add(arguments);
+    return representation();
+}
+
+std::string FloatInstance::op_getAndAdd(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_add(arguments);
+    return old_value;
+}
+
+std::string FloatInstance::op_getAndSet(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_set(arguments);
+    return old_value;
+}
+
+std::string FloatInstance::op_compareAndSet_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_float_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    if (op_isEqualTo(std::vector<std::string>({arguments[0]})) == "false")
+        return "false";
+    _value = atof(arguments[1].c_str());
+    return "true";
+}
+
 //////////////////////////////////////////////////// StringInstance ////////////////////////////////////////////////////
 
-StringInstance::StringInstance(const std::string& value) : Instance("String") {
+StringInstance::StringInstance(const std::string& value) : Instance(STRING), _is_interned(false), _value() {
     if (!Grammar::is_string_value(value))
         throw EXC_INVALID_ARGUMENT;
     _value = str_utils::unescape(value.substr(1, int(value.size()) - 2), '"');
 }
 
 StringInstance::StringInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
-    Instance("String") {
+    Instance(STRING), _is_interned(false), _value() {
     if (message_name == "create:" || message_name == "createIfNotExists:") {
         if (arguments.size() != 1)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
         _value = "";
     }
     else if (message_name == "create:withValue:" || message_name == "createIfNotExists:withValue:") {
@@ -733,7 +994,6 @@ StringInstance::StringInstance(const std::string& message_name, const std::vecto
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]) || !Grammar::is_string_value(arguments[1]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
         _value = str_utils::unescape(arguments[1].substr(1, int(arguments[1].size()) - 2), '"');
     }
     else
@@ -741,14 +1001,36 @@ StringInstance::StringInstance(const std::string& message_name, const std::vecto
 }
 
 StringInstance::~StringInstance() {
+    if (_is_interned)
+        interning::release(_interned);
+    else
+        _value.~basic_string();
 }
 
 std::string StringInstance::value() const {
-    return _value;
+    return (_is_interned) ? *_interned : _value;
+}
+
+void StringInstance::intern() {
+    if (_is_interned)
+        return;
+    const std::string* interned = interning::intern(_value);
+    _value.~basic_string();
+    _interned = interned;
+    _is_interned = true;
+}
+
+bool StringInstance::shares_value_with(const StringInstance& other) const {
+    return _is_interned && other._is_interned && _interned == other._interned;
 }
 
 std::string StringInstance::representation() const {
-    return "\"" + str_utils::escape(_value, '"') + "\"";
+    return "\"" + str_utils::escape((_is_interned) ? *_interned : _value, '"') + "\"";
+}
+
+size_t StringInstance::memory_usage() const {
+    // The pooled value of an interned string is shared by all of its copies, and is not counted by any of them.
+    return sizeof(StringInstance) + ((_is_interned) ? 0 : string_memory_usage(_value));
 }
 
 std::string StringInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
@@ -804,6 +1086,10 @@ std::string StringInstance::receive(const std::string& message_name, const std::
         return op_eraseFromIndex_toIndex(arguments);
     if (message_name == "clear")
         return op_clear(arguments);
+    if (message_name == "getAndSet:")
+        return op_getAndSet(arguments);
+    if (message_name == "compareAndSet:to:")
+        return op_compareAndSet_to(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
@@ -1050,17 +1336,35 @@ std::string StringInstance::op_clear(const std::vector<std::string>& arguments)
     return "null";
 }
 
+std::string StringInstance::op_getAndSet(const std::vector<std::string>& arguments) {
+    std::string old_value = representation();
+    op_set(arguments);
+    return old_value;
+}
+
+std::string StringInstance::op_compareAndSet_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_string_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    if (op_isLexicographicallyEqualTo(std::vector<std::string>({arguments[0]})) == "false")
+        return "false";
+    _value = str_utils::unescape(arguments[1].substr(1, int(arguments[1].size()) - 2), '"');
+    return "true";
+}
+
 //////////////////////////////////////////////////// VectorInstance ////////////////////////////////////////////////////
 
 VectorInstance::VectorInstance(const std::string& element_type, const std::string& message_name,
-                               const std::vector<std::string>& arguments) : Instance("Vector") {
+                               const std::vector<std::string>& arguments) :
+    Instance(VECTOR), _elements_memory_usage(0) {
     _element_type = element_type;
+    _is_packed = true;
     if (message_name == "create:" || message_name == "createIfNotExists:") {
         if (arguments.size() != 1)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
     }
     else
         throw EXC_INVALID_MESSAGE;
@@ -1070,10 +1374,108 @@ VectorInstance::~VectorInstance() {
 }
 
 std::string VectorInstance::representation() const {
+    if (_is_packed)
+        return "[" + joined_representations(_packed.representations(), 0, 1) + "]";
     return vector_representation(_value);
 }
 
+size_t VectorInstance::memory_usage() const {
+    return sizeof(VectorInstance) + string_memory_usage(_element_type) + _packed.bytes() +
+           _value.capacity() * sizeof(std::shared_ptr<Instance>) + _elements_memory_usage;
+}
+
 std::string VectorInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (!_is_packed)
+        return dispatch(message_name, arguments);
+    std::string output;
+    if (dispatch_packed(message_name, arguments, output))
+        return output;
+    unpack();
+    try {
+        output = dispatch(message_name, arguments);
+    }
+    catch (...) {
+        pack_if_small();
+        throw;
+    }
+    pack_if_small();
+    return output;
+}
+
+void VectorInstance::unpack() {
+    _value = _packed.instances();
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
+    _packed.clear();
+    _is_packed = false;
+}
+
+void VectorInstance::pack_if_small() {
+    if (int(_value.size()) > Listpack::MAX_SIZE)
+        return;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        if (!Listpack::is_packable(**it))
+            return;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _packed.push_back(**it);
+    std::vector<std::shared_ptr<Instance>>().swap(_value);
+    _elements_memory_usage = 0;
+    _is_packed = true;
+}
+
+bool VectorInstance::dispatch_packed(const std::string& message_name, const std::vector<std::string>& arguments,
+                                     std::string& output) {
+    if (message_name == "get" || message_name == "isEmpty?" || message_name == "size") {
+        if (arguments.size() != 0)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (message_name == "get")
+            output = representation();
+        else if (message_name == "isEmpty?")
+            output = (_packed.size() == 0) ? "true" : "false";
+        else
+            output = IntegerInstance(_packed.size()).representation();
+        return true;
+    }
+    if (message_name == "contains?" || message_name == "count:" || message_name == "firstIndexOf:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+        int index = _packed.index_of(*instance, 0, 1);
+        if (message_name == "contains?")
+            output = (index >= 0) ? "true" : "false";
+        else if (message_name == "firstIndexOf:")
+            output = IntegerInstance(index).representation();
+        else {
+            int count = 0;
+            for (; index >= 0; index = _packed.index_of(*instance, index + 1, 1))
+                count++;
+            output = IntegerInstance(count).representation();
+        }
+        return true;
+    }
+    if (message_name == "atIndex:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        int index = IntegerInstance(arguments[0]).value();
+        if (index < 0 || index >= _packed.size())
+            throw EXC_INVALID_ARGUMENT;
+        output = _packed.representation_at(index);
+        return true;
+    }
+    if (message_name == "pushBack:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+        if (!Listpack::is_packable(*instance) || _packed.size() >= Listpack::MAX_SIZE)
+            return false;
+        _packed.push_back(*instance);
+        output = "null";
+        return true;
+    }
+    return false;
+}
+
+std::string VectorInstance::dispatch(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
     if (message_name == "isEmpty?")
@@ -1102,8 +1504,12 @@ std::string VectorInstance::receive(const std::string& message_name, const std::
         return op_sliceFromIndex(arguments);
     if (message_name == "sliceFromIndex:toIndex:")
         return op_sliceFromIndex_toIndex(arguments);
+    if (message_name == "getFrom:count:")
+        return op_getFrom_count(arguments);
     if (message_name == "pushBack:")
         return op_pushBack(arguments);
+    if (message_name == "pushBackAll:")
+        return op_pushBackAll(arguments);
     if (message_name == "pushFront:")
         return op_pushFront(arguments);
     if (message_name == "popBack")
@@ -1281,11 +1687,37 @@ std::string VectorInstance::op_sliceFromIndex_toIndex(const std::vector<std::str
                                                                         _value.begin() + to_index));
 }
 
+std::string VectorInstance::op_getFrom_count(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int index = IntegerInstance(arguments[0]).value();
+    int count = IntegerInstance(arguments[1]).value();
+    if (index < 0 || index > int(_value.size()))
+        throw EXC_INVALID_ARGUMENT;
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    count = std::min(count, int(_value.size()) - index);
+    return vector_representation(std::vector<std::shared_ptr<Instance>>(_value.begin() + index,
+                                                                        _value.begin() + index + count));
+}
+
 std::string VectorInstance::op_pushBack(const std::vector<std::string>& arguments) {
     if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
     _value.push_back(instance);
+    _elements_memory_usage += element_memory_usage(instance);
+    return "null";
+}
+
+std::string VectorInstance::op_pushBackAll(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> instances = get_shared_instances(_element_type, arguments[0]);
+    _value.reserve(_value.size() + instances.size());
+    _value.insert(_value.end(), instances.begin(), instances.end());
+    for (auto it = instances.begin(); it != instances.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
     return "null";
 }
 
@@ -1294,6 +1726,7 @@ std::string VectorInstance::op_pushFront(const std::vector<std::string>& argumen
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
     _value.insert(_value.begin(), instance);
+    _elements_memory_usage += element_memory_usage(instance);
     return "null";
 }
 
@@ -1304,6 +1737,7 @@ std::string VectorInstance::op_popBack(const std::vector<std::string>& arguments
         return "null";
     std::shared_ptr<Instance> instance = _value[int(_value.size()) - 1];
     _value.pop_back();
+    _elements_memory_usage -= element_memory_usage(instance);
     return instance->representation();
 }
 
@@ -1314,6 +1748,7 @@ std::string VectorInstance::op_popFront(const std::vector<std::string>& argument
         return "null";
     std::shared_ptr<Instance> instance = _value[0];
     _value.erase(_value.begin());
+    _elements_memory_usage -= element_memory_usage(instance);
     return instance->representation();
 }
 
@@ -1325,6 +1760,7 @@ std::string VectorInstance::op_popAtIndex(const std::vector<std::string>& argume
         throw EXC_INVALID_ARGUMENT;
     std::shared_ptr<Instance> instance = _value[index];
     _value.erase(_value.begin() + index);
+    _elements_memory_usage -= element_memory_usage(instance);
     return instance->representation();
 }
 
@@ -1336,6 +1772,7 @@ std::string VectorInstance::op_insert_beforeIndex(const std::vector<std::string>
     if (index < 0 || index > int(_value.size()))
         throw EXC_INVALID_ARGUMENT;
     _value.insert(_value.begin() + index, instance);
+    _elements_memory_usage += element_memory_usage(instance);
     return "null";
 }
 
@@ -1345,6 +1782,8 @@ std::string VectorInstance::op_eraseFromIndex(const std::vector<std::string>& ar
     int from_index = IntegerInstance(arguments[0]).value();
     if (from_index < 0 || from_index > int(_value.size()))
         throw EXC_INVALID_ARGUMENT;
+    for (auto it = _value.begin() + from_index; it != _value.end(); it++)
+        _elements_memory_usage -= element_memory_usage(*it);
     _value.erase(_value.begin() + from_index, _value.end());
     return "null";
 }
@@ -1360,6 +1799,8 @@ std::string VectorInstance::op_eraseFromIndex_toIndex(const std::vector<std::str
         throw EXC_INVALID_ARGUMENT;
     if (to_index - from_index < 0)
         throw EXC_INVALID_ARGUMENT;
+    for (auto it = _value.begin() + from_index; it != _value.begin() + to_index; it++)
+        _elements_memory_usage -= element_memory_usage(*it);
     _value.erase(_value.begin() + from_index, _value.begin() + to_index);
     return "null";
 }
@@ -1370,6 +1811,7 @@ std::string VectorInstance::op_removeFirst(const std::vector<std::string>& argum
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
     for (auto it = _value.begin(); it != _value.end(); it++)
         if (InstanceIsEqualToComparator()(*it, instance)) {
+            _elements_memory_usage -= element_memory_usage(*it);
             _value.erase(it);
             break;
         }
@@ -1385,6 +1827,7 @@ std::string VectorInstance::op_removeFirst_fromIndex(const std::vector<std::stri
         throw EXC_INVALID_ARGUMENT;
     for (auto it = _value.begin() + from_index; it != _value.end(); it++)
         if (InstanceIsEqualToComparator()(*it, instance)) {
+            _elements_memory_usage -= element_memory_usage(*it);
             _value.erase(it);
             break;
         }
@@ -1397,6 +1840,7 @@ std::string VectorInstance::op_removeAll(const std::vector<std::string>& argumen
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
     for (int i = 0; i < int(_value.size()); i++)
         if (InstanceIsEqualToComparator()(_value[i], instance)) {
+            _elements_memory_usage -= element_memory_usage(_value[i]);
             _value.erase(_value.begin() + i);
             i--;
         }
@@ -1410,7 +1854,9 @@ std::string VectorInstance::op_replaceFirst_with(const std::vector<std::string>&
     std::shared_ptr<Instance> temporary = get_shared_instance(_element_type, arguments[1]);
     for (int i = 0; i < int(_value.size()); i++)
         if (InstanceIsEqualToComparator()(_value[i], instance)) {
+            _elements_memory_usage -= element_memory_usage(_value[i]);
             _value[i] = get_shared_instance(_element_type, arguments[1]);
+            _elements_memory_usage += element_memory_usage(_value[i]);
             break;
         }
     return "null";
@@ -1426,7 +1872,9 @@ std::string VectorInstance::op_replaceFirst_fromIndex_with(const std::vector<std
         throw EXC_INVALID_ARGUMENT;
     for (int i = from_index; i < int(_value.size()); i++)
         if (InstanceIsEqualToComparator()(_value[i], instance)) {
+            _elements_memory_usage -= element_memory_usage(_value[i]);
             _value[i] = get_shared_instance(_element_type, arguments[2]);
+            _elements_memory_usage += element_memory_usage(_value[i]);
             break;
         }
     return "null";
@@ -1438,8 +1886,11 @@ std::string VectorInstance::op_replaceAll_with(const std::vector<std::string>& a
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
     std::shared_ptr<Instance> temporary = get_shared_instance(_element_type, arguments[1]);
     for (int i = 0; i < int(_value.size()); i++)
-        if (InstanceIsEqualToComparator()(_value[i], instance))
+        if (InstanceIsEqualToComparator()(_value[i], instance)) {
+            _elements_memory_usage -= element_memory_usage(_value[i]);
             _value[i] = get_shared_instance(_element_type, arguments[1]);
+            _elements_memory_usage += element_memory_usage(_value[i]);
+        }
     return "null";
 }
 
@@ -1461,20 +1912,23 @@ std::string VectorInstance::op_clear(const std::vector<std::string>& arguments)
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     _value.clear();
+    _elements_memory_usage = 0;
     return "null";
 }
 
 ////////////////////////////////////////////////////// SetInstance /////////////////////////////////////////////////////
 
 SetInstance::SetInstance(const std::string& element_type, const std::string& message_name,
-                         const std::vector<std::string>& arguments) : Instance("Set") {
+                         const std::vector<std::string>& arguments) :
+    Instance(SET), _elements_memory_usage(0) {
     _element_type = element_type;
+    _is_intset = element_type == "Integer";
+    _is_packed = !_is_intset;
     if (message_name == "create:" || message_name == "createIfNotExists:") {
         if (arguments.size() != 1)
             throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
         if (!Grammar::is_variable(arguments[0]))
             throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
     }
     else
         throw EXC_INVALID_MESSAGE;
@@ -1484,6 +1938,10 @@ SetInstance::~SetInstance() {
 }
 
 std::string SetInstance::representation() const {
+    if (_is_intset)
+        return intset_representation(_integers.values());
+    if (_is_packed)
+        return "{" + joined_representations(_packed.representations(), 0, 1) + "}";
     std::string elements_str;
     for (auto it = _value.begin(); it != _value.end(); it++) {
         if (it != _value.begin())
@@ -1493,7 +1951,209 @@ std::string SetInstance::representation() const {
     return "{" + elements_str + "}";
 }
 
+size_t SetInstance::memory_usage() const {
+    return sizeof(SetInstance) + string_memory_usage(_element_type) + _packed.bytes() + _integers.memory_usage() +
+           _value.size() * (tree_node_memory_usage() + sizeof(std::shared_ptr<Instance>)) + _elements_memory_usage;
+}
+
 std::string SetInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (_is_intset)
+        return dispatch_intset(message_name, arguments);
+    if (!_is_packed)
+        return dispatch(message_name, arguments);
+    std::string output;
+    if (dispatch_packed(message_name, arguments, output))
+        return output;
+    unpack();
+    try {
+        output = dispatch(message_name, arguments);
+    }
+    catch (...) {
+        pack_if_small();
+        throw;
+    }
+    pack_if_small();
+    return output;
+}
+
+void SetInstance::unpack() {
+    std::vector<std::shared_ptr<Instance>> elements = _packed.instances();
+    _value.insert(elements.begin(), elements.end());
+    for (auto it = elements.begin(); it != elements.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
+    _packed.clear();
+    _is_packed = false;
+}
+
+void SetInstance::pack_if_small() {
+    if (int(_value.size()) > Listpack::MAX_SIZE)
+        return;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        if (!Listpack::is_packable(**it))
+            return;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _packed.push_back(**it);
+    _value.clear();
+    _elements_memory_usage = 0;
+    _is_packed = true;
+}
+
+bool SetInstance::dispatch_packed(const std::string& message_name, const std::vector<std::string>& arguments,
+                                  std::string& output) {
+    if (message_name == "get" || message_name == "isEmpty?" || message_name == "size") {
+        if (arguments.size() != 0)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (message_name == "get")
+            output = representation();
+        else if (message_name == "isEmpty?")
+            output = (_packed.size() == 0) ? "true" : "false";
+        else
+            output = IntegerInstance(_packed.size()).representation();
+        return true;
+    }
+    if (message_name == "contains?") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+        output = (_packed.index_of(*instance, 0, 1) >= 0) ? "true" : "false";
+        return true;
+    }
+    if (message_name == "add:" || message_name == "remove:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+        int index = _packed.lower_bound(*instance, 1);
+        bool is_present = index < _packed.size() && _packed.is_equal_at(index, *instance);
+        if (message_name == "remove:" && is_present)
+            _packed.erase(index);
+        else if (message_name == "add:" && !is_present) {
+            if (!Listpack::is_packable(*instance) || _packed.size() >= Listpack::MAX_SIZE)
+                return false;
+            _packed.insert(index, *instance);
+        }
+        output = "null";
+        return true;
+    }
+    return false;
+}
+
+std::string SetInstance::dispatch_intset(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "get" || message_name == "isEmpty?" || message_name == "size" || message_name == "clear") {
+        if (arguments.size() != 0)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (message_name == "get")
+            return representation();
+        if (message_name == "isEmpty?")
+            return (_integers.size() == 0) ? "true" : "false";
+        if (message_name == "size")
+            return IntegerInstance(_integers.size()).representation();
+        _integers.clear();
+        return "null";
+    }
+    if (message_name == "contains?" || message_name == "add:" || message_name == "remove:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        int value = IntegerInstance(arguments[0]).value();
+        if (message_name == "contains?")
+            return _integers.contains(value) ? "true" : "false";
+        if (message_name == "add:")
+            _integers.insert(value);
+        else
+            _integers.erase(value);
+    }
+    else if (message_name == "addAll:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::vector<std::shared_ptr<Instance>> instances = get_shared_instances(_element_type, arguments[0]);
+        std::vector<int> values;
+        values.reserve(instances.size());
+        for (auto it = instances.begin(); it != instances.end(); it++)
+            values.push_back(std::static_pointer_cast<IntegerInstance>(*it)->value());
+        _integers.insert(values);
+    }
+    else if (message_name == "scanFirst:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        return scan_intset(0, IntegerInstance(arguments[0]).value());
+    }
+    else if (message_name == "scanFrom:count:") {
+        if (arguments.size() != 2)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        return scan_intset(_integers.lower_bound(IntegerInstance(arguments[0]).value()),
+                           IntegerInstance(arguments[1]).value());
+    }
+    else if (message_name == "unionWith:" || message_name == "intersectWith:" || message_name == "differenceWith:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        Intset buffer;
+        const Intset& other = intset_of_variable(arguments[0], buffer);
+        Intset result = (message_name == "unionWith:") ? Intset::union_of(_integers, other) :
+                        (message_name == "intersectWith:") ? Intset::intersection_of(_integers, other) :
+                                                             Intset::difference_of(_integers, other);
+        return intset_representation(result.values());
+    }
+    else if (message_name == "storeUnionOf:and:" || message_name == "storeIntersectionOf:and:" ||
+             message_name == "storeDifferenceOf:and:") {
+        if (arguments.size() != 2)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        Intset first_buffer, second_buffer;
+        const Intset& first = intset_of_variable(arguments[0], first_buffer);
+        const Intset& second = intset_of_variable(arguments[1], second_buffer);
+        _integers = (message_name == "storeUnionOf:and:") ? Intset::union_of(first, second) :
+                    (message_name == "storeIntersectionOf:and:") ? Intset::intersection_of(first, second) :
+                                                                   Intset::difference_of(first, second);
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+    if (_integers.size() > Intset::MAX_SIZE)
+        upgrade_intset();
+    return "null";
+}
+
+void SetInstance::upgrade_intset() {
+    for (auto it = _integers.values().begin(); it != _integers.values().end(); it++)
+        _value.insert(_value.end(), std::allocate_shared<IntegerInstance>(PoolAllocator<IntegerInstance>("Integer"),
+                                                                          *it));
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
+    _integers.clear();
+    _is_intset = false;
+}
+
+const Intset& SetInstance::intset_of_variable(const std::string& variable, Intset& buffer) const {
+    if (!Grammar::is_variable(variable))
+        throw EXC_INVALID_ARGUMENT;
+    std::shared_ptr<SetInstance> instance =
+        std::dynamic_pointer_cast<SetInstance>(Context::get_instance()->get_variable(variable));
+    if (instance == nullptr || instance->_element_type != _element_type)
+        throw EXC_INVALID_ARGUMENT;
+    if (instance->_is_intset)
+        return instance->_integers;
+    std::vector<int> values;
+    if (instance->_is_packed) {
+        std::vector<std::shared_ptr<Instance>> elements = instance->_packed.instances();
+        for (auto it = elements.begin(); it != elements.end(); it++)
+            values.push_back(std::static_pointer_cast<IntegerInstance>(*it)->value());
+    }
+    else {
+        values.reserve(instance->_value.size());
+        for (auto it = instance->_value.begin(); it != instance->_value.end(); it++)
+            values.push_back(std::static_pointer_cast<IntegerInstance>(*it)->value());
+    }
+    buffer.insert(values);
+    return buffer;
+}
+
+std::string SetInstance::scan_intset(int index, int count) const {
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    const std::vector<int>& values = _integers.values();
+    int end = index + std::min(count, int(values.size()) - index);
+    return "(" + intset_representation(std::vector<int>(values.begin() + index, values.begin() + end)) + "," +
+           ((end < int(values.size())) ? IntegerInstance(values[end]).representation() : "null") + ")";
+}
+
+std::string SetInstance::dispatch(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
     if (message_name == "isEmpty?")
@@ -1502,12 +2162,30 @@ std::string SetInstance::receive(const std::string& message_name, const std::vec
         return op_contains(arguments);
     if (message_name == "size")
         return op_size(arguments);
+    if (message_name == "scanFirst:")
+        return op_scanFirst(arguments);
+    if (message_name == "scanFrom:count:")
+        return op_scanFrom_count(arguments);
     if (message_name == "add:")
         return op_add(arguments);
+    if (message_name == "addAll:")
+        return op_addAll(arguments);
     if (message_name == "remove:")
         return op_remove(arguments);
     if (message_name == "clear")
         return op_clear(arguments);
+    if (message_name == "unionWith:")
+        return op_unionWith(arguments);
+    if (message_name == "intersectWith:")
+        return op_intersectWith(arguments);
+    if (message_name == "differenceWith:")
+        return op_differenceWith(arguments);
+    if (message_name == "storeUnionOf:and:")
+        return op_storeUnionOf_and(arguments);
+    if (message_name == "storeIntersectionOf:and:")
+        return op_storeIntersectionOf_and(arguments);
+    if (message_name == "storeDifferenceOf:and:")
+        return op_storeDifferenceOf_and(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
@@ -1536,11 +2214,35 @@ std::string SetInstance::op_size(const std::vector<std::string>& arguments) {
     return IntegerInstance(int(_value.size())).representation();
 }
 
+std::string SetInstance::op_scanFirst(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return scan(_value.begin(), IntegerInstance(arguments[0]).value());
+}
+
+std::string SetInstance::op_scanFrom_count(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    return scan(_value.lower_bound(instance), IntegerInstance(arguments[1]).value());
+}
+
 std::string SetInstance::op_add(const std::vector<std::string>& arguments) {
     if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
-    _value.insert(instance);
+    if (_value.insert(instance).second)
+        _elements_memory_usage += element_memory_usage(instance);
+    return "null";
+}
+
+std::string SetInstance::op_addAll(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> instances = get_shared_instances(_element_type, arguments[0]);
+    for (auto it = instances.begin(); it != instances.end(); it++)
+        if (_value.insert(*it).second)
+            _elements_memory_usage += element_memory_usage(*it);
     return "null";
 }
 
@@ -1548,7 +2250,11 @@ std::string SetInstance::op_remove(const std::vector<std::string>& arguments) {
     if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
-    _value.erase(instance);
+    auto it = _value.find(instance);
+    if (it != _value.end()) {
+        _elements_memory_usage -= element_memory_usage(*it);
+        _value.erase(it);
+    }
     return "null";
 }
 
@@ -1556,135 +2262,1864 @@ std::string SetInstance::op_clear(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     _value.clear();
+    _elements_memory_usage = 0;
     return "null";
 }
 
-////////////////////////////////////////////////// DictionaryInstance //////////////////////////////////////////////////
+std::string SetInstance::op_unionWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> buffer;
+    auto result = union_of(_value, set_of_variable(arguments[0], buffer));
+    return set_representation(std::vector<std::shared_ptr<Instance>>(result.begin(), result.end()));
+}
 
-DictionaryInstance::DictionaryInstance(const std::string& key_type, const std::string& value_type,
-                                       const std::string& message_name, const std::vector<std::string>& arguments) :
-    Instance("Dictionary") {
-    _key_type = key_type;
-    _value_type = value_type;
-    if (message_name == "create:" || message_name == "createIfNotExists:") {
-        if (arguments.size() != 1)
-            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-        if (!Grammar::is_variable(arguments[0]))
-            throw EXC_INVALID_ARGUMENT;
-        _name = arguments[0];
-    }
-    else
-        throw EXC_INVALID_MESSAGE;
+std::string SetInstance::op_intersectWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> buffer;
+    auto result = intersection_of(_value, set_of_variable(arguments[0], buffer));
+    return set_representation(std::vector<std::shared_ptr<Instance>>(result.begin(), result.end()));
 }
 
-DictionaryInstance::~DictionaryInstance() {
+std::string SetInstance::op_differenceWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> buffer;
+    auto result = difference_of(_value, set_of_variable(arguments[0], buffer));
+    return set_representation(std::vector<std::shared_ptr<Instance>>(result.begin(), result.end()));
 }
 
-std::string DictionaryInstance::representation() const {
-    std::string elements_str;
-    for (auto it = _value.begin(); it != _value.end(); it++) {
-        if (it != _value.begin())
-            elements_str += ",";
-        elements_str += "(" + it->first->representation() + "," + it->second->representation() + ")";
+std::string SetInstance::op_storeUnionOf_and(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> first_buffer, second_buffer;
+    _value = union_of(set_of_variable(arguments[0], first_buffer),
+                      set_of_variable(arguments[1], second_buffer));
+    _elements_memory_usage = 0;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
+    return "null";
+}
+
+std::string SetInstance::op_storeIntersectionOf_and(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> first_buffer, second_buffer;
+    _value = intersection_of(set_of_variable(arguments[0], first_buffer),
+                             set_of_variable(arguments[1], second_buffer));
+    _elements_memory_usage = 0;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
+    return "null";
+}
+
+std::string SetInstance::op_storeDifferenceOf_and(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> first_buffer, second_buffer;
+    _value = difference_of(set_of_variable(arguments[0], first_buffer),
+                           set_of_variable(arguments[1], second_buffer));
+    _elements_memory_usage = 0;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        _elements_memory_usage += element_memory_usage(*it);
+    return "null";
+}
+
+const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& SetInstance::set_of_variable(
+    const std::string& variable, std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& buffer) const {
+    if (!Grammar::is_variable(variable))
+        throw EXC_INVALID_ARGUMENT;
+    std::shared_ptr<SetInstance> instance =
+        std::dynamic_pointer_cast<SetInstance>(Context::get_instance()->get_variable(variable));
+    if (instance == nullptr || instance->_element_type != _element_type)
+        throw EXC_INVALID_ARGUMENT;
+    if (instance->_is_intset) {
+        for (auto it = instance->_integers.values().begin(); it != instance->_integers.values().end(); it++)
+            buffer.insert(buffer.end(), std::allocate_shared<IntegerInstance>(PoolAllocator<IntegerInstance>("Integer"),
+                                                                              *it));
+        return buffer;
     }
-    return "(" + elements_str + ")";
+    if (!instance->_is_packed)
+        return instance->_value;
+    std::vector<std::shared_ptr<Instance>> elements = instance->_packed.instances();
+    buffer.insert(elements.begin(), elements.end());
+    return buffer;
 }
 
-std::string DictionaryInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+bool SetInstance::prefers_lookups(int small, int large) {
+    return small * std::log2(large + 1.0) < small + large;
+}
+
+std::string SetInstance::scan(std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>::const_iterator it,
+                              int count) const {
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    std::vector<std::shared_ptr<Instance>> elements;
+    for (; it != _value.end() && int(elements.size()) < count; it++)
+        elements.push_back(*it);
+    return "(" + set_representation(elements) + "," + ((it != _value.end()) ? cursor_representation(*it) : "null") +
+           ")";
+}
+
+std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> SetInstance::union_of(
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& first,
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& second) {
+    const auto& large = (first.size() >= second.size()) ? first : second;
+    const auto& small = (first.size() >= second.size()) ? second : first;
+    if (prefers_lookups(int(small.size()), int(large.size()))) {
+        std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> result(large);
+        result.insert(small.begin(), small.end());
+        return result;
+    }
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> result;
+    std::set_union(first.begin(), first.end(), second.begin(), second.end(), std::inserter(result, result.end()),
+                   InstanceIsLessThanComparator());
+    return result;
+}
+
+std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> SetInstance::intersection_of(
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& first,
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& second) {
+    const auto& large = (first.size() >= second.size()) ? first : second;
+    const auto& small = (first.size() >= second.size()) ? second : first;
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> result;
+    if (prefers_lookups(int(small.size()), int(large.size()))) {
+        for (auto it = small.begin(); it != small.end(); it++)
+            if (large.find(*it) != large.end())
+                result.insert(result.end(), *it);
+    }
+    else
+        std::set_intersection(first.begin(), first.end(), second.begin(), second.end(),
+                              std::inserter(result, result.end()), InstanceIsLessThanComparator());
+    return result;
+}
+
+std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> SetInstance::difference_of(
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& first,
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& second) {
+    std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> result;
+    if (prefers_lookups(int(first.size()), int(second.size()))) {
+        for (auto it = first.begin(); it != first.end(); it++)
+            if (second.find(*it) == second.end())
+                result.insert(result.end(), *it);
+    }
+    else if (prefers_lookups(int(second.size()), int(first.size()))) {
+        result = first;
+        for (auto it = second.begin(); it != second.end(); it++)
+            result.erase(*it);
+    }
+    else
+        std::set_difference(first.begin(), first.end(), second.begin(), second.end(),
+                            std::inserter(result, result.end()), InstanceIsLessThanComparator());
+    return result;
+}
+
+/////////////////////////////////////////////////// SortedSetInstance //////////////////////////////////////////////////
+
+SortedSetInstance::SortedSetInstance(const std::string& element_type, const std::string& message_name,
+                                     const std::vector<std::string>& arguments) :
+    Instance(SORTED_SET), _elements_memory_usage(0) {
+    _element_type = element_type;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+SortedSetInstance::~SortedSetInstance() {
+}
+
+std::string SortedSetInstance::representation() const {
+    return set_representation(_value.range(0, _value.size()));
+}
+
+size_t SortedSetInstance::memory_usage() const {
+    return sizeof(SortedSetInstance) + string_memory_usage(_element_type) + _value.memory_usage() +
+           _elements_memory_usage;
+}
+
+std::string SortedSetInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
     if (message_name == "get")
         return op_get(arguments);
     if (message_name == "isEmpty?")
         return op_isEmpty(arguments);
-    if (message_name == "containsKey?")
-        return op_containsKey(arguments);
+    if (message_name == "contains?")
+        return op_contains(arguments);
     if (message_name == "size")
         return op_size(arguments);
-    if (message_name == "keys")
-        return op_keys(arguments);
-    if (message_name == "values")
-        return op_values(arguments);
-    if (message_name == "getValueForKey:")
-        return op_getValueForKey(arguments);
-    if (message_name == "associateValue:withKey:")
-        return op_associateValue_withKey(arguments);
-    if (message_name == "removeKey:")
-        return op_removeKey(arguments);
+    if (message_name == "add:")
+        return op_add(arguments);
+    if (message_name == "addAll:")
+        return op_addAll(arguments);
+    if (message_name == "remove:")
+        return op_remove(arguments);
+    if (message_name == "rankOf:")
+        return op_rankOf(arguments);
+    if (message_name == "atRank:")
+        return op_atRank(arguments);
+    if (message_name == "rangeFromRank:toRank:")
+        return op_rangeFromRank_toRank(arguments);
+    if (message_name == "countBetween:and:")
+        return op_countBetween_and(arguments);
     if (message_name == "clear")
         return op_clear(arguments);
     throw EXC_INVALID_MESSAGE;
 }
 
-std::string DictionaryInstance::op_get(const std::vector<std::string>& arguments) {
+std::string SortedSetInstance::op_get(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     return representation();
 }
 
-std::string DictionaryInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+std::string SortedSetInstance::op_isEmpty(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    return _value.empty() ? "true" : "false";
+    return (_value.size() == 0) ? "true" : "false";
 }
 
-std::string DictionaryInstance::op_containsKey(const std::vector<std::string>& arguments) {
+std::string SortedSetInstance::op_contains(const std::vector<std::string>& arguments) {
     if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
-    return (_value.find(key) != _value.end()) ? "true" : "false";
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    return _value.contains(instance) ? "true" : "false";
 }
 
-std::string DictionaryInstance::op_size(const std::vector<std::string>& arguments) {
+std::string SortedSetInstance::op_size(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    return IntegerInstance(int(_value.size())).representation();
+    return IntegerInstance(_value.size()).representation();
 }
 
-std::string DictionaryInstance::op_keys(const std::vector<std::string>& arguments) {
+std::string SortedSetInstance::op_add(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    if (_value.insert(instance))
+        _elements_memory_usage += element_memory_usage(instance);
+    return "null";
+}
+
+std::string SortedSetInstance::op_addAll(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> instances = get_shared_instances(_element_type, arguments[0]);
+    for (auto it = instances.begin(); it != instances.end(); it++)
+        if (_value.insert(*it))
+            _elements_memory_usage += element_memory_usage(*it);
+    return "null";
+}
+
+std::string SortedSetInstance::op_remove(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    int rank = _value.rank_of(instance);
+    if (rank >= 0) {
+        _elements_memory_usage -= element_memory_usage(_value.at_rank(rank));
+        _value.erase(instance);
+    }
+    return "null";
+}
+
+std::string SortedSetInstance::op_rankOf(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    return IntegerInstance(_value.rank_of(instance)).representation();
+}
+
+std::string SortedSetInstance::op_atRank(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int rank = IntegerInstance(arguments[0]).value();
+    if (rank < 0 || rank >= _value.size())
+        throw EXC_INVALID_ARGUMENT;
+    return _value.at_rank(rank)->representation();
+}
+
+std::string SortedSetInstance::op_rangeFromRank_toRank(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int from_rank = IntegerInstance(arguments[0]).value();
+    int to_rank = IntegerInstance(arguments[1]).value();
+    if (from_rank < 0 || from_rank > _value.size())
+        throw EXC_INVALID_ARGUMENT;
+    if (to_rank < 0 || to_rank > _value.size())
+        throw EXC_INVALID_ARGUMENT;
+    if (to_rank - from_rank < 0)
+        throw EXC_INVALID_ARGUMENT;
+    return set_representation(_value.range(from_rank, to_rank));
+}
+
+std::string SortedSetInstance::op_countBetween_and(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> lower = get_shared_instance(_element_type, arguments[0]);
+    std::shared_ptr<Instance> upper = get_shared_instance(_element_type, arguments[1]);
+    int count = _value.count_less_than_or_equal_to(upper) - _value.count_less_than(lower);
+    return IntegerInstance(std::max(count, 0)).representation();
+}
+
+std::string SortedSetInstance::op_clear(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::vector<std::shared_ptr<Instance>> keys;
+    _value.clear();
+    _elements_memory_usage = 0;
+    return "null";
+}
+
+/////////////////////////////////////////////////// MultisetInstance ///////////////////////////////////////////////////
+
+MultisetInstance::MultisetInstance(const std::string& element_type, const std::string& message_name,
+                                   const std::vector<std::string>& arguments) :
+    Instance(MULTISET), _elements_memory_usage(0), _size(0) {
+    _element_type = element_type;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+MultisetInstance::~MultisetInstance() {
+}
+
+std::string MultisetInstance::representation() const {
+    std::string elements_str;
     for (auto it = _value.begin(); it != _value.end(); it++)
-        keys.push_back(it->first);
-    return vector_representation(keys);
+        for (int i = 0; i < it->second; i++) {
+            if (elements_str.size() > 0)
+                elements_str += ",";
+            elements_str += it->first->representation();
+        }
+    return "{" + elements_str + "}";
 }
 
-std::string DictionaryInstance::op_values(const std::vector<std::string>& arguments) {
+size_t MultisetInstance::memory_usage() const {
+    return sizeof(MultisetInstance) + string_memory_usage(_element_type) +
+           _value.size() * (tree_node_memory_usage() + sizeof(std::pair<std::shared_ptr<Instance>, int>)) +
+           _elements_memory_usage;
+}
+
+std::string MultisetInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "contains?")
+        return op_contains(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "countOf:")
+        return op_countOf(arguments);
+    if (message_name == "add:")
+        return op_add(arguments);
+    if (message_name == "addAll:")
+        return op_addAll(arguments);
+    if (message_name == "remove:")
+        return op_remove(arguments);
+    if (message_name == "removeAll:")
+        return op_removeAll(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string MultisetInstance::op_get(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::vector<std::shared_ptr<Instance>> values;
-    for (auto it = _value.begin(); it != _value.end(); it++)
-        values.push_back(it->second);
-    return vector_representation(values);
+    return representation();
 }
 
-std::string DictionaryInstance::op_getValueForKey(const std::vector<std::string>& arguments) {
+std::string MultisetInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return (_size == 0) ? "true" : "false";
+}
+
+std::string MultisetInstance::op_contains(const std::vector<std::string>& arguments) {
     if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
-    auto it = _value.find(key);
-    if (it != _value.end())
-        return it->second->representation();
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    return (_value.find(instance) != _value.end()) ? "true" : "false";
+}
+
+std::string MultisetInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_size).representation();
+}
+
+std::string MultisetInstance::op_countOf(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    auto it = _value.find(instance);
+    return IntegerInstance((it != _value.end()) ? it->second : 0).representation();
+}
+
+std::string MultisetInstance::op_add(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    auto result = _value.insert(std::make_pair(instance, 0));
+    if (result.second)
+        _elements_memory_usage += element_memory_usage(instance);
+    result.first->second++;
+    _size++;
     return "null";
 }
 
-std::string DictionaryInstance::op_associateValue_withKey(const std::vector<std::string>& arguments) {
-    if (arguments.size() != 2)
+std::string MultisetInstance::op_addAll(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::shared_ptr<Instance> value = get_shared_instance(_value_type, arguments[0]);
-    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[1]);
-    _value[key] = value;
+    std::vector<std::shared_ptr<Instance>> instances = get_shared_instances(_element_type, arguments[0]);
+    for (auto it = instances.begin(); it != instances.end(); it++) {
+        auto result = _value.insert(std::make_pair(*it, 0));
+        if (result.second)
+            _elements_memory_usage += element_memory_usage(*it);
+        result.first->second++;
+    }
+    _size += int(instances.size());
     return "null";
 }
 
-std::string DictionaryInstance::op_removeKey(const std::vector<std::string>& arguments) {
+std::string MultisetInstance::op_remove(const std::vector<std::string>& arguments) {
     if (arguments.size() != 1)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
-    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
-    _value.erase(key);
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    auto it = _value.find(instance);
+    if (it != _value.end()) {
+        _size--;
+        if (--it->second == 0) {
+            _elements_memory_usage -= element_memory_usage(it->first);
+            _value.erase(it);
+        }
+    }
     return "null";
 }
 
-std::string DictionaryInstance::op_clear(const std::vector<std::string>& arguments) {
+std::string MultisetInstance::op_removeAll(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    auto it = _value.find(instance);
+    if (it != _value.end()) {
+        _size -= it->second;
+        _elements_memory_usage -= element_memory_usage(it->first);
+        _value.erase(it);
+    }
+    return "null";
+}
+
+std::string MultisetInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    _elements_memory_usage = 0;
+    _size = 0;
+    return "null";
+}
+
+////////////////////////////////////////////////// DictionaryInstance //////////////////////////////////////////////////
+
+DictionaryInstance::DictionaryInstance(const std::string& key_type, const std::string& value_type,
+                                       const std::string& message_name, const std::vector<std::string>& arguments) :
+    Instance(DICTIONARY), _elements_memory_usage(0) {
+    _key_type = key_type;
+    _value_type = value_type;
+    _is_packed = true;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+DictionaryInstance::~DictionaryInstance() {
+}
+
+std::string DictionaryInstance::representation() const {
+    std::string elements_str;
+    if (_is_packed) {
+        std::vector<std::string> keys_and_values = _packed.representations();
+        for (int i = 0; i < int(keys_and_values.size()); i += 2) {
+            if (i > 0)
+                elements_str += ",";
+            elements_str += "(" + keys_and_values[i] + "," + keys_and_values[i + 1] + ")";
+        }
+        return "(" + elements_str + ")";
+    }
+    for (auto it = _value.begin(); it != _value.end(); it++) {
+        if (it != _value.begin())
+            elements_str += ",";
+        elements_str += "(" + it->first->representation() + "," + it->second->representation() + ")";
+    }
+    return "(" + elements_str + ")";
+}
+
+size_t DictionaryInstance::memory_usage() const {
+    return sizeof(DictionaryInstance) + string_memory_usage(_key_type) + string_memory_usage(_value_type) +
+           _packed.bytes() + _value.size() * (tree_node_memory_usage() + 2 * sizeof(std::shared_ptr<Instance>)) +
+           _elements_memory_usage;
+}
+
+std::string DictionaryInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (!_is_packed)
+        return dispatch(message_name, arguments);
+    std::string output;
+    if (dispatch_packed(message_name, arguments, output))
+        return output;
+    unpack();
+    try {
+        output = dispatch(message_name, arguments);
+    }
+    catch (...) {
+        pack_if_small();
+        throw;
+    }
+    pack_if_small();
+    return output;
+}
+
+void DictionaryInstance::unpack() {
+    std::vector<std::shared_ptr<Instance>> keys_and_values = _packed.instances();
+    for (int i = 0; i < int(keys_and_values.size()); i += 2) {
+        _value.emplace_hint(_value.end(), keys_and_values[i], keys_and_values[i + 1]);
+        _elements_memory_usage += element_memory_usage(keys_and_values[i]) +
+                                  element_memory_usage(keys_and_values[i + 1]);
+    }
+    _packed.clear();
+    _is_packed = false;
+}
+
+void DictionaryInstance::pack_if_small() {
+    if (int(_value.size()) * 2 > Listpack::MAX_SIZE)
+        return;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        if (!Listpack::is_packable(*it->first) || !Listpack::is_packable(*it->second))
+            return;
+    for (auto it = _value.begin(); it != _value.end(); it++) {
+        _packed.push_back(*it->first);
+        _packed.push_back(*it->second);
+    }
+    _value.clear();
+    _elements_memory_usage = 0;
+    _is_packed = true;
+}
+
+bool DictionaryInstance::dispatch_packed(const std::string& message_name, const std::vector<std::string>& arguments,
+                                         std::string& output) {
+    if (message_name == "get" || message_name == "isEmpty?" || message_name == "size" || message_name == "keys" ||
+        message_name == "values") {
+        if (arguments.size() != 0)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (message_name == "get")
+            output = representation();
+        else if (message_name == "isEmpty?")
+            output = (_packed.size() == 0) ? "true" : "false";
+        else if (message_name == "size")
+            output = IntegerInstance(_packed.size() / 2).representation();
+        else
+            output = "[" + joined_representations(_packed.representations(), (message_name == "keys") ? 0 : 1, 2) +
+                     "]";
+        return true;
+    }
+    if (message_name == "containsKey?" || message_name == "getValueForKey:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+        int index = _packed.index_of(*key, 0, 2);
+        if (message_name == "containsKey?")
+            output = (index >= 0) ? "true" : "false";
+        else
+            output = (index >= 0) ? _packed.representation_at(index + 1) : "null";
+        return true;
+    }
+    if (message_name == "associateValue:withKey:") {
+        if (arguments.size() != 2)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> value = get_shared_instance(_value_type, arguments[0]);
+        std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[1]);
+        int index = _packed.lower_bound(*key, 2);
+        bool is_present = index < _packed.size() && _packed.is_equal_at(index, *key);
+        if (!Listpack::is_packable(*value))
+            return false;
+        if (is_present)
+            _packed.replace(index + 1, *value);
+        else {
+            if (!Listpack::is_packable(*key) || _packed.size() + 2 > Listpack::MAX_SIZE)
+                return false;
+            _packed.insert(index, *key);
+            _packed.insert(index + 1, *value);
+        }
+        output = "null";
+        return true;
+    }
+    if (message_name == "removeKey:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+        int index = _packed.lower_bound(*key, 2);
+        if (index < _packed.size() && _packed.is_equal_at(index, *key)) {
+            _packed.erase(index + 1);
+            _packed.erase(index);
+        }
+        output = "null";
+        return true;
+    }
+    if (message_name == "incrementValueForKey:by:" || message_name == "decrementValueForKey:by:") {
+        if (arguments.size() != 2)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (_value_type != "Integer" && _value_type != "Float")
+            throw EXC_INVALID_MESSAGE;
+        std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+        if (!Grammar::is_float_value(arguments[1]))
+            throw EXC_INVALID_ARGUMENT;
+        int index = _packed.lower_bound(*key, 2);
+        bool is_present = index < _packed.size() && _packed.is_equal_at(index, *key);
+        if (!is_present && (!Listpack::is_packable(*key) || _packed.size() + 2 > Listpack::MAX_SIZE))
+            return false;
+        IntegerInstance integer_value((is_present && _value_type == "Integer") ? _packed.integer_at(index + 1) : 0);
+        FloatInstance float_value((is_present && _value_type == "Float") ? _packed.float_at(index + 1) : 0.0f);
+        Instance& value = (_value_type == "Integer") ? static_cast<Instance&>(integer_value) : float_value;
+        if (!is_present) {
+            _packed.insert(index, *key);
+            _packed.insert(index + 1, value);
+        }
+        value.receive((message_name == "incrementValueForKey:by:") ? "add:" : "subtract:",
+                      std::vector<std::string>({arguments[1]}));
+        _packed.replace(index + 1, value);
+        output = value.representation();
+        return true;
+    }
+    return false;
+}
+
+std::string DictionaryInstance::dispatch(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "containsKey?")
+        return op_containsKey(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "keys")
+        return op_keys(arguments);
+    if (message_name == "values")
+        return op_values(arguments);
+    if (message_name == "getValueForKey:")
+        return op_getValueForKey(arguments);
+    if (message_name == "getValuesForKeys:")
+        return op_getValuesForKeys(arguments);
+    if (message_name == "scanFirst:")
+        return op_scanFirst(arguments);
+    if (message_name == "scanFrom:count:")
+        return op_scanFrom_count(arguments);
+    if (message_name == "associateValue:withKey:")
+        return op_associateValue_withKey(arguments);
+    if (message_name == "associateValues:withKeys:")
+        return op_associateValues_withKeys(arguments);
+    if (message_name == "removeKey:")
+        return op_removeKey(arguments);
+    if (message_name == "incrementValueForKey:by:")
+        return op_incrementValueForKey_by(arguments);
+    if (message_name == "decrementValueForKey:by:")
+        return op_decrementValueForKey_by(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string DictionaryInstance::op_get(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string DictionaryInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string DictionaryInstance::op_containsKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    return (_value.find(key) != _value.end()) ? "true" : "false";
+}
+
+std::string DictionaryInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(int(_value.size())).representation();
+}
+
+std::string DictionaryInstance::op_keys(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> keys;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        keys.push_back(it->first);
+    return vector_representation(keys);
+}
+
+std::string DictionaryInstance::op_values(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> values;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        values.push_back(it->second);
+    return vector_representation(values);
+}
+
+std::string DictionaryInstance::op_getValueForKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    auto it = _value.find(key);
+    if (it != _value.end())
+        return it->second->representation();
+    return "null";
+}
+
+std::string DictionaryInstance::op_getValuesForKeys(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> keys = get_shared_instances(_key_type, arguments[0]);
+    std::string elements_str;
+    for (auto it = keys.begin(); it != keys.end(); it++) {
+        if (it != keys.begin())
+            elements_str += ",";
+        auto value = _value.find(*it);
+        elements_str += (value != _value.end()) ? value->second->representation() : "null";
+    }
+    return "[" + elements_str + "]";
+}
+
+std::string DictionaryInstance::op_scanFirst(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return scan(_value.begin(), IntegerInstance(arguments[0]).value());
+}
+
+std::string DictionaryInstance::op_scanFrom_count(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    return scan(_value.lower_bound(key), IntegerInstance(arguments[1]).value());
+}
+
+std::string DictionaryInstance::op_associateValue_withKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> value = get_shared_instance(_value_type, arguments[0]);
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[1]);
+    associate(key, value);
+    return "null";
+}
+
+std::string DictionaryInstance::op_associateValues_withKeys(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> values = get_shared_instances(_value_type, arguments[0]);
+    std::vector<std::shared_ptr<Instance>> keys = get_shared_instances(_key_type, arguments[1]);
+    if (values.size() != keys.size())
+        throw EXC_INVALID_ARGUMENT;
+    for (int i = 0; i < int(keys.size()); i++)
+        associate(keys[i], values[i]);
+    return "null";
+}
+
+std::string DictionaryInstance::op_removeKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    auto it = _value.find(key);
+    if (it != _value.end()) {
+        _elements_memory_usage -= element_memory_usage(it->first) + element_memory_usage(it->second);
+        _value.erase(it);
+    }
+    return "null";
+}
+
+std::string DictionaryInstance::op_incrementValueForKey_by(const std::vector<std::string>& arguments) {
+    return update_value_for_key("add:", arguments);
+}
+
+std::string DictionaryInstance::op_decrementValueForKey_by(const std::vector<std::string>& arguments) {
+    return update_value_for_key("subtract:", arguments);
+}
+
+std::string DictionaryInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    _elements_memory_usage = 0;
+    return "null";
+}
+
+std::string DictionaryInstance::update_value_for_key(const std::string& message_name,
+                                                     const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (_value_type != "Integer" && _value_type != "Float")
+        throw EXC_INVALID_MESSAGE;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    if (!Grammar::is_float_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    auto it = _value.find(key);
+    if (it == _value.end()) {
+        it = _value.insert(std::make_pair(key, get_shared_instance(_value_type, "0"))).first;
+        _elements_memory_usage += element_memory_usage(it->first) + element_memory_usage(it->second);
+    }
+    it->second->receive(message_name, std::vector<std::string>({arguments[1]}));
+    return it->second->representation();
+}
+
+void DictionaryInstance::associate(const std::shared_ptr<Instance>& key, const std::shared_ptr<Instance>& value) {
+    auto it = _value.find(key);
+    if (it == _value.end()) {
+        _value.insert(it, std::make_pair(key, value));
+        _elements_memory_usage += element_memory_usage(key) + element_memory_usage(value);
+    }
+    else {
+        _elements_memory_usage = _elements_memory_usage - element_memory_usage(it->second) +
+                                 element_memory_usage(value);
+        it->second = value;
+    }
+}
+
+std::string DictionaryInstance::scan(std::map<std::shared_ptr<Instance>, std::shared_ptr<Instance>,
+                                              InstanceIsLessThanComparator>::const_iterator it, int count) const {
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    std::string elements_str;
+    for (int i = 0; it != _value.end() && i < count; it++, i++) {
+        if (i > 0)
+            elements_str += ",";
+        elements_str += "(" + it->first->representation() + "," + it->second->representation() + ")";
+    }
+    return "((" + elements_str + ")," + ((it != _value.end()) ? cursor_representation(it->first) : "null") + ")";
+}
+
+/////////////////////////////////////////////// MultidictionaryInstance ////////////////////////////////////////////////
+
+MultidictionaryInstance::MultidictionaryInstance(const std::string& key_type, const std::string& value_type,
+                                                 const std::string& message_name,
+                                                 const std::vector<std::string>& arguments) :
+    Instance(MULTIDICTIONARY), _elements_memory_usage(0), _size(0) {
+    _key_type = key_type;
+    _value_type = value_type;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+MultidictionaryInstance::~MultidictionaryInstance() {
+}
+
+std::string MultidictionaryInstance::representation() const {
+    std::string elements_str;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        for (auto value = it->second.begin(); value != it->second.end(); value++) {
+            if (elements_str.size() > 0)
+                elements_str += ",";
+            elements_str += "(" + it->first->representation() + "," + (*value)->representation() + ")";
+        }
+    return "(" + elements_str + ")";
+}
+
+size_t MultidictionaryInstance::memory_usage() const {
+    return sizeof(MultidictionaryInstance) + string_memory_usage(_key_type) + string_memory_usage(_value_type) +
+           _value.size() * (tree_node_memory_usage() + sizeof(std::shared_ptr<Instance>) +
+                            sizeof(std::vector<std::shared_ptr<Instance>>)) +
+           _size * sizeof(std::shared_ptr<Instance>) + _elements_memory_usage;
+}
+
+std::string MultidictionaryInstance::receive(const std::string& message_name,
+                                             const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "containsKey?")
+        return op_containsKey(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "keys")
+        return op_keys(arguments);
+    if (message_name == "values")
+        return op_values(arguments);
+    if (message_name == "getValuesForKey:")
+        return op_getValuesForKey(arguments);
+    if (message_name == "countValuesForKey:")
+        return op_countValuesForKey(arguments);
+    if (message_name == "associateValue:withKey:")
+        return op_associateValue_withKey(arguments);
+    if (message_name == "removeValue:withKey:")
+        return op_removeValue_withKey(arguments);
+    if (message_name == "removeKey:")
+        return op_removeKey(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string MultidictionaryInstance::op_get(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string MultidictionaryInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string MultidictionaryInstance::op_containsKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    return (_value.find(key) != _value.end()) ? "true" : "false";
+}
+
+std::string MultidictionaryInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_size).representation();
+}
+
+std::string MultidictionaryInstance::op_keys(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> keys;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        keys.push_back(it->first);
+    return vector_representation(keys);
+}
+
+std::string MultidictionaryInstance::op_values(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::vector<std::shared_ptr<Instance>> values;
+    for (auto it = _value.begin(); it != _value.end(); it++)
+        values.insert(values.end(), it->second.begin(), it->second.end());
+    return vector_representation(values);
+}
+
+std::string MultidictionaryInstance::op_getValuesForKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    auto it = _value.find(key);
+    if (it != _value.end())
+        return vector_representation(it->second);
+    return "[]";
+}
+
+std::string MultidictionaryInstance::op_countValuesForKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    auto it = _value.find(key);
+    return IntegerInstance((it != _value.end()) ? int(it->second.size()) : 0).representation();
+}
+
+std::string MultidictionaryInstance::op_associateValue_withKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> value = get_shared_instance(_value_type, arguments[0]);
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[1]);
+    auto it = _value.find(key);
+    if (it == _value.end()) {
+        it = _value.insert(std::make_pair(key, std::vector<std::shared_ptr<Instance>>())).first;
+        _elements_memory_usage += element_memory_usage(key);
+    }
+    it->second.push_back(value);
+    _elements_memory_usage += element_memory_usage(value);
+    _size++;
+    return "null";
+}
+
+std::string MultidictionaryInstance::op_removeValue_withKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> value = get_shared_instance(_value_type, arguments[0]);
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[1]);
+    auto it = _value.find(key);
+    if (it == _value.end())
+        return "null";
+    for (auto value_it = it->second.begin(); value_it != it->second.end(); value_it++)
+        if (InstanceIsEqualToComparator()(*value_it, value)) {
+            _elements_memory_usage -= element_memory_usage(*value_it);
+            it->second.erase(value_it);
+            _size--;
+            break;
+        }
+    if (it->second.empty()) {
+        _elements_memory_usage -= element_memory_usage(it->first);
+        _value.erase(it);
+    }
+    return "null";
+}
+
+std::string MultidictionaryInstance::op_removeKey(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> key = get_shared_instance(_key_type, arguments[0]);
+    auto it = _value.find(key);
+    if (it != _value.end()) {
+        _size -= int(it->second.size());
+        _elements_memory_usage -= element_memory_usage(it->first);
+        for (auto value_it = it->second.begin(); value_it != it->second.end(); value_it++)
+            _elements_memory_usage -= element_memory_usage(*value_it);
+        _value.erase(it);
+    }
+    return "null";
+}
+
+std::string MultidictionaryInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    _elements_memory_usage = 0;
+    _size = 0;
+    return "null";
+}
+
+//////////////////////////////////////////////// PriorityQueueInstance /////////////////////////////////////////////////
+
+PriorityQueueInstance::PriorityQueueInstance(const std::string& element_type, const std::string& message_name,
+                                             const std::vector<std::string>& arguments) :
+    Instance(PRIORITY_QUEUE), _elements_memory_usage(0) {
+    _element_type = element_type;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+PriorityQueueInstance::~PriorityQueueInstance() {
+}
+
+std::string PriorityQueueInstance::representation() const {
+    return vector_representation(_value.elements());
+}
+
+size_t PriorityQueueInstance::memory_usage() const {
+    return sizeof(PriorityQueueInstance) + string_memory_usage(_element_type) + _value.memory_usage() +
+           _elements_memory_usage;
+}
+
+std::string PriorityQueueInstance::receive(const std::string& message_name,
+                                           const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "push:withPriority:")
+        return op_push_withPriority(arguments);
+    if (message_name == "peekMin")
+        return op_peekMin(arguments);
+    if (message_name == "popMin")
+        return op_popMin(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string PriorityQueueInstance::op_get(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string PriorityQueueInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string PriorityQueueInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_value.size()).representation();
+}
+
+std::string PriorityQueueInstance::op_push_withPriority(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    if (!Grammar::is_integer_value(arguments[1]) && !Grammar::is_float_value(arguments[1]))
+        throw EXC_INVALID_ARGUMENT;
+    _value.push(instance, atof(arguments[1].c_str()));
+    _elements_memory_usage += element_memory_usage(instance);
+    return "null";
+}
+
+std::string PriorityQueueInstance::op_peekMin(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = _value.top();
+    return instance ? instance->representation() : "null";
+}
+
+std::string PriorityQueueInstance::op_popMin(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = _value.pop();
+    if (!instance)
+        return "null";
+    _elements_memory_usage -= element_memory_usage(instance);
+    return instance->representation();
+}
+
+std::string PriorityQueueInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    _elements_memory_usage = 0;
+    return "null";
+}
+
+/////////////////////////////////////////////////// StreamInstance /////////////////////////////////////////////////////
+
+StreamInstance::StreamInstance(const std::string& element_type, const std::string& message_name,
+                               const std::vector<std::string>& arguments) :
+    Instance(STREAM), _elements_memory_usage(0) {
+    _element_type = element_type;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+StreamInstance::~StreamInstance() {
+}
+
+std::string StreamInstance::entries_representation(
+    const std::vector<std::pair<int, std::shared_ptr<Instance>>>& entries) {
+    std::string entries_str;
+    for (auto it = entries.begin(); it != entries.end(); it++) {
+        if (it != entries.begin())
+            entries_str += ",";
+        entries_str += "(" + IntegerInstance(it->first).representation() + "," + it->second->representation() + ")";
+    }
+    return "(" + entries_str + ")";
+}
+
+std::string StreamInstance::representation() const {
+    return entries_representation(_value.read(_value.first_id(), _value.size()));
+}
+
+size_t StreamInstance::memory_usage() const {
+    return sizeof(StreamInstance) + string_memory_usage(_element_type) + _value.memory_usage() +
+           _offsets.size() * (tree_node_memory_usage() + sizeof(std::pair<std::string, int>)) +
+           _elements_memory_usage;
+}
+
+std::string StreamInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "firstId")
+        return op_firstId(arguments);
+    if (message_name == "lastId")
+        return op_lastId(arguments);
+    if (message_name == "append:")
+        return op_append(arguments);
+    if (message_name == "readFrom:count:")
+        return op_readFrom_count(arguments);
+    if (message_name == "readNext:forConsumer:")
+        return op_readNext_forConsumer(arguments);
+    if (message_name == "offsetOf:")
+        return op_offsetOf(arguments);
+    if (message_name == "setOffset:forConsumer:")
+        return op_setOffset_forConsumer(arguments);
+    if (message_name == "trimBefore:")
+        return op_trimBefore(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string StreamInstance::op_get(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string StreamInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string StreamInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_value.size()).representation();
+}
+
+std::string StreamInstance::op_firstId(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "-1" : IntegerInstance(_value.first_id()).representation();
+}
+
+std::string StreamInstance::op_lastId(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "-1" : IntegerInstance(_value.next_id() - 1).representation();
+}
+
+std::string StreamInstance::op_append(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    _elements_memory_usage += element_memory_usage(instance);
+    return IntegerInstance(_value.append(instance)).representation();
+}
+
+std::string StreamInstance::op_readFrom_count(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int from_id = IntegerInstance(arguments[0]).value();
+    int count = IntegerInstance(arguments[1]).value();
+    if (from_id < 0 || count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    return entries_representation(_value.read(from_id, count));
+}
+
+std::string StreamInstance::op_readNext_forConsumer(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int count = IntegerInstance(arguments[0]).value();
+    std::string consumer = StringInstance(arguments[1]).value();
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    std::vector<std::pair<int, std::shared_ptr<Instance>>> entries = _value.read(_offsets[consumer], count);
+    if (!entries.empty())
+        _offsets[consumer] = entries.back().first + 1;
+    return entries_representation(entries);
+}
+
+std::string StreamInstance::op_offsetOf(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::string consumer = StringInstance(arguments[0]).value();
+    auto it = _offsets.find(consumer);
+    return IntegerInstance((it != _offsets.end()) ? it->second : 0).representation();
+}
+
+std::string StreamInstance::op_setOffset_forConsumer(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int offset = IntegerInstance(arguments[0]).value();
+    std::string consumer = StringInstance(arguments[1]).value();
+    if (offset < 0)
+        throw EXC_INVALID_ARGUMENT;
+    _offsets[consumer] = offset;
+    return "null";
+}
+
+std::string StreamInstance::op_trimBefore(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int id = IntegerInstance(arguments[0]).value();
+    if (id > _value.first_id()) {
+        std::vector<std::pair<int, std::shared_ptr<Instance>>> entries = _value.read(_value.first_id(),
+                                                                                     id - _value.first_id());
+        for (auto it = entries.begin(); it != entries.end(); it++)
+            _elements_memory_usage -= element_memory_usage(it->second);
+    }
+    _value.trim_before(id);
+    return "null";
+}
+
+std::string StreamInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    _offsets.clear();
+    _elements_memory_usage = 0;
+    return "null";
+}
+
+//////////////////////////////////////////////////// BitmapInstance ////////////////////////////////////////////////////
+
+BitmapInstance::BitmapInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
+    Instance(BITMAP) {
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+BitmapInstance::~BitmapInstance() {
+}
+
+std::string BitmapInstance::representation() const {
+    std::vector<int> indexes = _value.indexes();
+    std::string elements_str;
+    for (auto it = indexes.begin(); it != indexes.end(); it++) {
+        if (it != indexes.begin())
+            elements_str += ",";
+        elements_str += IntegerInstance(*it).representation();
+    }
+    return "{" + elements_str + "}";
+}
+
+size_t BitmapInstance::memory_usage() const {
+    return sizeof(BitmapInstance) + _value.memory_usage();
+}
+
+std::string BitmapInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "getBit:")
+        return op_getBit(arguments);
+    if (message_name == "setBit:")
+        return op_setBit(arguments);
+    if (message_name == "clearBit:")
+        return op_clearBit(arguments);
+    if (message_name == "countOnes")
+        return op_countOnes(arguments);
+    if (message_name == "countOnesFrom:to:")
+        return op_countOnesFrom_to(arguments);
+    if (message_name == "firstSet")
+        return op_firstSet(arguments);
+    if (message_name == "andWith:")
+        return op_andWith(arguments);
+    if (message_name == "orWith:")
+        return op_orWith(arguments);
+    if (message_name == "xorWith:")
+        return op_xorWith(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string BitmapInstance::op_get(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string BitmapInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string BitmapInstance::op_getBit(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int index = IntegerInstance(arguments[0]).value();
+    if (index < 0)
+        throw EXC_INVALID_ARGUMENT;
+    return _value.test(index) ? "true" : "false";
+}
+
+std::string BitmapInstance::op_setBit(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int index = IntegerInstance(arguments[0]).value();
+    if (index < 0)
+        throw EXC_INVALID_ARGUMENT;
+    _value.set(index);
+    return "null";
+}
+
+std::string BitmapInstance::op_clearBit(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int index = IntegerInstance(arguments[0]).value();
+    if (index < 0)
+        throw EXC_INVALID_ARGUMENT;
+    _value.unset(index);
+    return "null";
+}
+
+std::string BitmapInstance::op_countOnes(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_value.count()).representation();
+}
+
+std::string BitmapInstance::op_countOnesFrom_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int from_index = IntegerInstance(arguments[0]).value();
+    int to_index = IntegerInstance(arguments[1]).value();
+    if (from_index < 0 || to_index < 0)
+        throw EXC_INVALID_ARGUMENT;
+    if (to_index - from_index < 0)
+        throw EXC_INVALID_ARGUMENT;
+    return IntegerInstance(_value.count_range(from_index, to_index)).representation();
+}
+
+std::string BitmapInstance::op_firstSet(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_value.first_set()).representation();
+}
+
+std::string BitmapInstance::op_andWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.and_with(bitmap_of_variable(arguments[0]));
+    return "null";
+}
+
+std::string BitmapInstance::op_orWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.or_with(bitmap_of_variable(arguments[0]));
+    return "null";
+}
+
+std::string BitmapInstance::op_xorWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.xor_with(bitmap_of_variable(arguments[0]));
+    return "null";
+}
+
+std::string BitmapInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    return "null";
+}
+
+const Bitmap& BitmapInstance::bitmap_of_variable(const std::string& variable) {
+    if (!Grammar::is_variable(variable))
+        throw EXC_INVALID_ARGUMENT;
+    std::shared_ptr<BitmapInstance> instance =
+        std::dynamic_pointer_cast<BitmapInstance>(Context::get_instance()->get_variable(variable));
+    if (instance == nullptr)
+        throw EXC_INVALID_ARGUMENT;
+    return instance->_value;
+}
+
+////////////////////////////////////////////////// TimeSeriesInstance //////////////////////////////////////////////////
+
+TimeSeriesInstance::TimeSeriesInstance(const std::string& message_name, const std::vector<std::string>& arguments) :
+    Instance(TIME_SERIES) {
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+TimeSeriesInstance::~TimeSeriesInstance() {
+}
+
+template <typename T>
+std::string TimeSeriesInstance::samples_representation(const std::vector<std::pair<int64_t, T>>& samples) {
+    std::string samples_str;
+    for (auto it = samples.begin(); it != samples.end(); it++) {
+        if (it != samples.begin())
+            samples_str += ",";
+        samples_str += "(" + std::to_string(it->first) + "," + FloatInstance(float(it->second)).representation() + ")";
+    }
+    return "(" + samples_str + ")";
+}
+
+int64_t TimeSeriesInstance::timestamp_of(const std::string& str) {
+    if (!Grammar::is_integer_value(str))
+        throw EXC_INVALID_ARGUMENT;
+    return strtoll(str.c_str(), nullptr, 10);
+}
+
+std::string TimeSeriesInstance::representation() const {
+    return samples_representation(_value.range(INT64_MIN, INT64_MAX));
+}
+
+size_t TimeSeriesInstance::memory_usage() const {
+    return sizeof(TimeSeriesInstance) + _value.memory_usage();
+}
+
+std::string TimeSeriesInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "get")
+        return op_get(arguments);
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "append:at:")
+        return op_append_at(arguments);
+    if (message_name == "rangeFrom:to:")
+        return op_rangeFrom_to(arguments);
+    if (message_name == "avgFrom:to:bucket:")
+        return op_avgFrom_to_bucket(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string TimeSeriesInstance::op_get(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string TimeSeriesInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string TimeSeriesInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return IntegerInstance(_value.size()).representation();
+}
+
+std::string TimeSeriesInstance::op_append_at(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (!Grammar::is_integer_value(arguments[0]) && !Grammar::is_float_value(arguments[0]))
+        throw EXC_INVALID_ARGUMENT;
+    if (!_value.append(timestamp_of(arguments[1]), atof(arguments[0].c_str())))
+        throw EXC_INVALID_ARGUMENT;
+    return "null";
+}
+
+std::string TimeSeriesInstance::op_rangeFrom_to(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return samples_representation(_value.range(timestamp_of(arguments[0]), timestamp_of(arguments[1])));
+}
+
+std::string TimeSeriesInstance::op_avgFrom_to_bucket(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 3)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    int64_t from = timestamp_of(arguments[0]), to = timestamp_of(arguments[1]), bucket = timestamp_of(arguments[2]);
+    if (bucket <= 0)
+        throw EXC_INVALID_ARGUMENT;
+    return samples_representation(_value.average(from, to, bucket));
+}
+
+std::string TimeSeriesInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    return "null";
+}
+
+///////////////////////////////////////////////// HyperLogLogInstance //////////////////////////////////////////////////
+
+HyperLogLogInstance::HyperLogLogInstance(const std::string& element_type, const std::string& message_name,
+                                         const std::vector<std::string>& arguments) : Instance(HYPERLOGLOG) {
+    _element_type = element_type;
+    if (message_name == "create:" || message_name == "createIfNotExists:") {
+        if (arguments.size() != 1)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+HyperLogLogInstance::~HyperLogLogInstance() {
+}
+
+std::string HyperLogLogInstance::representation() const {
+    return IntegerInstance(_value.estimate()).representation();
+}
+
+size_t HyperLogLogInstance::memory_usage() const {
+    return sizeof(HyperLogLogInstance) + string_memory_usage(_element_type) + _value.memory_usage();
+}
+
+std::string HyperLogLogInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "add:")
+        return op_add(arguments);
+    if (message_name == "estimate")
+        return op_estimate(arguments);
+    if (message_name == "mergeWith:")
+        return op_mergeWith(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string HyperLogLogInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return _value.empty() ? "true" : "false";
+}
+
+std::string HyperLogLogInstance::op_add(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    _value.add(str_utils::hash(hash_key_of(*instance)));
+    return "null";
+}
+
+std::string HyperLogLogInstance::op_estimate(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string HyperLogLogInstance::op_mergeWith(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.merge(hyperloglog_of_variable(arguments[0]));
+    return "null";
+}
+
+std::string HyperLogLogInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    return "null";
+}
+
+const HyperLogLog& HyperLogLogInstance::hyperloglog_of_variable(const std::string& variable) const {
+    if (!Grammar::is_variable(variable))
+        throw EXC_INVALID_ARGUMENT;
+    std::shared_ptr<HyperLogLogInstance> instance =
+        std::dynamic_pointer_cast<HyperLogLogInstance>(Context::get_instance()->get_variable(variable));
+    if (instance == nullptr || instance->_element_type != _element_type)
+        throw EXC_INVALID_ARGUMENT;
+    return instance->_value;
+}
+
+///////////////////////////////////////////////// BloomFilterInstance //////////////////////////////////////////////////
+
+BloomFilterInstance::BloomFilterInstance(const std::string& element_type, const std::string& message_name,
+                                         const std::vector<std::string>& arguments) : Instance(BLOOM_FILTER) {
+    _element_type = element_type;
+    if (message_name == "create:withCapacity:falsePositiveRate:" ||
+        message_name == "createIfNotExists:withCapacity:falsePositiveRate:") {
+        if (arguments.size() != 3)
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]) || !Grammar::is_integer_value(arguments[1]) ||
+            !Grammar::is_float_value(arguments[2]))
+            throw EXC_INVALID_ARGUMENT;
+        int capacity = atoi(arguments[1].c_str());
+        double false_positive_rate = atof(arguments[2].c_str());
+        if (capacity <= 0 || false_positive_rate <= 0 || false_positive_rate >= 1 ||
+            BloomFilter::bits_for(capacity, false_positive_rate) > BloomFilter::MAX_BITS)
+            throw EXC_INVALID_ARGUMENT;
+        _value = BloomFilter(capacity, false_positive_rate);
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+BloomFilterInstance::~BloomFilterInstance() {
+}
+
+std::string BloomFilterInstance::representation() const {
+    return IntegerInstance(_value.count()).representation();
+}
+
+size_t BloomFilterInstance::memory_usage() const {
+    return sizeof(BloomFilterInstance) + string_memory_usage(_element_type) + _value.memory_usage();
+}
+
+std::string BloomFilterInstance::receive(const std::string& message_name, const std::vector<std::string>& arguments) {
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "size")
+        return op_size(arguments);
+    if (message_name == "add:")
+        return op_add(arguments);
+    if (message_name == "mightContain?")
+        return op_mightContain(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string BloomFilterInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return (_value.count() == 0) ? "true" : "false";
+}
+
+std::string BloomFilterInstance::op_size(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string BloomFilterInstance::op_add(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    _value.add(str_utils::hash(hash_key_of(*instance)));
+    return "null";
+}
+
+std::string BloomFilterInstance::op_mightContain(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    return _value.might_contain(str_utils::hash(hash_key_of(*instance))) ? "true" : "false";
+}
+
+std::string BloomFilterInstance::op_clear(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    _value.clear();
+    return "null";
+}
+
+/////////////////////////////////////////////// CountMinSketchInstance /////////////////////////////////////////////////
+
+CountMinSketchInstance::CountMinSketchInstance(const std::string& element_type, const std::string& message_name,
+                                               const std::vector<std::string>& arguments) :
+    Instance(COUNT_MIN_SKETCH) {
+    _element_type = element_type;
+    if (message_name == "create:withWidth:depth:" || message_name == "createIfNotExists:withWidth:depth:" ||
+        message_name == "create:withWidth:depth:topK:" || message_name == "createIfNotExists:withWidth:depth:topK:") {
+        bool has_top_k = str_utils::ends_with(message_name, "topK:");
+        if (arguments.size() != (has_top_k ? 4 : 3))
+            throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+        if (!Grammar::is_variable(arguments[0]))
+            throw EXC_INVALID_ARGUMENT;
+        for (int i = 1; i < int(arguments.size()); i++)
+            if (!Grammar::is_integer_value(arguments[i]))
+                throw EXC_INVALID_ARGUMENT;
+        int width = atoi(arguments[1].c_str());
+        int depth = atoi(arguments[2].c_str());
+        int k = has_top_k ? atoi(arguments[3].c_str()) : 0;
+        if (width <= 0 || depth <= 0 || (long long) width * depth > CountMinSketch::MAX_COUNTERS || k < 0 ||
+            k > CountMinSketch::MAX_K)
+            throw EXC_INVALID_ARGUMENT;
+        _value = CountMinSketch(width, depth, k);
+    }
+    else
+        throw EXC_INVALID_MESSAGE;
+}
+
+CountMinSketchInstance::~CountMinSketchInstance() {
+}
+
+std::string CountMinSketchInstance::representation() const {
+    return std::to_string(_value.total());
+}
+
+size_t CountMinSketchInstance::memory_usage() const {
+    return sizeof(CountMinSketchInstance) + string_memory_usage(_element_type) + _value.memory_usage();
+}
+
+std::string CountMinSketchInstance::receive(const std::string& message_name,
+                                            const std::vector<std::string>& arguments) {
+    if (message_name == "isEmpty?")
+        return op_isEmpty(arguments);
+    if (message_name == "total")
+        return op_total(arguments);
+    if (message_name == "increment:by:")
+        return op_increment_by(arguments);
+    if (message_name == "estimate:")
+        return op_estimate(arguments);
+    if (message_name == "topK")
+        return op_topK(arguments);
+    if (message_name == "clear")
+        return op_clear(arguments);
+    throw EXC_INVALID_MESSAGE;
+}
+
+std::string CountMinSketchInstance::op_isEmpty(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return (_value.total() == 0) ? "true" : "false";
+}
+
+std::string CountMinSketchInstance::op_total(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    return representation();
+}
+
+std::string CountMinSketchInstance::op_increment_by(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 2)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    int count = IntegerInstance(arguments[1]).value();
+    if (count < 0)
+        throw EXC_INVALID_ARGUMENT;
+    return IntegerInstance(_value.increment(hash_key_of(*instance), count)).representation();
+}
+
+std::string CountMinSketchInstance::op_estimate(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 1)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    std::shared_ptr<Instance> instance = get_shared_instance(_element_type, arguments[0]);
+    return IntegerInstance(_value.estimate(hash_key_of(*instance))).representation();
+}
+
+std::string CountMinSketchInstance::op_topK(const std::vector<std::string>& arguments) {
+    if (arguments.size() != 0)
+        throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
+    if (_value.k() == 0)
+        throw EXC_INVALID_MESSAGE;
+    std::vector<std::pair<std::string, int>> top = _value.top();
+    std::string elements_str;
+    for (auto it = top.begin(); it != top.end(); it++) {
+        if (it != top.begin())
+            elements_str += ",";
+        elements_str += hash_key_representation(it->first);
+    }
+    return "[" + elements_str + "]";
+}
+
+std::string CountMinSketchInstance::op_clear(const std::vector<std::string>& arguments) {
     if (arguments.size() != 0)
         throw EXC_WRONG_NUMBER_OF_ARGUMENTS;
     _value.clear();
@@ -26,31 +26,52 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef KNUCKLEBALL_INSTANCE_H
 #define KNUCKLEBALL_INSTANCE_H
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "bitmap.h"
+#include "bloom_filter.h"
+#include "count_min_sketch.h"
+#include "hyperloglog.h"
+#include "intset.h"
+#include "listpack.h"
+#include "order_statistic_tree.h"
+#include "priority_heap.h"
+#include "segmented_log.h"
+#include "time_series.h"
+
 class Instance : public std::enable_shared_from_this<Instance> {
+public:
+    // One-byte type tags. Instances carry a tag instead of a type name, and no variable name, since most of them are
+    // anonymous container elements; names are stored only in the keyspace.
+    enum Type : uint8_t { BOOLEAN, CHARACTER, INTEGER, FLOAT, STRING, VECTOR, SET, SORTED_SET, MULTISET, DICTIONARY,
+                          MULTIDICTIONARY, PRIORITY_QUEUE, STREAM, BITMAP, TIME_SERIES, HYPERLOGLOG, BLOOM_FILTER,
+                          COUNT_MIN_SKETCH };
 protected:
     // Attributes:
-    std::string _type;
-    std::string _name;
+    Type _type;
     
     // Constructor:
-    Instance(const std::string& type);
+    Instance(Type type);
 public:
     // Virtual destructor:
     virtual ~Instance();
 
     // Getter methods:
+    Type type_tag() const;
     std::string type() const;
-    std::string name() const;
 
     // Pure virtual methods:
     virtual std::string representation() const = 0;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments) = 0;
+
+    // Number of bytes used by the instance and by the elements, strings and nodes it owns. Containers keep a running
+    // count of the bytes of their elements as they are added and removed, so that it takes constant time.
+    virtual size_t memory_usage() const = 0;
 };
 
 class InstanceIsEqualToComparator {
@@ -93,6 +114,8 @@ private:
     std::string op_set(const std::vector<std::string>& arguments);
     std::string op_isTrue(const std::vector<std::string>& arguments);
     std::string op_isFalse(const std::vector<std::string>& arguments);
+    std::string op_getAndSet(const std::vector<std::string>& arguments);
+    std::string op_compareAndSet_to(const std::vector<std::string>& arguments);
 public:
     // Constructors:
     BooleanInstance(const std::string& value);
@@ -106,6 +129,7 @@ public:
 
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
@@ -126,6 +150,8 @@ private:
     std::string op_isLessThanOrEqualTo(const std::vector<std::string>& arguments);
     std::string op_isGreaterThan(const std::vector<std::string>& arguments);
     std::string op_isGreaterThanOrEqualTo(const std::vector<std::string>& arguments);
+    std::string op_getAndSet(const std::vector<std::string>& arguments);
+    std::string op_compareAndSet_to(const std::vector<std::string>& arguments);
 public:
     // Constructors:
     CharacterInstance(const std::string& value);
@@ -139,6 +165,7 @@ public:
 
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
@@ -159,6 +186,10 @@ private:
     std::string op_subtract(const std::vector<std::string>& arguments);
     std::string op_multiplyBy(const std::vector<std::string>& arguments);
     std::string op_divideBy(const std::vector<std::string>& arguments);
+    std::string op_addAndGet(const std::vector<std::string>& arguments);
+    std::string op_getAndAdd(const std::vector<std::string>& arguments);
+    std::string op_getAndSet(const std::vector<std::string>& arguments);
+    std::string op_compareAndSet_to(const std::vector<std::string>& arguments);
 public:
     // Constructors:
     IntegerInstance(int value);
@@ -173,6 +204,7 @@ public:
 
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
@@ -193,6 +225,10 @@ private:
     std::string op_subtract(const std::vector<std::string>& arguments);
     std::string op_multiplyBy(const std::vector<std::string>& arguments);
     std::string op_divideBy(const std::vector<std::string>& arguments);
+    std::string op_addAndGet(const std::vector<std::string>& arguments);
+    std::string op_getAndAdd(const std::vector<std::string>& arguments);
+    std::string op_getAndSet(const std::vector<std::string>& arguments);
+    std::string op_compareAndSet_to(const std::vector<std::string>& arguments);
 public:
     // Constructors:
     FloatInstance(float value);
@@ -205,15 +241,23 @@ public:
     // Getter method:
     float value() const;
 
+    // Representation with enough digits to be parsed back to the same value, regardless of the float precision.
+    std::string exact_representation() const;
+
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
 class StringInstance: public Instance {
 private:
-    // Attributes:
-    std::string _value;
+    // Attributes. An interned string points to its pooled value instead of owning one, so both share the same bytes.
+    bool _is_interned;
+    union {
+        std::string _value;
+        const std::string* _interned;
+    };
 
     // Operators:
     std::string op_get(const std::vector<std::string>& arguments);
@@ -242,6 +286,8 @@ private:
     std::string op_eraseFromIndex(const std::vector<std::string>& arguments);
     std::string op_eraseFromIndex_toIndex(const std::vector<std::string>& arguments);
     std::string op_clear(const std::vector<std::string>& arguments);
+    std::string op_getAndSet(const std::vector<std::string>& arguments);
+    std::string op_compareAndSet_to(const std::vector<std::string>& arguments);
 public:
     // Constructors:
     StringInstance(const std::string& value);
@@ -253,8 +299,16 @@ public:
     // Getter method:
     std::string value() const;
 
+    // Move the value into the interning pool. Only strings that never receive messages, such as container elements,
+    // may be interned.
+    void intern();
+
+    // Check whether both strings are interned to the same pooled value.
+    bool shares_value_with(const StringInstance& other) const;
+
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
@@ -263,6 +317,9 @@ private:
     // Attributes:
     std::string _element_type;
     std::vector<std::shared_ptr<Instance>> _value;
+    size_t _elements_memory_usage;
+    Listpack _packed;
+    bool _is_packed;
 
     // Operators:
     std::string op_get(const std::vector<std::string>& arguments);
@@ -279,7 +336,9 @@ private:
     std::string op_last(const std::vector<std::string>& arguments);
     std::string op_sliceFromIndex(const std::vector<std::string>& arguments);
     std::string op_sliceFromIndex_toIndex(const std::vector<std::string>& arguments);
+    std::string op_getFrom_count(const std::vector<std::string>& arguments);
     std::string op_pushBack(const std::vector<std::string>& arguments);
+    std::string op_pushBackAll(const std::vector<std::string>& arguments);
     std::string op_pushFront(const std::vector<std::string>& arguments);
     std::string op_popBack(const std::vector<std::string>& arguments);
     std::string op_popFront(const std::vector<std::string>& arguments);
@@ -296,6 +355,20 @@ private:
     std::string op_sort(const std::vector<std::string>& arguments);
     std::string op_reverse(const std::vector<std::string>& arguments);
     std::string op_clear(const std::vector<std::string>& arguments);
+
+    // Dispatch the message to its operator.
+    std::string dispatch(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Answer the message from the packed elements, without expanding them, if it only reads them or if it is a common
+    // write that leaves them packable. Return whether the message was answered.
+    bool dispatch_packed(const std::string& message_name, const std::vector<std::string>& arguments,
+                         std::string& output);
+
+    // Expand the packed elements into the full structure.
+    void unpack();
+
+    // Pack the elements if the full structure is small enough and all of its elements are packable.
+    void pack_if_small();
 public:
     // Constructor:
     VectorInstance(const std::string& element_type, const std::string& message_name,
@@ -306,6 +379,7 @@ public:
 
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
@@ -314,15 +388,81 @@ private:
     // Attributes:
     std::string _element_type;
     std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> _value;
+    size_t _elements_memory_usage;
+    Listpack _packed;
+    bool _is_packed;
+    Intset _integers;
+    bool _is_intset;
 
     // Operators:
     std::string op_get(const std::vector<std::string>& arguments);
     std::string op_isEmpty(const std::vector<std::string>& arguments);
     std::string op_contains(const std::vector<std::string>& arguments);
     std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_scanFirst(const std::vector<std::string>& arguments);
+    std::string op_scanFrom_count(const std::vector<std::string>& arguments);
     std::string op_add(const std::vector<std::string>& arguments);
+    std::string op_addAll(const std::vector<std::string>& arguments);
     std::string op_remove(const std::vector<std::string>& arguments);
     std::string op_clear(const std::vector<std::string>& arguments);
+    std::string op_unionWith(const std::vector<std::string>& arguments);
+    std::string op_intersectWith(const std::vector<std::string>& arguments);
+    std::string op_differenceWith(const std::vector<std::string>& arguments);
+    std::string op_storeUnionOf_and(const std::vector<std::string>& arguments);
+    std::string op_storeIntersectionOf_and(const std::vector<std::string>& arguments);
+    std::string op_storeDifferenceOf_and(const std::vector<std::string>& arguments);
+
+    // Elements of the set stored in the variable with the given name, or throw an exception if it is not a Set of the
+    // same element type. If the set is packed, its elements are expanded into buffer.
+    const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& set_of_variable(
+        const std::string& variable, std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& buffer) const;
+
+    // Check whether probing a set of size large once for each element of a set of size small is cheaper than merging
+    // both sets.
+    static bool prefers_lookups(int small, int large);
+
+    // Page of at most count elements starting at it, followed by the element where the next page starts or null.
+    std::string scan(std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>::const_iterator it,
+                     int count) const;
+
+    // Union, intersection and difference of first and second:
+    static std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> union_of(
+        const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& first,
+        const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& second);
+    static std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> intersection_of(
+        const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& first,
+        const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& second);
+    static std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator> difference_of(
+        const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& first,
+        const std::set<std::shared_ptr<Instance>, InstanceIsLessThanComparator>& second);
+
+    // Dispatch the message to its operator.
+    std::string dispatch(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Answer the message from the packed elements, without expanding them, if it only reads them or if it is a common
+    // write that leaves them packable. Return whether the message was answered.
+    bool dispatch_packed(const std::string& message_name, const std::vector<std::string>& arguments,
+                         std::string& output);
+
+    // Expand the packed elements into the full structure.
+    void unpack();
+
+    // Pack the elements if the full structure is small enough and all of its elements are packable.
+    void pack_if_small();
+
+    // Dispatch the message to its operator on the integer set, upgrading it to the full structure if the integer set
+    // grows too large.
+    std::string dispatch_intset(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Move the integers into the full structure.
+    void upgrade_intset();
+
+    // Integer set stored in the variable with the given name or, if it is stored in the full structure, copy of its
+    // integers made in buffer. Throw an exception if it is not a Set of the same element type.
+    const Intset& intset_of_variable(const std::string& variable, Intset& buffer) const;
+
+    // Page of at most count integers starting at index, followed by the integer where the next page starts or null.
+    std::string scan_intset(int index, int count) const;
 public:
     // Constructor:
     SetInstance(const std::string& element_type, const std::string& message_name,
@@ -333,6 +473,74 @@ public:
 
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class SortedSetInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    OrderStatisticTree _value;
+    size_t _elements_memory_usage;
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_contains(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_add(const std::vector<std::string>& arguments);
+    std::string op_addAll(const std::vector<std::string>& arguments);
+    std::string op_remove(const std::vector<std::string>& arguments);
+    std::string op_rankOf(const std::vector<std::string>& arguments);
+    std::string op_atRank(const std::vector<std::string>& arguments);
+    std::string op_rangeFromRank_toRank(const std::vector<std::string>& arguments);
+    std::string op_countBetween_and(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    SortedSetInstance(const std::string& element_type, const std::string& message_name,
+                      const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~SortedSetInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class MultisetInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    std::map<std::shared_ptr<Instance>, int, InstanceIsLessThanComparator> _value;
+    size_t _elements_memory_usage;
+    int _size;
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_contains(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_countOf(const std::vector<std::string>& arguments);
+    std::string op_add(const std::vector<std::string>& arguments);
+    std::string op_addAll(const std::vector<std::string>& arguments);
+    std::string op_remove(const std::vector<std::string>& arguments);
+    std::string op_removeAll(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    MultisetInstance(const std::string& element_type, const std::string& message_name,
+                     const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~MultisetInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
@@ -341,6 +549,9 @@ private:
     // Attributes:
     std::string _key_type, _value_type;
     std::map<std::shared_ptr<Instance>, std::shared_ptr<Instance>, InstanceIsLessThanComparator> _value;
+    size_t _elements_memory_usage;
+    Listpack _packed;
+    bool _is_packed;
 
     // Operators:
     std::string op_get(const std::vector<std::string>& arguments);
@@ -350,9 +561,39 @@ private:
     std::string op_keys(const std::vector<std::string>& arguments);
     std::string op_values(const std::vector<std::string>& arguments);
     std::string op_getValueForKey(const std::vector<std::string>& arguments);
+    std::string op_getValuesForKeys(const std::vector<std::string>& arguments);
+    std::string op_scanFirst(const std::vector<std::string>& arguments);
+    std::string op_scanFrom_count(const std::vector<std::string>& arguments);
     std::string op_associateValue_withKey(const std::vector<std::string>& arguments);
+    std::string op_associateValues_withKeys(const std::vector<std::string>& arguments);
     std::string op_removeKey(const std::vector<std::string>& arguments);
+    std::string op_incrementValueForKey_by(const std::vector<std::string>& arguments);
+    std::string op_decrementValueForKey_by(const std::vector<std::string>& arguments);
     std::string op_clear(const std::vector<std::string>& arguments);
+
+    // Send a numeric message to the value associated with a key, associating zero with the key if it is missing.
+    std::string update_value_for_key(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Associate value with key, replacing the value previously associated with it.
+    void associate(const std::shared_ptr<Instance>& key, const std::shared_ptr<Instance>& value);
+
+    // Page of at most count pairs starting at it, followed by the key where the next page starts or null.
+    std::string scan(std::map<std::shared_ptr<Instance>, std::shared_ptr<Instance>,
+                              InstanceIsLessThanComparator>::const_iterator it, int count) const;
+
+    // Dispatch the message to its operator.
+    std::string dispatch(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Answer the message from the packed elements, without expanding them, if it only reads them or if it is a common
+    // write that leaves them packable. Return whether the message was answered.
+    bool dispatch_packed(const std::string& message_name, const std::vector<std::string>& arguments,
+                         std::string& output);
+
+    // Expand the packed elements into the full structure.
+    void unpack();
+
+    // Pack the elements if the full structure is small enough and all of its elements are packable.
+    void pack_if_small();
 public:
     // Constructor:
     DictionaryInstance(const std::string& key_type, const std::string& value_type, const std::string& message_name,
@@ -363,6 +604,259 @@ public:
 
     // Implementation of pure virtual methods:
     virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class MultidictionaryInstance: public Instance {
+private:
+    // Attributes:
+    std::string _key_type, _value_type;
+    std::map<std::shared_ptr<Instance>, std::vector<std::shared_ptr<Instance>>, InstanceIsLessThanComparator> _value;
+    size_t _elements_memory_usage;
+    int _size;
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_containsKey(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_keys(const std::vector<std::string>& arguments);
+    std::string op_values(const std::vector<std::string>& arguments);
+    std::string op_getValuesForKey(const std::vector<std::string>& arguments);
+    std::string op_countValuesForKey(const std::vector<std::string>& arguments);
+    std::string op_associateValue_withKey(const std::vector<std::string>& arguments);
+    std::string op_removeValue_withKey(const std::vector<std::string>& arguments);
+    std::string op_removeKey(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    MultidictionaryInstance(const std::string& key_type, const std::string& value_type, const std::string& message_name,
+                            const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~MultidictionaryInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class PriorityQueueInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    PriorityHeap _value;
+    size_t _elements_memory_usage;
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_push_withPriority(const std::vector<std::string>& arguments);
+    std::string op_peekMin(const std::vector<std::string>& arguments);
+    std::string op_popMin(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    PriorityQueueInstance(const std::string& element_type, const std::string& message_name,
+                          const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~PriorityQueueInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class StreamInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    SegmentedLog _value;
+    size_t _elements_memory_usage;
+    std::map<std::string, int> _offsets;
+
+    // Representation of entries as (id,element) pairs.
+    static std::string entries_representation(const std::vector<std::pair<int, std::shared_ptr<Instance>>>& entries);
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_firstId(const std::vector<std::string>& arguments);
+    std::string op_lastId(const std::vector<std::string>& arguments);
+    std::string op_append(const std::vector<std::string>& arguments);
+    std::string op_readFrom_count(const std::vector<std::string>& arguments);
+    std::string op_readNext_forConsumer(const std::vector<std::string>& arguments);
+    std::string op_offsetOf(const std::vector<std::string>& arguments);
+    std::string op_setOffset_forConsumer(const std::vector<std::string>& arguments);
+    std::string op_trimBefore(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    StreamInstance(const std::string& element_type, const std::string& message_name,
+                   const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~StreamInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class BitmapInstance: public Instance {
+private:
+    // Attributes:
+    Bitmap _value;
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_getBit(const std::vector<std::string>& arguments);
+    std::string op_setBit(const std::vector<std::string>& arguments);
+    std::string op_clearBit(const std::vector<std::string>& arguments);
+    std::string op_countOnes(const std::vector<std::string>& arguments);
+    std::string op_countOnesFrom_to(const std::vector<std::string>& arguments);
+    std::string op_firstSet(const std::vector<std::string>& arguments);
+    std::string op_andWith(const std::vector<std::string>& arguments);
+    std::string op_orWith(const std::vector<std::string>& arguments);
+    std::string op_xorWith(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+
+    // Bitmap stored in the variable with the given name, or throw an exception if it is not a bitmap.
+    static const Bitmap& bitmap_of_variable(const std::string& variable);
+public:
+    // Constructor:
+    BitmapInstance(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~BitmapInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class TimeSeriesInstance: public Instance {
+private:
+    // Attributes:
+    TimeSeries _value;
+
+    // Representation of samples as (timestamp,value) pairs.
+    template <typename T>
+    static std::string samples_representation(const std::vector<std::pair<int64_t, T>>& samples);
+
+    // Timestamp represented by str.
+    static int64_t timestamp_of(const std::string& str);
+
+    // Operators:
+    std::string op_get(const std::vector<std::string>& arguments);
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_append_at(const std::vector<std::string>& arguments);
+    std::string op_rangeFrom_to(const std::vector<std::string>& arguments);
+    std::string op_avgFrom_to_bucket(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    TimeSeriesInstance(const std::string& message_name, const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~TimeSeriesInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class HyperLogLogInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    HyperLogLog _value;
+
+    // Operators:
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_add(const std::vector<std::string>& arguments);
+    std::string op_estimate(const std::vector<std::string>& arguments);
+    std::string op_mergeWith(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+
+    // Estimator stored in the variable with the given name, or throw an exception if it is not a HyperLogLog of the
+    // same element type.
+    const HyperLogLog& hyperloglog_of_variable(const std::string& variable) const;
+public:
+    // Constructor:
+    HyperLogLogInstance(const std::string& element_type, const std::string& message_name,
+                        const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~HyperLogLogInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class BloomFilterInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    BloomFilter _value;
+
+    // Operators:
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_size(const std::vector<std::string>& arguments);
+    std::string op_add(const std::vector<std::string>& arguments);
+    std::string op_mightContain(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    BloomFilterInstance(const std::string& element_type, const std::string& message_name,
+                        const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~BloomFilterInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
+    virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
+};
+
+class CountMinSketchInstance: public Instance {
+private:
+    // Attributes:
+    std::string _element_type;
+    CountMinSketch _value;
+
+    // Operators:
+    std::string op_isEmpty(const std::vector<std::string>& arguments);
+    std::string op_total(const std::vector<std::string>& arguments);
+    std::string op_increment_by(const std::vector<std::string>& arguments);
+    std::string op_estimate(const std::vector<std::string>& arguments);
+    std::string op_topK(const std::vector<std::string>& arguments);
+    std::string op_clear(const std::vector<std::string>& arguments);
+public:
+    // Constructor:
+    CountMinSketchInstance(const std::string& element_type, const std::string& message_name,
+                           const std::vector<std::string>& arguments);
+
+    // Virtual destructor:
+    virtual ~CountMinSketchInstance();
+
+    // Implementation of pure virtual methods:
+    virtual std::string representation() const;
+    virtual size_t memory_usage() const;
     virtual std::string receive(const std::string& message_name, const std::vector<std::string>& arguments);
 };
 
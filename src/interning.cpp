@@ -0,0 +1,77 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <mutex>
+#include <unordered_map>
+
+#include "interning.h"
+
+namespace {
+
+// Reference counts of the pooled strings, which are never destroyed, so that strings can be released during static
+// destruction. Keys are never moved by the map, so their addresses are handed out as the pooled strings.
+std::mutex pool_mutex;
+std::unordered_map<std::string, size_t>* pool = new std::unordered_map<std::string, size_t>();
+size_t pool_bytes = 0;
+
+// Bytes taken by the pooled string, its reference count and its node of the map.
+size_t bytes_of(const std::string& str) {
+    // Strings whose capacity is smaller than the string object are assumed to be stored inline.
+    size_t string_bytes = (str.capacity() < sizeof(std::string)) ? 0 : str.capacity() + 1;
+    return sizeof(std::pair<const std::string, size_t>) + sizeof(void*) + string_bytes;
+}
+
+}
+
+namespace interning {
+
+const std::string* intern(const std::string& str) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    auto it = pool->emplace(str, 0).first;
+    if (it->second++ == 0)
+        pool_bytes += bytes_of(it->first);
+    return &it->first;
+}
+
+void release(const std::string* str) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    auto it = pool->find(*str);
+    if (--it->second == 0) {
+        pool_bytes -= bytes_of(it->first);
+        pool->erase(it);
+    }
+}
+
+size_t size() {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return pool->size();
+}
+
+size_t bytes() {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return pool_bytes;
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_INTERNING_H
+#define KNUCKLEBALL_INTERNING_H
+
+#include <cstddef>
+#include <string>
+
+// Refcounted pool of immutable strings. Interning a string returns the copy already in the pool if there is one, so
+// that a value repeated across many container elements is stored once and equal interned strings can be compared by
+// pointer. Each pooled string is stored once, as the key of its reference count, and leaves the pool when its last
+// reference is released.
+namespace interning {
+
+// Return the pooled copy of the string, adding it to the pool if it is missing, and take a reference to it.
+const std::string* intern(const std::string& str);
+
+// Release a reference to the pooled string, removing it from the pool if it was the last one.
+void release(const std::string* str);
+
+// Return the number of distinct strings in the pool.
+size_t size();
+
+// Return the number of bytes taken by the pooled strings and their reference counts.
+size_t bytes();
+
+}
+
+#endif
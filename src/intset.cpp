@@ -0,0 +1,129 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "intset.h"
+
+// Definitions of the static constants:
+const int Intset::MAX_SIZE;
+
+Intset::Intset() {
+}
+
+bool Intset::prefers_searches(int small, int large) {
+    return small * std::log2(large + 1.0) < small + large;
+}
+
+bool Intset::contains(const std::vector<int>& values, int value) {
+    return std::binary_search(values.begin(), values.end(), value);
+}
+
+int Intset::size() const {
+    return int(_values.size());
+}
+
+const std::vector<int>& Intset::values() const {
+    return _values;
+}
+
+bool Intset::contains(int value) const {
+    return contains(_values, value);
+}
+
+int Intset::lower_bound(int value) const {
+    return int(std::lower_bound(_values.begin(), _values.end(), value) - _values.begin());
+}
+
+void Intset::insert(int value) {
+    auto it = std::lower_bound(_values.begin(), _values.end(), value);
+    if (it == _values.end() || *it != value)
+        _values.insert(it, value);
+}
+
+void Intset::insert(const std::vector<int>& values) {
+    std::vector<int> sorted_values(values);
+    std::sort(sorted_values.begin(), sorted_values.end());
+    sorted_values.erase(std::unique(sorted_values.begin(), sorted_values.end()), sorted_values.end());
+    std::vector<int> result;
+    result.reserve(_values.size() + sorted_values.size());
+    std::set_union(_values.begin(), _values.end(), sorted_values.begin(), sorted_values.end(),
+                   std::back_inserter(result));
+    _values.swap(result);
+}
+
+void Intset::erase(int value) {
+    auto it = std::lower_bound(_values.begin(), _values.end(), value);
+    if (it != _values.end() && *it == value)
+        _values.erase(it);
+}
+
+size_t Intset::memory_usage() const {
+    return _values.capacity() * sizeof(int);
+}
+
+void Intset::clear() {
+    std::vector<int>().swap(_values);
+}
+
+Intset Intset::union_of(const Intset& first, const Intset& second) {
+    Intset result;
+    result._values.reserve(first._values.size() + second._values.size());
+    std::set_union(first._values.begin(), first._values.end(), second._values.begin(), second._values.end(),
+                   std::back_inserter(result._values));
+    return result;
+}
+
+Intset Intset::intersection_of(const Intset& first, const Intset& second) {
+    const std::vector<int>& large = (first.size() >= second.size()) ? first._values : second._values;
+    const std::vector<int>& small = (first.size() >= second.size()) ? second._values : first._values;
+    Intset result;
+    result._values.reserve(small.size());
+    if (prefers_searches(int(small.size()), int(large.size()))) {
+        for (auto it = small.begin(); it != small.end(); it++)
+            if (contains(large, *it))
+                result._values.push_back(*it);
+    }
+    else
+        std::set_intersection(small.begin(), small.end(), large.begin(), large.end(),
+                              std::back_inserter(result._values));
+    return result;
+}
+
+Intset Intset::difference_of(const Intset& first, const Intset& second) {
+    Intset result;
+    result._values.reserve(first._values.size());
+    if (prefers_searches(int(first.size()), int(second.size()))) {
+        for (auto it = first._values.begin(); it != first._values.end(); it++)
+            if (!contains(second._values, *it))
+                result._values.push_back(*it);
+    }
+    else
+        std::set_difference(first._values.begin(), first._values.end(), second._values.begin(), second._values.end(),
+                            std::back_inserter(result._values));
+    return result;
+}
@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_INTSET_H
+#define KNUCKLEBALL_INTSET_H
+
+#include <vector>
+
+// Set of integers stored as a sorted array. Membership is a binary search and unions, intersections and differences
+// are merges of contiguous arrays, so a small set of integers costs four bytes per element instead of a node and an
+// instance per element.
+class Intset {
+public:
+    // Maximum number of integers before a set is upgraded to the full structure.
+    static const int MAX_SIZE = 512;
+private:
+    // Attributes:
+    std::vector<int> _values;
+
+    // Check whether searching an array of size large once for each element of an array of size small is cheaper than
+    // merging both arrays.
+    static bool prefers_searches(int small, int large);
+
+    // Check whether the sorted array contains the value.
+    static bool contains(const std::vector<int>& values, int value);
+public:
+    // Constructor:
+    Intset();
+
+    // Number of integers.
+    int size() const;
+
+    // Integers, in increasing order.
+    const std::vector<int>& values() const;
+
+    // Check whether the set contains the value.
+    bool contains(int value) const;
+
+    // Index of the first integer not less than the value.
+    int lower_bound(int value) const;
+
+    // Insert the value if it is missing.
+    void insert(int value);
+
+    // Insert the values that are missing.
+    void insert(const std::vector<int>& values);
+
+    // Erase the value if it is present.
+    void erase(int value);
+
+    // Number of bytes of the array.
+    size_t memory_usage() const;
+
+    // Erase all the integers and release the array.
+    void clear();
+
+    // Union, intersection and difference of first and second:
+    static Intset union_of(const Intset& first, const Intset& second);
+    static Intset intersection_of(const Intset& first, const Intset& second);
+    static Intset difference_of(const Intset& first, const Intset& second);
+};
+
+#endif
@@ -0,0 +1,347 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include "keyspace.h"
+#include "str_utils.h"
+
+// Definitions of the static constants:
+const int Keyspace::MIN_BUCKETS;
+const int Keyspace::EMPTY_VISITS_PER_BUCKET;
+const int Keyspace::BUCKET_VISITS_PER_SAMPLE;
+const int Keyspace::INITIAL_FREQUENCY;
+const int Keyspace::FREQUENCY_LOG_FACTOR;
+const int Keyspace::FREQUENCY_DECAY_ACCESSES;
+
+Keyspace::Entry::Entry(const std::string& name, const std::shared_ptr<Instance>& instance, int64_t last_access) :
+    name(name), instance(instance), last_access(last_access), frequency(INITIAL_FREQUENCY), memory_usage(0),
+    scope(nullptr), previous_in_scope(nullptr), next_in_scope(nullptr) {
+}
+
+Keyspace::Namespace::Namespace() : first(nullptr), memory_usage(0) {
+}
+
+Keyspace::Keyspace() : _size(0), _rehash_index(-1), _memory_usage(0), _clock(0), _seed(2463534242u) {
+    _tables[0].resize(MIN_BUCKETS);
+}
+
+unsigned int Keyspace::next_random() {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+int Keyspace::bucket_of(const std::string& name, int buckets) {
+    return int(str_utils::hash(name) & uint64_t(buckets - 1));
+}
+
+const Keyspace::Entry* Keyspace::locate(const std::string& name) const {
+    for (int table = 0; table < 2; table++) {
+        if (_tables[table].empty())
+            continue;
+        const Bucket& bucket = _tables[table][bucket_of(name, int(_tables[table].size()))];
+        for (auto it = bucket.begin(); it != bucket.end(); it++)
+            if (it->name == name)
+                return &*it;
+    }
+    return nullptr;
+}
+
+int Keyspace::decayed_frequency(const Entry& entry) const {
+    int64_t decay = (_clock - entry.last_access) / FREQUENCY_DECAY_ACCESSES;
+    return int(std::max(int64_t(entry.frequency) - decay, int64_t(0)));
+}
+
+void Keyspace::touch(Entry& entry) {
+    int frequency = decayed_frequency(entry);
+    if (frequency < 255) {
+        int factor = std::max(frequency - INITIAL_FREQUENCY, 0) * FREQUENCY_LOG_FACTOR + 1;
+        if (next_random() % factor == 0)
+            frequency++;
+    }
+    entry.frequency = uint8_t(frequency);
+    entry.last_access = ++_clock;
+}
+
+void Keyspace::start_rehashing(int buckets) {
+    _tables[1] = std::vector<Bucket>(buckets);
+    _rehash_index = 0;
+}
+
+void Keyspace::resize_if_needed() {
+    if (is_rehashing())
+        return;
+    int buckets = int(_tables[0].size());
+    if (_size >= buckets)
+        start_rehashing(buckets * 2);
+    else if (buckets > MIN_BUCKETS && _size * 10 < buckets) {
+        int new_buckets = MIN_BUCKETS;
+        while (new_buckets < _size)
+            new_buckets *= 2;
+        start_rehashing(new_buckets);
+    }
+}
+
+void Keyspace::erase_from_table(const std::string& name) {
+    for (int table = 0; table < 2; table++) {
+        if (_tables[table].empty())
+            continue;
+        Bucket& bucket = _tables[table][bucket_of(name, int(_tables[table].size()))];
+        for (auto previous = bucket.before_begin(), it = bucket.begin(); it != bucket.end(); previous = it++)
+            if (it->name == name) {
+                _size--;
+                _memory_usage -= it->memory_usage;
+                bucket.erase_after(previous);
+                return;
+            }
+    }
+}
+
+void Keyspace::unlink_from_scope(Entry& entry) {
+    Namespace* scope = entry.scope;
+    if (!scope)
+        return;
+    scope->memory_usage -= entry.memory_usage;
+    if (entry.previous_in_scope)
+        entry.previous_in_scope->next_in_scope = entry.next_in_scope;
+    else
+        scope->first = entry.next_in_scope;
+    if (entry.next_in_scope)
+        entry.next_in_scope->previous_in_scope = entry.previous_in_scope;
+    entry.scope = nullptr;
+    if (!scope->first)
+        _namespaces.erase(namespace_of(entry.name));
+}
+
+std::string Keyspace::namespace_of(const std::string& name) {
+    std::string::size_type separator = name.find("::");
+    return (separator != std::string::npos) ? name.substr(0, separator) : "";
+}
+
+int Keyspace::size() const {
+    return _size;
+}
+
+int Keyspace::buckets() const {
+    return int(_tables[0].size() + _tables[1].size());
+}
+
+float Keyspace::load_factor() const {
+    return float(_size) / _tables[is_rehashing() ? 1 : 0].size();
+}
+
+bool Keyspace::is_rehashing() const {
+    return _rehash_index >= 0;
+}
+
+float Keyspace::rehash_progress() const {
+    return is_rehashing() ? float(_rehash_index) / _tables[0].size() : 1;
+}
+
+bool Keyspace::rehash(int steps) {
+    if (!is_rehashing())
+        return false;
+    int empty_visits = steps * EMPTY_VISITS_PER_BUCKET;
+    while (steps > 0 && _rehash_index < int(_tables[0].size())) {
+        Bucket& bucket = _tables[0][_rehash_index++];
+        if (bucket.empty()) {
+            if (--empty_visits == 0)
+                break;
+            continue;
+        }
+        while (!bucket.empty()) {
+            Bucket& destination = _tables[1][bucket_of(bucket.front().name, int(_tables[1].size()))];
+            destination.splice_after(destination.before_begin(), bucket, bucket.before_begin());
+        }
+        steps--;
+    }
+    if (_rehash_index < int(_tables[0].size()))
+        return true;
+    _tables[0].swap(_tables[1]);
+    std::vector<Bucket>().swap(_tables[1]);
+    _rehash_index = -1;
+    resize_if_needed();
+    return is_rehashing();
+}
+
+std::shared_ptr<Instance> Keyspace::find(const std::string& name) {
+    Entry* entry = const_cast<Entry*>(locate(name));
+    if (!entry)
+        return nullptr;
+    touch(*entry);
+    return entry->instance;
+}
+
+bool Keyspace::insert(const std::string& name, const std::shared_ptr<Instance>& instance) {
+    if (locate(name))
+        return false;
+    std::vector<Bucket>& table = _tables[is_rehashing() ? 1 : 0];
+    Bucket& bucket = table[bucket_of(name, int(table.size()))];
+    bucket.push_front(Entry(name, instance, ++_clock));
+    _size++;
+    std::string namespace_name = namespace_of(name);
+    if (namespace_name != "") {
+        Entry& entry = bucket.front();
+        entry.scope = &_namespaces[namespace_name];
+        entry.next_in_scope = entry.scope->first;
+        if (entry.next_in_scope)
+            entry.next_in_scope->previous_in_scope = &entry;
+        entry.scope->first = &entry;
+    }
+    resize_if_needed();
+    return true;
+}
+
+bool Keyspace::erase(const std::string& name) {
+    Entry* entry = const_cast<Entry*>(locate(name));
+    if (!entry)
+        return false;
+    unlink_from_scope(*entry);
+    erase_from_table(name);
+    resize_if_needed();
+    return true;
+}
+
+void Keyspace::erase_namespace(const std::string& namespace_name) {
+    auto it = _namespaces.find(namespace_name);
+    if (it == _namespaces.end())
+        return;
+    for (Entry* entry = it->second.first; entry; ) {
+        Entry* next = entry->next_in_scope;
+        erase_from_table(entry->name);
+        entry = next;
+    }
+    _namespaces.erase(it);
+    resize_if_needed();
+}
+
+std::vector<std::string> Keyspace::names() const {
+    std::vector<std::string> names;
+    names.reserve(_size);
+    for (int table = 0; table < 2; table++)
+        for (auto bucket = _tables[table].begin(); bucket != _tables[table].end(); bucket++)
+            for (auto it = bucket->begin(); it != bucket->end(); it++)
+                names.push_back(it->name);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::vector<std::string> Keyspace::namespaces() const {
+    std::vector<std::string> namespaces;
+    for (auto it = _namespaces.begin(); it != _namespaces.end(); it++)
+        namespaces.push_back(it->first);
+    return namespaces;
+}
+
+std::vector<std::string> Keyspace::names_of_namespace(const std::string& namespace_name) const {
+    std::vector<std::string> names;
+    auto it = _namespaces.find(namespace_name);
+    if (it == _namespaces.end())
+        return names;
+    for (const Entry* entry = it->second.first; entry; entry = entry->next_in_scope)
+        names.push_back(entry->name);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::vector<std::string> Keyspace::sample(int count, const std::string& namespace_name) {
+    std::vector<std::string> names;
+    if (_size == 0 || count <= 0 || (namespace_name != "" && _namespaces.count(namespace_name) == 0))
+        return names;
+    int size_of_old_table = int(_tables[0].size()), buckets = this->buckets();
+    int start = int(next_random() % unsigned(buckets)), visits = std::min(count * BUCKET_VISITS_PER_SAMPLE, buckets);
+    for (int i = 0; i < visits && int(names.size()) < count; i++) {
+        int index = (start + i) % buckets;
+        const Bucket& bucket = (index < size_of_old_table) ? _tables[0][index] : _tables[1][index - size_of_old_table];
+        for (auto it = bucket.begin(); it != bucket.end() && int(names.size()) < count; it++)
+            if (namespace_name == "" || namespace_of(it->name) == namespace_name)
+                names.push_back(it->name);
+    }
+    if (names.empty() && namespace_name != "")
+        for (const Entry* entry = _namespaces[namespace_name].first; entry && int(names.size()) < count;
+             entry = entry->next_in_scope)
+            names.push_back(entry->name);
+    return names;
+}
+
+int64_t Keyspace::idle_time(const std::string& name) const {
+    const Entry* entry = locate(name);
+    return (entry) ? _clock - entry->last_access : -1;
+}
+
+int Keyspace::frequency(const std::string& name) const {
+    const Entry* entry = locate(name);
+    return (entry) ? decayed_frequency(*entry) : -1;
+}
+
+void Keyspace::set_memory_usage(const std::string& name, int64_t memory_usage) {
+    Entry* entry = const_cast<Entry*>(locate(name));
+    if (!entry || entry->memory_usage == memory_usage)
+        return;
+    int64_t delta = memory_usage - entry->memory_usage;
+    entry->memory_usage = memory_usage;
+    _memory_usage += delta;
+    if (entry->scope)
+        entry->scope->memory_usage += delta;
+}
+
+int64_t Keyspace::memory_usage(const std::string& name) const {
+    const Entry* entry = locate(name);
+    return (entry) ? entry->memory_usage : -1;
+}
+
+int64_t Keyspace::memory_usage() const {
+    return _memory_usage;
+}
+
+std::vector<std::pair<std::string, int64_t>> Keyspace::memory_usage_by_namespace() const {
+    std::vector<std::pair<std::string, int64_t>> memory_usage_by_namespace;
+    for (auto it = _namespaces.begin(); it != _namespaces.end(); it++)
+        memory_usage_by_namespace.push_back(std::make_pair(it->first, it->second.memory_usage));
+    return memory_usage_by_namespace;
+}
+
+std::vector<std::pair<std::string, int64_t>> Keyspace::biggest(int count) const {
+    auto is_bigger = [](const std::pair<std::string, int64_t>& lhs, const std::pair<std::string, int64_t>& rhs) {
+        return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first);
+    };
+    std::vector<std::pair<std::string, int64_t>> biggest;
+    if (count <= 0)
+        return biggest;
+    for (int table = 0; table < 2; table++)
+        for (auto bucket = _tables[table].begin(); bucket != _tables[table].end(); bucket++)
+            for (auto it = bucket->begin(); it != bucket->end(); it++) {
+                biggest.push_back(std::make_pair(it->name, it->memory_usage));
+                std::push_heap(biggest.begin(), biggest.end(), is_bigger);
+                if (int(biggest.size()) > count) {
+                    std::pop_heap(biggest.begin(), biggest.end(), is_bigger);
+                    biggest.pop_back();
+                }
+            }
+    std::sort_heap(biggest.begin(), biggest.end(), is_bigger);
+    return biggest;
+}
@@ -0,0 +1,207 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_KEYSPACE_H
+#define KNUCKLEBALL_KEYSPACE_H
+
+#include <cstdint>
+#include <forward_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Instance;
+
+// Variables of a context, indexed by name in a chained hash table. Variables declared inside a namespace are also
+// linked through their entries in a list of the namespace, so that listing or deleting the variables of a namespace
+// costs time proportional to their number. The table is resized incrementally: while a resize is in progress, the old
+// and the new tables coexist and each call to rehash migrates a few buckets, so that no single operation has to move
+// the whole keyspace. Each variable also records when it was last accessed and a logarithmic counter of its accesses,
+// so that variables that are rarely used can be chosen to be evicted from samples of the keyspace, and the number of
+// bytes its instance reports using, which is summed by namespace and over the whole keyspace as it changes.
+class Keyspace {
+private:
+    // Number of buckets of the smallest table.
+    static const int MIN_BUCKETS = 4;
+
+    // Number of empty buckets that may be skipped for each bucket to be migrated.
+    static const int EMPTY_VISITS_PER_BUCKET = 10;
+
+    // Number of buckets that may be visited for each variable to be sampled.
+    static const int BUCKET_VISITS_PER_SAMPLE = 10;
+
+    // Access frequency of new variables, so that they are not evicted before they have a chance to be accessed.
+    static const int INITIAL_FREQUENCY = 5;
+
+    // The higher the factor, the more accesses are needed to increment the access frequency.
+    static const int FREQUENCY_LOG_FACTOR = 10;
+
+    // Number of accesses to the keyspace after which the access frequency of a variable that is not accessed decays.
+    static const int FREQUENCY_DECAY_ACCESSES = 1000;
+
+    struct Namespace;
+
+    // Variable, with the time of its last access, its access frequency, the number of bytes it uses, and its links in
+    // the list of its namespace, if it is declared inside one. Entries are never moved, as buckets are linked lists.
+    struct Entry {
+        std::string name;
+        std::shared_ptr<Instance> instance;
+        int64_t last_access;
+        uint8_t frequency;
+        int64_t memory_usage;
+        Namespace* scope;
+        Entry* previous_in_scope;
+        Entry* next_in_scope;
+
+        Entry(const std::string& name, const std::shared_ptr<Instance>& instance, int64_t last_access);
+    };
+
+    // Namespace with at least one variable, with the first entry of its list and the number of bytes its variables use.
+    struct Namespace {
+        Entry* first;
+        int64_t memory_usage;
+
+        Namespace();
+    };
+
+    // Variables that hash to the same bucket.
+    typedef std::forward_list<Entry> Bucket;
+
+    // Attributes:
+    std::vector<Bucket> _tables[2];
+    int _size, _rehash_index;
+    std::map<std::string, Namespace> _namespaces;
+    int64_t _memory_usage;
+    int64_t _clock;
+    unsigned int _seed;
+
+    // Return the next pseudo-random number.
+    unsigned int next_random();
+
+    // Index of the bucket of a table with the given number of buckets where the variable belongs.
+    static int bucket_of(const std::string& name, int buckets);
+
+    // Entry of the variable with the given name, or a null pointer if it does not exist.
+    const Entry* locate(const std::string& name) const;
+
+    // Access frequency of the entry, decayed by the number of accesses to the keyspace since its last access.
+    int decayed_frequency(const Entry& entry) const;
+
+    // Record an access to the entry.
+    void touch(Entry& entry);
+
+    // Start migrating the variables to a new table with the given number of buckets.
+    void start_rehashing(int buckets);
+
+    // Erase the variable with the given name from the table, but not from the list of its namespace.
+    void erase_from_table(const std::string& name);
+
+    // Unlink the entry from the list of its namespace, and erase the namespace if it has no other variable.
+    void unlink_from_scope(Entry& entry);
+
+    // Start a resize if the load factor of the table is too high or too low and no resize is in progress.
+    void resize_if_needed();
+
+    // Delete copy constructor and assignment operator:
+    Keyspace(const Keyspace& other) = delete;
+    Keyspace& operator=(const Keyspace& other) = delete;
+public:
+    // Constructor:
+    Keyspace();
+
+    // Namespace of the variable with the given name, or an empty string if it is not declared inside a namespace.
+    static std::string namespace_of(const std::string& name);
+
+    // Number of variables.
+    int size() const;
+
+    // Number of buckets of the table, including the new table while a resize is in progress.
+    int buckets() const;
+
+    // Number of variables per bucket of the table that receives new variables.
+    float load_factor() const;
+
+    // Check whether a resize is in progress.
+    bool is_rehashing() const;
+
+    // Fraction of the buckets of the old table already migrated, or 1 if no resize is in progress.
+    float rehash_progress() const;
+
+    // Migrate up to steps buckets of the old table and return whether the resize is still in progress.
+    bool rehash(int steps);
+
+    // Instance of the variable with the given name, or a null pointer if it does not exist. The access is recorded.
+    std::shared_ptr<Instance> find(const std::string& name);
+
+    // Insert a variable, provided that its name is not used, and return whether it was inserted.
+    bool insert(const std::string& name, const std::shared_ptr<Instance>& instance);
+
+    // Erase the variable with the given name and return whether it existed.
+    bool erase(const std::string& name);
+
+    // Erase the variables declared inside the namespace.
+    void erase_namespace(const std::string& namespace_name);
+
+    // Names of all the variables, in ascending order.
+    std::vector<std::string> names() const;
+
+    // Namespaces with at least one variable, in ascending order.
+    std::vector<std::string> namespaces() const;
+
+    // Names of the variables declared inside the namespace, in ascending order.
+    std::vector<std::string> names_of_namespace(const std::string& namespace_name) const;
+
+    // Names of up to count variables from consecutive buckets, starting at a random bucket. If a namespace is given,
+    // only its variables are sampled.
+    std::vector<std::string> sample(int count, const std::string& namespace_name="");
+
+    // Number of accesses to the keyspace since the last access to the variable with the given name, or -1 if it does
+    // not exist.
+    int64_t idle_time(const std::string& name) const;
+
+    // Logarithmic counter of the accesses to the variable with the given name, or -1 if it does not exist.
+    int frequency(const std::string& name) const;
+
+    // Set the number of bytes used by the variable with the given name, if it exists.
+    void set_memory_usage(const std::string& name, int64_t memory_usage);
+
+    // Number of bytes used by the variable with the given name, or -1 if it does not exist.
+    int64_t memory_usage(const std::string& name) const;
+
+    // Number of bytes used by all the variables.
+    int64_t memory_usage() const;
+
+    // Namespaces with at least one variable and the number of bytes used by their variables, in ascending order of
+    // namespaces.
+    std::vector<std::pair<std::string, int64_t>> memory_usage_by_namespace() const;
+
+    // Names of up to count variables that use the most bytes and the number of bytes they use, in descending order of
+    // bytes.
+    std::vector<std::pair<std::string, int64_t>> biggest(int count) const;
+};
+
+#endif
@@ -49,7 +49,14 @@ int main(int argc, char* argv[]) {
         ("floatprecision", boost::program_options::value<int>()->default_value(3),
          "decimal precision to be used to format floating-point values")
         ("floatcomparisontolerance", boost::program_options::value<float>()->default_value(0.0000001),
-         "tolerance to be used to compare floating-point values");
+         "tolerance to be used to compare floating-point values")
+        ("maxmemory", boost::program_options::value<size_t>()->default_value(0),
+         "maximum number of bytes to be used by the variables, or 0 for no limit")
+        ("maxmemorypolicy", boost::program_options::value<std::string>()->default_value("lru"),
+         "policy to choose the variables to be evicted when the memory limit is exceeded: lru, lfu or ttl")
+        ("maxmemorynamespace", boost::program_options::value<std::string>()->default_value(""),
+         "namespace whose variables may be evicted, or all variables if empty")
+        ("internstrings", "store each distinct string of the containers once");
     boost::program_options::variables_map vmap;
     try {
         boost::program_options::store(boost::program_options::parse_command_line(argc, argv, description), vmap);
@@ -58,6 +65,10 @@ int main(int argc, char* argv[]) {
             return EXIT_SUCCESS;
         }
         boost::program_options::notify(vmap);
+        std::string policy = vmap["maxmemorypolicy"].as<std::string>();
+        if (policy != "lru" && policy != "lfu" && policy != "ttl")
+            throw boost::program_options::validation_error(
+                    boost::program_options::validation_error::invalid_option_value, "maxmemorypolicy", policy);
     }
     catch(std::exception& exception) {
         std::cerr << exception.what() << std::endl;
@@ -69,6 +80,9 @@ int main(int argc, char* argv[]) {
     std::cout << std::endl;
     Context::get_instance(vmap["logfile"].as<std::string>(), vmap["floatprecision"].as<int>(),
                           vmap["floatcomparisontolerance"].as<float>(), vmap.count("quiet") > 0 ? true : false);
+    Context::get_instance()->set_max_memory(vmap["maxmemory"].as<size_t>(), vmap["maxmemorypolicy"].as<std::string>(),
+                                            vmap["maxmemorynamespace"].as<std::string>());
+    Context::get_instance()->set_interning_strings(vmap.count("internstrings") > 0);
     Server::get_instance(vmap["bind"].as<std::string>(), vmap["port"].as<int>(),
                          vmap["password"].as<std::string>())->run();
     return EXIT_FAILURE;
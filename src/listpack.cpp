@@ -0,0 +1,326 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstring>
+
+#include "context.h"
+#include "exceptions.h"
+#include "instance.h"
+#include "listpack.h"
+#include "pool.h"
+#include "str_utils.h"
+
+// Definitions of the static constants:
+const int Listpack::MAX_SIZE;
+const int Listpack::MAX_STRING_SIZE;
+
+Listpack::Listpack() : _size(0) {
+}
+
+void Listpack::append_varint(std::string& bytes, uint32_t value) {
+    while (value >= 0x80) {
+        bytes += char((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes += char(value);
+}
+
+std::string Listpack::encoding_of(const Instance& instance) {
+    std::string bytes;
+    Instance::Type type = instance.type_tag();
+    if (type == Instance::BOOLEAN) {
+        bytes += 'b';
+        bytes += char(static_cast<const BooleanInstance&>(instance).value());
+    }
+    else if (type == Instance::CHARACTER) {
+        bytes += 'c';
+        bytes += static_cast<const CharacterInstance&>(instance).value();
+    }
+    else if (type == Instance::INTEGER) {
+        int32_t value = static_cast<const IntegerInstance&>(instance).value();
+        bytes += 'i';
+        append_varint(bytes, (uint32_t(value) << 1) ^ uint32_t(value >> 31));
+    }
+    else if (type == Instance::FLOAT) {
+        float value = static_cast<const FloatInstance&>(instance).value();
+        char value_bytes[sizeof(float)];
+        std::memcpy(value_bytes, &value, sizeof(float));
+        bytes += 'f';
+        bytes.append(value_bytes, sizeof(float));
+    }
+    else {
+        std::string value = static_cast<const StringInstance&>(instance).value();
+        bytes += 's';
+        append_varint(bytes, uint32_t(value.size()));
+        bytes += value;
+    }
+    return bytes;
+}
+
+uint32_t Listpack::read_varint(int& position) const {
+    uint32_t value = 0;
+    for (int shift = 0; ; shift += 7) {
+        uint8_t byte = uint8_t(_bytes[position++]);
+        value |= uint32_t(byte & 0x7F) << shift;
+        if (byte < 0x80)
+            return value;
+    }
+}
+
+int Listpack::read_integer(int& position) const {
+    uint32_t zigzag = read_varint(position);
+    return int(int32_t((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+}
+
+float Listpack::read_float(int& position) const {
+    float value;
+    std::memcpy(&value, _bytes.data() + position, sizeof(float));
+    position += int(sizeof(float));
+    return value;
+}
+
+void Listpack::skip(int& position) const {
+    char tag = _bytes[position++];
+    if (tag == 'b' || tag == 'c')
+        position++;
+    else if (tag == 'i')
+        read_varint(position);
+    else if (tag == 'f')
+        position += int(sizeof(float));
+    else {
+        int size = int(read_varint(position));
+        position += size;
+    }
+}
+
+int Listpack::position_of(int index) const {
+    int position = 0;
+    for (int i = 0; i < index; i++)
+        skip(position);
+    return position;
+}
+
+std::string Listpack::representation_at_position(int& position) const {
+    char tag = _bytes[position++];
+    if (tag == 'b')
+        return (_bytes[position++]) ? "true" : "false";
+    if (tag == 'c')
+        return std::string("'") + _bytes[position++] + "'";
+    if (tag == 'i')
+        return IntegerInstance(read_integer(position)).representation();
+    if (tag == 'f')
+        return FloatInstance(read_float(position)).representation();
+    int size = int(read_varint(position));
+    position += size;
+    return "\"" + str_utils::escape(_bytes.substr(position - size, size), '"') + "\"";
+}
+
+int Listpack::compare_at_position(int& position, const Instance& instance, const std::string& string_value) const {
+    Instance::Type type = instance.type_tag();
+    char tag = _bytes[position++];
+    if (tag == 'b') {
+        bool value = _bytes[position++] != 0;
+        if (type == Instance::BOOLEAN) {
+            bool other = static_cast<const BooleanInstance&>(instance).value();
+            return (value < other) ? -1 : (other < value) ? 1 : 0;
+        }
+    }
+    else if (tag == 'c') {
+        char value = _bytes[position++];
+        if (type == Instance::CHARACTER) {
+            char other = static_cast<const CharacterInstance&>(instance).value();
+            return (value < other) ? -1 : (other < value) ? 1 : 0;
+        }
+    }
+    else if (tag == 'i' || tag == 'f') {
+        int integer_value = (tag == 'i') ? read_integer(position) : 0;
+        float value = (tag == 'i') ? float(integer_value) : read_float(position);
+        if (tag == 'i' && type == Instance::INTEGER) {
+            int other = static_cast<const IntegerInstance&>(instance).value();
+            return (integer_value < other) ? -1 : (other < integer_value) ? 1 : 0;
+        }
+        if (type == Instance::INTEGER || type == Instance::FLOAT) {
+            float eps = Context::get_instance()->get_float_comparison_tolerance();
+            float other = (type == Instance::INTEGER) ? float(static_cast<const IntegerInstance&>(instance).value()) :
+                                                        static_cast<const FloatInstance&>(instance).value();
+            return (value - other < -eps) ? -1 : (other - value < -eps) ? 1 : 0;
+        }
+    }
+    else {
+        int size = int(read_varint(position));
+        position += size;
+        if (type == Instance::STRING)
+            return _bytes.compare(position - size, size, string_value);
+    }
+    throw EXC_INVALID_COMPARISON;
+}
+
+bool Listpack::is_packable(const Instance& instance) {
+    Instance::Type type = instance.type_tag();
+    if (type == Instance::STRING) {
+        // A trailing backslash would escape the closing quote of the string literal rebuilt when unpacking.
+        std::string value = static_cast<const StringInstance&>(instance).value();
+        return int(value.size()) <= MAX_STRING_SIZE && (value.empty() || value.back() != '\\');
+    }
+    return type == Instance::BOOLEAN || type == Instance::CHARACTER || type == Instance::INTEGER ||
+           type == Instance::FLOAT;
+}
+
+int Listpack::size() const {
+    return _size;
+}
+
+int Listpack::bytes() const {
+    return int(_bytes.size());
+}
+
+void Listpack::push_back(const Instance& instance) {
+    _bytes += encoding_of(instance);
+    _size++;
+}
+
+std::vector<std::shared_ptr<Instance>> Listpack::instances() const {
+    std::vector<std::shared_ptr<Instance>> instances;
+    instances.reserve(_size);
+    int position = 0;
+    while (position < int(_bytes.size())) {
+        char tag = _bytes[position++];
+        if (tag == 'b') {
+            std::string value = (_bytes[position++]) ? "true" : "false";
+            instances.push_back(std::allocate_shared<BooleanInstance>(PoolAllocator<BooleanInstance>("Boolean"),
+                                                                      value));
+        }
+        else if (tag == 'c') {
+            std::string value = std::string("'") + _bytes[position++] + "'";
+            instances.push_back(std::allocate_shared<CharacterInstance>(PoolAllocator<CharacterInstance>("Character"),
+                                                                        value));
+        }
+        else if (tag == 'i') {
+            int value = read_integer(position);
+            instances.push_back(std::allocate_shared<IntegerInstance>(PoolAllocator<IntegerInstance>("Integer"),
+                                                                      value));
+        }
+        else if (tag == 'f') {
+            float value = read_float(position);
+            instances.push_back(std::allocate_shared<FloatInstance>(PoolAllocator<FloatInstance>("Float"), value));
+        }
+        else {
+            int size = int(read_varint(position));
+            std::string value = "\"" + str_utils::escape(_bytes.substr(position, size), '"') + "\"";
+            position += size;
+            std::shared_ptr<StringInstance> instance =
+                std::allocate_shared<StringInstance>(PoolAllocator<StringInstance>("String"), value);
+            if (Context::get_instance()->is_interning_strings())
+                instance->intern();
+            instances.push_back(instance);
+        }
+    }
+    return instances;
+}
+
+std::vector<std::string> Listpack::representations() const {
+    std::vector<std::string> representations;
+    representations.reserve(_size);
+    int position = 0;
+    while (position < int(_bytes.size()))
+        representations.push_back(representation_at_position(position));
+    return representations;
+}
+
+std::string Listpack::representation_at(int index) const {
+    int position = position_of(index);
+    return representation_at_position(position);
+}
+
+int Listpack::index_of(const Instance& instance, int from_index, int step) const {
+    std::string string_value;
+    if (instance.type_tag() == Instance::STRING)
+        string_value = static_cast<const StringInstance&>(instance).value();
+    int position = 0;
+    for (int index = 0; index < _size; index++) {
+        if (index < from_index || (index - from_index) % step != 0)
+            skip(position);
+        else if (compare_at_position(position, instance, string_value) == 0)
+            return index;
+    }
+    return -1;
+}
+
+int Listpack::lower_bound(const Instance& instance, int step) const {
+    std::string string_value;
+    if (instance.type_tag() == Instance::STRING)
+        string_value = static_cast<const StringInstance&>(instance).value();
+    int position = 0;
+    for (int index = 0; index < _size; index++) {
+        if (index % step != 0)
+            skip(position);
+        else if (compare_at_position(position, instance, string_value) >= 0)
+            return index;
+    }
+    return _size;
+}
+
+bool Listpack::is_equal_at(int index, const Instance& instance) const {
+    std::string string_value;
+    if (instance.type_tag() == Instance::STRING)
+        string_value = static_cast<const StringInstance&>(instance).value();
+    int position = position_of(index);
+    return compare_at_position(position, instance, string_value) == 0;
+}
+
+int Listpack::integer_at(int index) const {
+    int position = position_of(index) + 1;
+    return read_integer(position);
+}
+
+float Listpack::float_at(int index) const {
+    int position = position_of(index) + 1;
+    return read_float(position);
+}
+
+void Listpack::insert(int index, const Instance& instance) {
+    _bytes.insert(position_of(index), encoding_of(instance));
+    _size++;
+}
+
+void Listpack::replace(int index, const Instance& instance) {
+    int position = position_of(index);
+    int end = position;
+    skip(end);
+    _bytes.replace(position, end - position, encoding_of(instance));
+}
+
+void Listpack::erase(int index) {
+    int position = position_of(index);
+    int end = position;
+    skip(end);
+    _bytes.erase(position, end - position);
+    _size--;
+}
+
+void Listpack::clear() {
+    std::string().swap(_bytes);
+    _size = 0;
+}
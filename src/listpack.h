@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_LISTPACK_H
+#define KNUCKLEBALL_LISTPACK_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Instance;
+
+// Packed sequence of scalars in a single contiguous buffer. Each scalar is stored inline as a one-byte tag followed by
+// its value: one byte for booleans and characters, a variable-length integer for integers, four bytes for floats, and
+// a variable-length size followed by the characters for strings. Small containers are kept packed, since a few bytes
+// per element cost far less than a node and an instance per element.
+class Listpack {
+public:
+    // Maximum number of scalars, and maximum size of a packed string.
+    static const int MAX_SIZE = 32;
+    static const int MAX_STRING_SIZE = 64;
+private:
+    // Attributes:
+    std::string _bytes;
+    int _size;
+
+    // Append an unsigned variable-length integer to bytes.
+    static void append_varint(std::string& bytes, uint32_t value);
+
+    // Tag and value of the instance, which must be packable.
+    static std::string encoding_of(const Instance& instance);
+
+    // Read an unsigned variable-length integer at position, and move position past it.
+    uint32_t read_varint(int& position) const;
+
+    // Read the value of an integer or float scalar at position, past its tag, and move position past it.
+    int read_integer(int& position) const;
+    float read_float(int& position) const;
+
+    // Move position past the scalar at position.
+    void skip(int& position) const;
+
+    // Position of the scalar at the index, or of the end of the buffer if the index is the size.
+    int position_of(int index) const;
+
+    // Representation of the scalar at position, and move position past it.
+    std::string representation_at_position(int& position) const;
+
+    // Compare the scalar at position with the instance, whose value as a string is given if it is a String, and move
+    // position past it. Return a negative number, zero or a positive number if the scalar is less than, equal to or
+    // greater than the instance, comparing them as their instances would be.
+    int compare_at_position(int& position, const Instance& instance, const std::string& string_value) const;
+public:
+    // Constructor:
+    Listpack();
+
+    // Check whether the instance is a scalar that can be packed.
+    static bool is_packable(const Instance& instance);
+
+    // Number of scalars.
+    int size() const;
+
+    // Number of bytes of the buffer.
+    int bytes() const;
+
+    // Append the value of the instance, which must be packable.
+    void push_back(const Instance& instance);
+
+    // Instances of the scalars, in order.
+    std::vector<std::shared_ptr<Instance>> instances() const;
+
+    // Representations of the scalars, in order, without creating their instances.
+    std::vector<std::string> representations() const;
+
+    // Representation of the scalar at the index, without creating its instance.
+    std::string representation_at(int index) const;
+
+    // Index of the first scalar equal to the instance among the scalars at from_index, from_index + step, and so on,
+    // or -1 if there is none.
+    int index_of(const Instance& instance, int from_index, int step) const;
+
+    // Index of the first scalar not less than the instance among the scalars at 0, step, 2 * step, and so on, which
+    // must be sorted, or the size if there is none.
+    int lower_bound(const Instance& instance, int step) const;
+
+    // Check whether the scalar at the index is equal to the instance.
+    bool is_equal_at(int index, const Instance& instance) const;
+
+    // Value of the integer or float scalar at the index.
+    int integer_at(int index) const;
+    float float_at(int index) const;
+
+    // Insert the value of the instance, which must be packable, before the index.
+    void insert(int index, const Instance& instance);
+
+    // Replace the scalar at the index with the value of the instance, which must be packable. Values of the same
+    // encoded size, such as most updated numbers, are overwritten in place.
+    void replace(int index, const Instance& instance);
+
+    // Erase the scalar at the index.
+    void erase(int index);
+
+    // Erase all the scalars and release the buffer.
+    void clear();
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <utility>
+
+#include "instance.h"
+#include "order_statistic_tree.h"
+
+OrderStatisticTree::Node::Node(const std::shared_ptr<Instance>& value, unsigned int priority) :
+    value(value), priority(priority), size(1) {
+}
+
+OrderStatisticTree::OrderStatisticTree() : _seed(2463534242u) {
+}
+
+unsigned int OrderStatisticTree::next_priority() {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+int OrderStatisticTree::size_of(const std::unique_ptr<Node>& node) {
+    return node ? node->size : 0;
+}
+
+void OrderStatisticTree::update(Node *node) {
+    node->size = size_of(node->left) + size_of(node->right) + 1;
+}
+
+void OrderStatisticTree::split(std::unique_ptr<Node> node, const std::shared_ptr<Instance>& value, bool or_equal,
+                               std::unique_ptr<Node>& left, std::unique_ptr<Node>& right) {
+    if (!node) {
+        left.reset();
+        right.reset();
+        return;
+    }
+    bool goes_left = or_equal ? !InstanceIsLessThanComparator()(value, node->value) :
+                                InstanceIsLessThanComparator()(node->value, value);
+    if (goes_left) {
+        std::unique_ptr<Node> subtree = std::move(node->right);
+        split(std::move(subtree), value, or_equal, node->right, right);
+        update(node.get());
+        left = std::move(node);
+    }
+    else {
+        std::unique_ptr<Node> subtree = std::move(node->left);
+        split(std::move(subtree), value, or_equal, left, node->left);
+        update(node.get());
+        right = std::move(node);
+    }
+}
+
+std::unique_ptr<OrderStatisticTree::Node> OrderStatisticTree::merge(std::unique_ptr<Node> left,
+                                                                    std::unique_ptr<Node> right) {
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+    if (left->priority > right->priority) {
+        left->right = merge(std::move(left->right), std::move(right));
+        update(left.get());
+        return left;
+    }
+    right->left = merge(std::move(left), std::move(right->left));
+    update(right.get());
+    return right;
+}
+
+void OrderStatisticTree::collect(const Node *node, int offset, int from_rank, int to_rank,
+                                 std::vector<std::shared_ptr<Instance>>& elements) {
+    if (node == nullptr || offset >= to_rank || offset + node->size <= from_rank)
+        return;
+    int rank = offset + size_of(node->left);
+    collect(node->left.get(), offset, from_rank, to_rank, elements);
+    if (rank >= from_rank && rank < to_rank)
+        elements.push_back(node->value);
+    collect(node->right.get(), rank + 1, from_rank, to_rank, elements);
+}
+
+int OrderStatisticTree::size() const {
+    return size_of(_root);
+}
+
+bool OrderStatisticTree::contains(const std::shared_ptr<Instance>& value) const {
+    return rank_of(value) != -1;
+}
+
+bool OrderStatisticTree::insert(const std::shared_ptr<Instance>& value) {
+    if (contains(value))
+        return false;
+    std::unique_ptr<Node> left, right;
+    split(std::move(_root), value, false, left, right);
+    std::unique_ptr<Node> node(new Node(value, next_priority()));
+    _root = merge(merge(std::move(left), std::move(node)), std::move(right));
+    return true;
+}
+
+bool OrderStatisticTree::erase(const std::shared_ptr<Instance>& value) {
+    std::unique_ptr<Node> left, middle, right;
+    split(std::move(_root), value, false, left, right);
+    split(std::move(right), value, true, middle, right);
+    _root = merge(std::move(left), std::move(right));
+    return middle != nullptr;
+}
+
+size_t OrderStatisticTree::memory_usage() const {
+    return size() * sizeof(Node);
+}
+
+void OrderStatisticTree::clear() {
+    _root.reset();
+}
+
+int OrderStatisticTree::rank_of(const std::shared_ptr<Instance>& value) const {
+    int rank = 0;
+    const Node *node = _root.get();
+    while (node != nullptr) {
+        if (InstanceIsLessThanComparator()(value, node->value))
+            node = node->left.get();
+        else if (InstanceIsLessThanComparator()(node->value, value)) {
+            rank += size_of(node->left) + 1;
+            node = node->right.get();
+        }
+        else
+            return rank + size_of(node->left);
+    }
+    return -1;
+}
+
+std::shared_ptr<Instance> OrderStatisticTree::at_rank(int rank) const {
+    if (rank < 0 || rank >= size())
+        return nullptr;
+    const Node *node = _root.get();
+    while (rank != size_of(node->left)) {
+        if (rank < size_of(node->left))
+            node = node->left.get();
+        else {
+            rank -= size_of(node->left) + 1;
+            node = node->right.get();
+        }
+    }
+    return node->value;
+}
+
+int OrderStatisticTree::count_less_than(const std::shared_ptr<Instance>& value) const {
+    int count = 0;
+    const Node *node = _root.get();
+    while (node != nullptr) {
+        if (InstanceIsLessThanComparator()(node->value, value)) {
+            count += size_of(node->left) + 1;
+            node = node->right.get();
+        }
+        else
+            node = node->left.get();
+    }
+    return count;
+}
+
+int OrderStatisticTree::count_less_than_or_equal_to(const std::shared_ptr<Instance>& value) const {
+    int count = 0;
+    const Node *node = _root.get();
+    while (node != nullptr) {
+        if (!InstanceIsLessThanComparator()(value, node->value)) {
+            count += size_of(node->left) + 1;
+            node = node->right.get();
+        }
+        else
+            node = node->left.get();
+    }
+    return count;
+}
+
+std::vector<std::shared_ptr<Instance>> OrderStatisticTree::range(int from_rank, int to_rank) const {
+    std::vector<std::shared_ptr<Instance>> elements;
+    collect(_root.get(), 0, from_rank, to_rank, elements);
+    return elements;
+}
@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_ORDER_STATISTIC_TREE_H
+#define KNUCKLEBALL_ORDER_STATISTIC_TREE_H
+
+#include <memory>
+#include <vector>
+
+class Instance;
+
+// Treap of unique Instances augmented with subtree sizes, so that rank queries run in O(log n) expected time.
+class OrderStatisticTree {
+private:
+    struct Node {
+        // Attributes:
+        std::shared_ptr<Instance> value;
+        unsigned int priority;
+        int size;
+        std::unique_ptr<Node> left, right;
+
+        // Constructor:
+        Node(const std::shared_ptr<Instance>& value, unsigned int priority);
+    };
+
+    // Attributes:
+    std::unique_ptr<Node> _root;
+    unsigned int _seed;
+
+    // Return the next pseudo-random node priority.
+    unsigned int next_priority();
+
+    // Return the size of the subtree rooted at node.
+    static int size_of(const std::unique_ptr<Node>& node);
+
+    // Recompute the size of node from its children.
+    static void update(Node *node);
+
+    // Split the tree into the nodes less than value and the remaining ones. If or_equal is set, nodes equal to value
+    // go to the left tree.
+    static void split(std::unique_ptr<Node> node, const std::shared_ptr<Instance>& value, bool or_equal,
+                      std::unique_ptr<Node>& left, std::unique_ptr<Node>& right);
+
+    // Merge two trees, provided that every node of left is less than every node of right.
+    static std::unique_ptr<Node> merge(std::unique_ptr<Node> left, std::unique_ptr<Node> right);
+
+    // Append to elements the nodes of the subtree whose ranks lie in [from_rank, to_rank).
+    static void collect(const Node *node, int offset, int from_rank, int to_rank,
+                        std::vector<std::shared_ptr<Instance>>& elements);
+
+    // Delete copy constructor and assignment operator:
+    OrderStatisticTree(const OrderStatisticTree& other) = delete;
+    OrderStatisticTree& operator=(const OrderStatisticTree& other) = delete;
+public:
+    // Constructor:
+    OrderStatisticTree();
+
+    // Number of elements.
+    int size() const;
+
+    // Check whether value is an element.
+    bool contains(const std::shared_ptr<Instance>& value) const;
+
+    // Insert value and return true, or return false if it is already an element.
+    bool insert(const std::shared_ptr<Instance>& value);
+
+    // Erase value and return true, or return false if it is not an element.
+    bool erase(const std::shared_ptr<Instance>& value);
+
+    // Number of bytes of the nodes, not including the elements they point to.
+    size_t memory_usage() const;
+
+    // Erase all the elements.
+    void clear();
+
+    // Zero-based rank of value, or -1 if it is not an element.
+    int rank_of(const std::shared_ptr<Instance>& value) const;
+
+    // Element with the given zero-based rank, or nullptr if rank is out of range.
+    std::shared_ptr<Instance> at_rank(int rank) const;
+
+    // Number of elements less than value.
+    int count_less_than(const std::shared_ptr<Instance>& value) const;
+
+    // Number of elements less than or equal to value.
+    int count_less_than_or_equal_to(const std::shared_ptr<Instance>& value) const;
+
+    // Elements whose ranks lie in [from_rank, to_rank), in ascending order.
+    std::vector<std::shared_ptr<Instance>> range(int from_rank, int to_rank) const;
+};
+
+#endif
@@ -49,6 +49,8 @@ Parser::Parser(const std::string& input) {
             while (str_utils::is_space(message[k]))
                 k++;
             j = k;
+            if (message[k] == '[')
+                k = str_utils::find_unquoted(message, ']', k);
             while (k < int(message.size()) &&
                   (!str_utils::is_space(message[k]) || !Grammar::is_keyword_message_argument(message.substr(j, k - j))))
                 k++;
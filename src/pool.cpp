@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "pool.h"
+
+// Definitions of the static constants:
+const int Pool::BLOCKS_PER_SLAB;
+
+namespace {
+
+// Registered pools, which are never destroyed, so that blocks can be returned during static destruction.
+std::vector<const Pool*>* registry = new std::vector<const Pool*>();
+
+// Smallest multiple of alignment not less than size.
+size_t round_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+}
+
+Pool::Pool(const std::string& name, size_t block_size) : _name(name),
+                                                         _block_size(std::max(block_size, sizeof(Block))),
+                                                         _header_size(round_up(sizeof(Slab), alignof(max_align_t))),
+                                                         _slab_alignment(1), _free_list(nullptr), _slabs(0),
+                                                         _empty_slabs(0), _used_blocks(0) {
+    while (_slab_alignment < _header_size + BLOCKS_PER_SLAB * _block_size)
+        _slab_alignment <<= 1;
+    registry->push_back(this);
+}
+
+std::string Pool::name() const {
+    return _name;
+}
+
+size_t Pool::block_size() const {
+    return _block_size;
+}
+
+size_t Pool::blocks() const {
+    return _slabs * BLOCKS_PER_SLAB;
+}
+
+size_t Pool::used_blocks() const {
+    return _used_blocks;
+}
+
+Pool::Slab* Pool::slab_of(void* block) const {
+    return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) & ~uintptr_t(_slab_alignment - 1));
+}
+
+void Pool::allocate_slab() {
+    void* memory;
+    if (posix_memalign(&memory, _slab_alignment, _header_size + BLOCKS_PER_SLAB * _block_size) != 0)
+        throw std::bad_alloc();
+    Slab* slab = static_cast<Slab*>(memory);
+    slab->used_blocks = 0;
+    slab->is_released = false;
+    char* blocks = static_cast<char*>(memory) + _header_size;
+    for (int i = BLOCKS_PER_SLAB - 1; i >= 0; i--) {
+        Block* block = reinterpret_cast<Block*>(blocks + i * _block_size);
+        block->next = _free_list;
+        _free_list = block;
+    }
+    _slabs++;
+    _empty_slabs++;
+}
+
+void Pool::release_empty_slabs() {
+    Slab* spare_slab = nullptr;
+    Slab* released_slabs = nullptr;
+    Block** link = &_free_list;
+    while (*link != nullptr) {
+        Slab* slab = slab_of(*link);
+        if (slab->used_blocks > 0 || slab == spare_slab) {
+            link = &(*link)->next;
+            continue;
+        }
+        if (spare_slab == nullptr) {
+            spare_slab = slab;
+            link = &(*link)->next;
+            continue;
+        }
+        if (!slab->is_released) {
+            slab->is_released = true;
+            slab->next_released = released_slabs;
+            released_slabs = slab;
+        }
+        *link = (*link)->next;
+    }
+    while (released_slabs != nullptr) {
+        Slab* slab = released_slabs;
+        released_slabs = slab->next_released;
+        free(slab);
+        _slabs--;
+        _empty_slabs--;
+    }
+}
+
+void* Pool::allocate() {
+    if (_free_list == nullptr)
+        allocate_slab();
+    Block* block = _free_list;
+    _free_list = block->next;
+    Slab* slab = slab_of(block);
+    if (slab->used_blocks++ == 0)
+        _empty_slabs--;
+    _used_blocks++;
+    return block;
+}
+
+void Pool::deallocate(void* pointer) {
+    Block* block = static_cast<Block*>(pointer);
+    block->next = _free_list;
+    _free_list = block;
+    _used_blocks--;
+    if (--slab_of(block)->used_blocks > 0)
+        return;
+
+    // sweeping the free list is linear in the free blocks, so it waits until empty slabs hold a large share of them:
+    _empty_slabs++;
+    if (_empty_slabs > 1 && 2 * _empty_slabs * BLOCKS_PER_SLAB >= blocks() - _used_blocks)
+        release_empty_slabs();
+}
+
+std::vector<const Pool*> Pool::pools() {
+    return *registry;
+}
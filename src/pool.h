@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_POOL_H
+#define KNUCKLEBALL_POOL_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Slab pool of fixed-size blocks. Free blocks of all the slabs are linked in a single free list, so that handing out
+// and taking back a block are constant-time, and objects of the same type are packed together instead of fragmenting
+// the heap. Slabs are aligned to a power of two at least as large as them and start with a header, so that the slab
+// of a block is found by masking its address. Empty slabs are released lazily, once they hold a large share of the free
+// blocks, except for one spare that absorbs allocation churn. Pools register themselves on creation, so that their
+// occupancy can be reported.
+class Pool {
+private:
+    // Free block, linked to the next free block of the pool.
+    struct Block {
+        Block* next;
+    };
+
+    // Header of a slab, with its number of blocks handed out.
+    struct Slab {
+        size_t used_blocks;
+        bool is_released;
+        Slab* next_released;
+    };
+
+    // Number of blocks of each slab.
+    static const int BLOCKS_PER_SLAB = 256;
+
+    // Attributes:
+    std::string _name;
+    size_t _block_size;
+    size_t _header_size;
+    size_t _slab_alignment;
+    Block* _free_list;
+    size_t _slabs;
+    size_t _empty_slabs;
+    size_t _used_blocks;
+
+    // Slab of the block.
+    Slab* slab_of(void* block) const;
+
+    // Allocate a slab and link its blocks in the free list.
+    void allocate_slab();
+
+    // Unlink the blocks of the empty slabs from the free list and release those slabs, except for one spare.
+    void release_empty_slabs();
+
+    // Delete copy constructor and assignment operator:
+    Pool(const Pool& other) = delete;
+    Pool& operator=(const Pool& other) = delete;
+public:
+    // Constructor:
+    Pool(const std::string& name, size_t block_size);
+
+    // Getter methods:
+    std::string name() const;
+    size_t block_size() const;
+
+    // Number of blocks of the slabs currently reserved, and number of blocks handed out.
+    size_t blocks() const;
+    size_t used_blocks() const;
+
+    // Hand out a block, or take it back.
+    void* allocate();
+    void deallocate(void* pointer);
+
+    // All the pools, in order of creation.
+    static std::vector<const Pool*> pools();
+};
+
+// Allocator of single objects of type T from a slab pool, to be used with std::allocate_shared. There is one pool for
+// each type of object, named after the first allocator that uses it. Arrays are allocated with operator new.
+template <typename T>
+class PoolAllocator {
+private:
+    // Attributes:
+    const char* _name;
+
+    // Pool of the blocks of type T.
+    Pool& pool() const {
+        static Pool* pool = new Pool(_name, sizeof(T));
+        return *pool;
+    }
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef PoolAllocator<U> other;
+    };
+
+    // Constructors:
+    explicit PoolAllocator(const char* name) : _name(name) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : _name(other.name()) {}
+
+    // Getter methods:
+    const char* name() const {
+        return _name;
+    }
+
+    T* allocate(size_t n) {
+        if (n != 1)
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(pool().allocate());
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        if (n != 1)
+            ::operator delete(pointer);
+        else
+            pool().deallocate(pointer);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include "priority_heap.h"
+
+// Definitions of the static constants:
+const int PriorityHeap::ARITY;
+
+PriorityHeap::PriorityHeap() : _next_sequence(0) {
+}
+
+bool PriorityHeap::precedes(const Entry& a, const Entry& b) {
+    if (a.priority != b.priority)
+        return a.priority < b.priority;
+    return a.sequence < b.sequence;
+}
+
+void PriorityHeap::sift_up(int index) {
+    Entry entry = std::move(_entries[index]);
+    while (index > 0) {
+        int parent = (index - 1) / ARITY;
+        if (!precedes(entry, _entries[parent]))
+            break;
+        _entries[index] = std::move(_entries[parent]);
+        index = parent;
+    }
+    _entries[index] = std::move(entry);
+}
+
+void PriorityHeap::sift_down(int index) {
+    int size = int(_entries.size());
+    Entry entry = std::move(_entries[index]);
+    while (true) {
+        int first_child = index * ARITY + 1;
+        if (first_child >= size)
+            break;
+        int best_child = first_child;
+        for (int child = first_child + 1; child < std::min(first_child + ARITY, size); child++)
+            if (precedes(_entries[child], _entries[best_child]))
+                best_child = child;
+        if (!precedes(_entries[best_child], entry))
+            break;
+        _entries[index] = std::move(_entries[best_child]);
+        index = best_child;
+    }
+    _entries[index] = std::move(entry);
+}
+
+int PriorityHeap::size() const {
+    return int(_entries.size());
+}
+
+bool PriorityHeap::empty() const {
+    return _entries.empty();
+}
+
+void PriorityHeap::push(const std::shared_ptr<Instance>& value, double priority) {
+    _entries.push_back(Entry{priority, _next_sequence++, value});
+    sift_up(int(_entries.size()) - 1);
+}
+
+std::shared_ptr<Instance> PriorityHeap::top() const {
+    return _entries.empty() ? nullptr : _entries[0].value;
+}
+
+double PriorityHeap::top_priority() const {
+    return _entries[0].priority;
+}
+
+std::shared_ptr<Instance> PriorityHeap::pop() {
+    if (_entries.empty())
+        return nullptr;
+    std::shared_ptr<Instance> value = std::move(_entries[0].value);
+    _entries[0] = std::move(_entries.back());
+    _entries.pop_back();
+    if (!_entries.empty())
+        sift_down(0);
+    if (_entries.empty())
+        _next_sequence = 0;
+    return value;
+}
+
+size_t PriorityHeap::memory_usage() const {
+    return _entries.capacity() * sizeof(Entry);
+}
+
+void PriorityHeap::clear() {
+    _entries.clear();
+    _next_sequence = 0;
+}
+
+std::vector<std::shared_ptr<Instance>> PriorityHeap::elements() const {
+    std::vector<Entry> entries(_entries);
+    std::sort(entries.begin(), entries.end(), precedes);
+    std::vector<std::shared_ptr<Instance>> elements;
+    for (auto it = entries.begin(); it != entries.end(); it++)
+        elements.push_back(it->value);
+    return elements;
+}
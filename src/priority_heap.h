@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_PRIORITY_HEAP_H
+#define KNUCKLEBALL_PRIORITY_HEAP_H
+
+#include <memory>
+#include <vector>
+
+class Instance;
+
+// Implicit 4-ary min-heap of Instances keyed by priority, stored contiguously so that push and pop run in O(log n)
+// with few cache misses. Elements with equal priorities are popped in insertion order.
+class PriorityHeap {
+private:
+    struct Entry {
+        // Attributes:
+        double priority;
+        unsigned long long sequence;
+        std::shared_ptr<Instance> value;
+    };
+
+    // Number of children of each node.
+    static const int ARITY = 4;
+
+    // Attributes:
+    std::vector<Entry> _entries;
+    unsigned long long _next_sequence;
+
+    // Check whether entry a must be popped before entry b.
+    static bool precedes(const Entry& a, const Entry& b);
+
+    // Move the entry at index up until its parent precedes it.
+    void sift_up(int index);
+
+    // Move the entry at index down until it precedes all of its children.
+    void sift_down(int index);
+public:
+    // Constructor:
+    PriorityHeap();
+
+    // Number of elements.
+    int size() const;
+
+    // Check whether there are no elements.
+    bool empty() const;
+
+    // Insert value with the given priority.
+    void push(const std::shared_ptr<Instance>& value, double priority);
+
+    // Element with the lowest priority, or nullptr if there are no elements.
+    std::shared_ptr<Instance> top() const;
+
+    // Priority of the element returned by top. Undefined if there are no elements.
+    double top_priority() const;
+
+    // Erase and return the element with the lowest priority, or nullptr if there are no elements.
+    std::shared_ptr<Instance> pop();
+
+    // Number of bytes of the entries, not including the elements they point to.
+    size_t memory_usage() const;
+
+    // Erase all the elements.
+    void clear();
+
+    // All the elements in the order they would be popped.
+    std::vector<std::shared_ptr<Instance>> elements() const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include "segmented_log.h"
+
+// Definitions of the static constants:
+const int SegmentedLog::SEGMENT_SIZE;
+
+SegmentedLog::SegmentedLog() : _first_segment(0), _first_id(0), _next_id(0) {
+}
+
+const std::shared_ptr<Instance>& SegmentedLog::at(int id) const {
+    return _segments[id / SEGMENT_SIZE - _first_segment][id % SEGMENT_SIZE];
+}
+
+int SegmentedLog::size() const {
+    return _next_id - _first_id;
+}
+
+bool SegmentedLog::empty() const {
+    return _next_id == _first_id;
+}
+
+int SegmentedLog::first_id() const {
+    return _first_id;
+}
+
+int SegmentedLog::next_id() const {
+    return _next_id;
+}
+
+int SegmentedLog::append(const std::shared_ptr<Instance>& value) {
+    if (_segments.empty() || int(_segments.back().size()) == SEGMENT_SIZE) {
+        if (_segments.empty())
+            _first_segment = _next_id / SEGMENT_SIZE;
+        _segments.push_back(std::vector<std::shared_ptr<Instance>>());
+        _segments.back().reserve(SEGMENT_SIZE);
+        // Entries are addressed by id, so a log emptied in the middle of a segment restarts at the same offset.
+        _segments.back().resize(_next_id % SEGMENT_SIZE);
+    }
+    _segments.back().push_back(value);
+    return _next_id++;
+}
+
+std::vector<std::pair<int, std::shared_ptr<Instance>>> SegmentedLog::read(int from_id, int count) const {
+    std::vector<std::pair<int, std::shared_ptr<Instance>>> entries;
+    from_id = std::max(from_id, _first_id);
+    int to_id = (count < _next_id - from_id) ? from_id + count : _next_id;
+    for (int id = from_id; id < to_id; id++)
+        entries.push_back(std::make_pair(id, at(id)));
+    return entries;
+}
+
+void SegmentedLog::trim_before(int id) {
+    id = std::min(id, _next_id);
+    if (id <= _first_id)
+        return;
+    while (!_segments.empty() && (_first_segment + 1) * SEGMENT_SIZE <= id) {
+        _segments.pop_front();
+        _first_segment++;
+    }
+    for (int i = std::max(_first_id, _first_segment * SEGMENT_SIZE); i < id; i++)
+        _segments.front()[i % SEGMENT_SIZE].reset();
+    _first_id = id;
+}
+
+size_t SegmentedLog::memory_usage() const {
+    return _segments.size() * (sizeof(std::vector<std::shared_ptr<Instance>>) +
+                               SEGMENT_SIZE * sizeof(std::shared_ptr<Instance>));
+}
+
+void SegmentedLog::clear() {
+    _segments.clear();
+    _first_id = _next_id;
+}
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_SEGMENTED_LOG_H
+#define KNUCKLEBALL_SEGMENTED_LOG_H
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Instance;
+
+// Append-only log of Instances identified by monotonically increasing ids. Entries are stored in fixed-size
+// contiguous segments, so appending never moves existing entries and trimming the head releases whole segments.
+class SegmentedLog {
+private:
+    // Number of entries per segment.
+    static const int SEGMENT_SIZE = 1024;
+
+    // Attributes:
+    std::deque<std::vector<std::shared_ptr<Instance>>> _segments;
+    int _first_segment, _first_id, _next_id;
+
+    // Entry with the given id, provided that it is stored.
+    const std::shared_ptr<Instance>& at(int id) const;
+
+    // Delete copy constructor and assignment operator:
+    SegmentedLog(const SegmentedLog& other) = delete;
+    SegmentedLog& operator=(const SegmentedLog& other) = delete;
+public:
+    // Constructor:
+    SegmentedLog();
+
+    // Number of stored entries.
+    int size() const;
+
+    // Check whether there are no stored entries.
+    bool empty() const;
+
+    // Id of the first stored entry, or of the next entry to be appended if there are no stored entries.
+    int first_id() const;
+
+    // Id of the next entry to be appended.
+    int next_id() const;
+
+    // Append value and return its id.
+    int append(const std::shared_ptr<Instance>& value);
+
+    // Up to count stored entries with ids greater than or equal to from_id, paired with their ids, in ascending order
+    // of ids.
+    std::vector<std::pair<int, std::shared_ptr<Instance>>> read(int from_id, int count) const;
+
+    // Erase the stored entries with ids less than id.
+    void trim_before(int id);
+
+    // Number of bytes of the segments, not including the entries they point to.
+    size_t memory_usage() const;
+
+    // Erase all the stored entries. Ids of entries appended later keep increasing.
+    void clear();
+};
+
+#endif
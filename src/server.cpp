@@ -38,6 +38,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Initialize the singleton instance.
 Server* Server::_instance = NULL;
 
+// Definitions of the static constants:
+const int Server::TICK_INTERVAL;
+const int Server::REHASH_TIME_PER_TICK;
+
 Server* Server::get_instance() {
     return _instance;
 }
@@ -52,7 +56,8 @@ Server::Server(const std::string& ip, int port, const std::string& password) :
     _password(password),
     _endpoint(boost::asio::ip::address::from_string(ip), port),
     _acceptor(_io_service, _endpoint),
-    _socket(_io_service) {
+    _socket(_io_service),
+    _timer(_io_service) {
 }
 
 Server::~Server() {
@@ -77,8 +82,22 @@ void Server::handle_accept() {
     do_accept();
 }
 
+void Server::do_tick() {
+    _timer.expires_from_now(boost::posix_time::milliseconds(TICK_INTERVAL));
+    _timer.async_wait(
+            [this](const boost::system::error_code& error_code) {
+                if (error_code)
+                    return;
+                Context::get_instance()->expire_variables();
+                Context::get_instance()->rehash_keyspace(REHASH_TIME_PER_TICK);
+                do_tick();
+            }
+    );
+}
+
 void Server::run() {
     do_accept();
+    do_tick();
     _io_service.run();
 }
 
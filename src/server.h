@@ -37,12 +37,17 @@ private:
     // Singleton instance:
     static Server *_instance;
 
+    // Interval between idle ticks, and time spent migrating keyspace buckets on each tick, in milliseconds.
+    static const int TICK_INTERVAL = 100;
+    static const int REHASH_TIME_PER_TICK = 1;
+
     // Attributes:
     std::string _password;
     boost::asio::io_service _io_service;
     boost::asio::ip::tcp::endpoint _endpoint;
     boost::asio::ip::tcp::acceptor _acceptor;
     boost::asio::ip::tcp::socket _socket;
+    boost::asio::deadline_timer _timer;
 
     // Constructor:
     Server(const std::string& ip, int port, const std::string& password);
@@ -51,6 +56,9 @@ private:
     void do_accept();
     void handle_accept();
 
+    // Asynchronously run background work at regular intervals.
+    void do_tick();
+
     // Delete copy constructor and assignment operator.
     Server(const Server& other) = delete;
     Server& operator=(const Server& other) = delete;
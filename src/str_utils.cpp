@@ -111,4 +111,42 @@ std::string remove_spaces(const std::string& str) {
     return str_without_spaces;
 }
 
+int find_unquoted(const std::string& str, char c, int from) {
+    for (int i = from; i < int(str.size()); i++) {
+        if (str[i] == c)
+            return i;
+        if (str[i] == '\'')
+            i += 2;
+        else if (str[i] == '"')
+            for (i++; i < int(str.size()) && str[i] != '"'; i++)
+                if (str[i] == '\\')
+                    i++;
+    }
+    return int(str.size());
+}
+
+std::vector<std::string> split_list(const std::string& str) {
+    std::vector<std::string> items;
+    int begin = 0, end = find_unquoted(str, ',', 0);
+    while (end < int(str.size())) {
+        items.push_back(str.substr(begin, end - begin));
+        begin = end + 1;
+        end = find_unquoted(str, ',', begin);
+    }
+    items.push_back(str.substr(begin));
+    return items;
+}
+
+uint64_t hash(const std::string& str) {
+    // FNV-1a, followed by the SplitMix64 finalizer so that every output bit depends on every input bit.
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < int(str.size()); i++) {
+        hash ^= uint64_t((unsigned char) str[i]);
+        hash *= 1099511628211ull;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+}
+
 }
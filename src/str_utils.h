@@ -26,7 +26,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef KNUCKLEBALL_STR_UTILS_H
 #define KNUCKLEBALL_STR_UTILS_H
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace str_utils {
 
@@ -66,6 +68,16 @@ bool ends_with(const std::string& str, const std::string& suffix);
 // Return the string with its spaces removed.
 std::string remove_spaces(const std::string& str);
 
+// Return the position of the first c at or after from that is outside string and character literals, or the size of
+// the string if there is none.
+int find_unquoted(const std::string& str, char c, int from);
+
+// Return the comma-separated items of the string, ignoring commas inside string and character literals.
+std::vector<std::string> split_list(const std::string& str);
+
+// Return a well-mixed 64-bit hash of the string.
+uint64_t hash(const std::string& str);
+
 }
 
 #endif
@@ -0,0 +1,239 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "time_series.h"
+
+// Definitions of the static constants:
+const int TimeSeries::SAMPLES_PER_BLOCK;
+
+// Bits of a float and the float with the given bits.
+static uint32_t float_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+TimeSeries::Decoder::Decoder(const Block& block) :
+    _block(block), _position(0), _index(0), _timestamp(0), _delta(0), _value(0), _leading(0), _trailing(0) {
+}
+
+uint64_t TimeSeries::Decoder::read(int count) {
+    int index = int(_position / 64), free = 64 - int(_position % 64);
+    uint64_t value;
+    if (count <= free)
+        value = _block.words[index] >> (free - count);
+    else
+        value = (_block.words[index] << (count - free)) | (_block.words[index + 1] >> (64 - (count - free)));
+    _position += count;
+    return (count < 64) ? value & ((uint64_t(1) << count) - 1) : value;
+}
+
+bool TimeSeries::Decoder::next(int64_t& timestamp, float& value) {
+    if (_index == _block.count)
+        return false;
+    if (_index == 0) {
+        _timestamp = read(64);
+        _value = uint32_t(read(32));
+    }
+    else {
+        int prefix = 0;
+        while (prefix < 4 && read(1) == 1)
+            prefix++;
+        static const int DELTA_OF_DELTA_BITS[] = {0, 7, 9, 12, 64};
+        uint64_t zigzag = (prefix == 0) ? 0 : read(DELTA_OF_DELTA_BITS[prefix]);
+        _delta += (zigzag >> 1) ^ (0 - (zigzag & 1));
+        _timestamp += _delta;
+        if (read(1) == 1) {
+            if (read(1) == 1) {
+                _leading = int(read(5));
+                _trailing = 32 - _leading - (int(read(5)) + 1);
+            }
+            _value ^= uint32_t(read(32 - _leading - _trailing)) << _trailing;
+        }
+    }
+    _index++;
+    timestamp = int64_t(_timestamp);
+    value = bits_float(_value);
+    return true;
+}
+
+TimeSeries::TimeSeries() : _sealed_bytes(0), _size(0), _last_delta(0), _last_value(0), _last_leading(0), _last_trailing(0) {
+}
+
+void TimeSeries::write(Block& block, uint64_t value, int count) {
+    if (count < 64)
+        value &= (uint64_t(1) << count) - 1;
+    int free = 64 - int(block.bits % 64);
+    if (free == 64)
+        block.words.push_back(0);
+    if (count <= free)
+        block.words.back() |= value << (free - count);
+    else {
+        block.words.back() |= value >> (count - free);
+        block.words.push_back(value << (64 - (count - free)));
+    }
+    block.bits += count;
+}
+
+int TimeSeries::first_block_from(int64_t timestamp) const {
+    return int(std::partition_point(_blocks.begin(), _blocks.end(), [timestamp](const Block& block) {
+        return block.last_timestamp < timestamp;
+    }) - _blocks.begin());
+}
+
+int TimeSeries::size() const {
+    return _size;
+}
+
+bool TimeSeries::empty() const {
+    return _size == 0;
+}
+
+bool TimeSeries::append(int64_t timestamp, float value) {
+    if (!_blocks.empty() && timestamp < _blocks.back().last_timestamp)
+        return false;
+    uint32_t bits = float_bits(value);
+    if (_blocks.empty() || _blocks.back().count == SAMPLES_PER_BLOCK) {
+        if (!_blocks.empty())
+            _sealed_bytes += _blocks.back().words.capacity() * sizeof(uint64_t);
+        _blocks.push_back(Block{timestamp, timestamp, 1, 0, std::vector<uint64_t>()});
+        write(_blocks.back(), uint64_t(timestamp), 64);
+        write(_blocks.back(), bits, 32);
+        _last_delta = 0;
+        _last_value = bits;
+        _last_leading = _last_trailing = 32;
+        _size++;
+        return true;
+    }
+    Block& block = _blocks.back();
+    uint64_t delta = uint64_t(timestamp) - uint64_t(block.last_timestamp);
+    uint64_t delta_of_delta = delta - _last_delta;
+    uint64_t zigzag = (delta_of_delta << 1) ^ (0 - (delta_of_delta >> 63));
+    if (zigzag == 0)
+        write(block, 0, 1);
+    else if (zigzag < (uint64_t(1) << 7)) {
+        write(block, 2, 2);
+        write(block, zigzag, 7);
+    }
+    else if (zigzag < (uint64_t(1) << 9)) {
+        write(block, 6, 3);
+        write(block, zigzag, 9);
+    }
+    else if (zigzag < (uint64_t(1) << 12)) {
+        write(block, 14, 4);
+        write(block, zigzag, 12);
+    }
+    else {
+        write(block, 15, 4);
+        write(block, zigzag, 64);
+    }
+    uint32_t xor_bits = bits ^ _last_value;
+    if (xor_bits == 0)
+        write(block, 0, 1);
+    else {
+        int leading = __builtin_clz(xor_bits), trailing = __builtin_ctz(xor_bits);
+        if (leading >= _last_leading && trailing >= _last_trailing) {
+            write(block, 2, 2);
+            write(block, xor_bits >> _last_trailing, 32 - _last_leading - _last_trailing);
+        }
+        else {
+            int length = 32 - leading - trailing;
+            write(block, 3, 2);
+            write(block, leading, 5);
+            write(block, length - 1, 5);
+            write(block, xor_bits >> trailing, length);
+            _last_leading = leading;
+            _last_trailing = trailing;
+        }
+    }
+    block.last_timestamp = timestamp;
+    block.count++;
+    _last_delta = delta;
+    _last_value = bits;
+    _size++;
+    return true;
+}
+
+std::vector<std::pair<int64_t, float>> TimeSeries::range(int64_t from, int64_t to) const {
+    std::vector<std::pair<int64_t, float>> samples;
+    for (int i = first_block_from(from); i < int(_blocks.size()) && _blocks[i].first_timestamp < to; i++) {
+        Decoder decoder(_blocks[i]);
+        int64_t timestamp;
+        float value;
+        while (decoder.next(timestamp, value) && timestamp < to)
+            if (timestamp >= from)
+                samples.push_back(std::make_pair(timestamp, value));
+    }
+    return samples;
+}
+
+std::vector<std::pair<int64_t, double>> TimeSeries::average(int64_t from, int64_t to, int64_t bucket) const {
+    std::vector<std::pair<int64_t, double>> averages;
+    int64_t bucket_index = -1;
+    double sum = 0;
+    int count = 0;
+    for (int i = first_block_from(from); i < int(_blocks.size()) && _blocks[i].first_timestamp < to; i++) {
+        Decoder decoder(_blocks[i]);
+        int64_t timestamp;
+        float value;
+        while (decoder.next(timestamp, value) && timestamp < to) {
+            if (timestamp < from)
+                continue;
+            if ((timestamp - from) / bucket != bucket_index) {
+                if (count > 0)
+                    averages.push_back(std::make_pair(from + bucket_index * bucket, sum / count));
+                bucket_index = (timestamp - from) / bucket;
+                sum = 0;
+                count = 0;
+            }
+            sum += value;
+            count++;
+        }
+    }
+    if (count > 0)
+        averages.push_back(std::make_pair(from + bucket_index * bucket, sum / count));
+    return averages;
+}
+
+size_t TimeSeries::memory_usage() const {
+    // Only the last block grows, so the bytes of the others are added up as they are sealed.
+    return _blocks.capacity() * sizeof(Block) + _sealed_bytes +
+           ((_blocks.empty()) ? 0 : _blocks.back().words.capacity() * sizeof(uint64_t));
+}
+
+void TimeSeries::clear() {
+    _blocks.clear();
+    _sealed_bytes = 0;
+    _size = 0;
+}
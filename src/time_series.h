@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_TIME_SERIES_H
+#define KNUCKLEBALL_TIME_SERIES_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Series of (timestamp, float) samples in non-decreasing order of timestamps, compressed as in Facebook's Gorilla:
+// timestamps are stored as zigzag-encoded deltas of deltas and values as the meaningful bits of their XOR with the
+// previous value. Samples are grouped in blocks that remember their first and last timestamps, so range queries only
+// decode the blocks that overlap the range. Regular series take about 2 bytes per sample.
+class TimeSeries {
+private:
+    // Maximum number of samples per block.
+    static const int SAMPLES_PER_BLOCK = 256;
+
+    struct Block {
+        // Attributes:
+        int64_t first_timestamp, last_timestamp;
+        int count;
+        int64_t bits;
+        std::vector<uint64_t> words;
+    };
+
+    // Iterator over the samples of a block.
+    class Decoder {
+    private:
+        // Attributes:
+        const Block& _block;
+        int64_t _position;
+        int _index;
+        uint64_t _timestamp, _delta;
+        uint32_t _value;
+        int _leading, _trailing;
+
+        // Read the next count bits of the block.
+        uint64_t read(int count);
+    public:
+        // Constructor:
+        Decoder(const Block& block);
+
+        // Store the next sample in timestamp and value and return true, or return false if there are no samples left.
+        bool next(int64_t& timestamp, float& value);
+    };
+
+    // Attributes:
+    std::vector<Block> _blocks;
+    size_t _sealed_bytes;
+    int _size;
+    uint64_t _last_delta;
+    uint32_t _last_value;
+    int _last_leading, _last_trailing;
+
+    // Append the count least significant bits of value to block.
+    static void write(Block& block, uint64_t value, int count);
+
+    // Index of the first block whose last timestamp is greater than or equal to timestamp.
+    int first_block_from(int64_t timestamp) const;
+public:
+    // Constructor:
+    TimeSeries();
+
+    // Number of samples.
+    int size() const;
+
+    // Check whether there are no samples.
+    bool empty() const;
+
+    // Append a sample and return true, or return false if timestamp is less than the last timestamp.
+    bool append(int64_t timestamp, float value);
+
+    // Samples whose timestamps lie in [from, to), in order.
+    std::vector<std::pair<int64_t, float>> range(int64_t from, int64_t to) const;
+
+    // Average value of the samples in each bucket [from + k * bucket, from + (k + 1) * bucket) that lies in [from, to)
+    // and is not empty, paired with the first timestamp of the bucket.
+    std::vector<std::pair<int64_t, double>> average(int64_t from, int64_t to, int64_t bucket) const;
+
+    // Number of bytes of the blocks.
+    size_t memory_usage() const;
+
+    // Erase all the samples.
+    void clear();
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include "timer_wheel.h"
+
+// Definitions of the static constants:
+const int TimerWheel::LEVELS;
+const int TimerWheel::SLOT_BITS;
+const int TimerWheel::SLOTS;
+
+TimerWheel::TimerWheel(int64_t now) : _now(now) {
+    std::fill(_counts, _counts + LEVELS, 0);
+}
+
+int64_t TimerWheel::span_of(int level) {
+    return int64_t(1) << (SLOT_BITS * level);
+}
+
+void TimerWheel::place(const Timer& timer) {
+    int64_t deadline = std::min(timer.first, _now + span_of(LEVELS) - 1);
+    int level = 0;
+    while (level < LEVELS - 1 && deadline - _now >= span_of(level + 1))
+        level++;
+    _slots[level][(deadline >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(timer);
+    _counts[level]++;
+}
+
+void TimerWheel::cascade(int level) {
+    std::vector<Timer> timers;
+    timers.swap(_slots[level][(_now >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+    _counts[level] -= int(timers.size());
+    for (auto it = timers.begin(); it != timers.end(); it++)
+        place(*it);
+}
+
+int TimerWheel::size() const {
+    int size = int(_due.size());
+    for (int level = 0; level < LEVELS; level++)
+        size += _counts[level];
+    return size;
+}
+
+int64_t TimerWheel::now() const {
+    return _now;
+}
+
+void TimerWheel::schedule(const std::string& name, int64_t deadline) {
+    if (deadline <= _now)
+        _due.push_back(name);
+    else
+        place(Timer(deadline, name));
+}
+
+std::vector<std::string> TimerWheel::advance(int64_t now) {
+    std::vector<std::string> expired;
+    expired.swap(_due);
+    while (_now < now) {
+        // Skip the ticks that can neither expire nor cascade timers.
+        int64_t tick = _now + 1;
+        for (int level = 0; level < LEVELS && _counts[level] == 0; level++)
+            tick = ((_now >> (SLOT_BITS * (level + 1))) + 1) << (SLOT_BITS * (level + 1));
+        _now = std::min(tick, now);
+        int level = 1;
+        while (level < LEVELS && _now % span_of(level) == 0)
+            level++;
+        while (--level > 0)
+            cascade(level);
+        std::vector<Timer> timers;
+        timers.swap(_slots[0][_now & (SLOTS - 1)]);
+        _counts[0] -= int(timers.size());
+        for (auto it = timers.begin(); it != timers.end(); it++)
+            expired.push_back(it->second);
+    }
+    return expired;
+}
+
+void TimerWheel::clear() {
+    _due.clear();
+    for (int level = 0; level < LEVELS; level++) {
+        for (int slot = 0; slot < SLOTS; slot++)
+            _slots[level][slot].clear();
+        _counts[level] = 0;
+    }
+}
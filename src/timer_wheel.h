@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef KNUCKLEBALL_TIMER_WHEEL_H
+#define KNUCKLEBALL_TIMER_WHEEL_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Hierarchical timer wheel of names scheduled to expire at given deadlines, in milliseconds. Level l has SLOTS slots
+// of SLOTS^l milliseconds each, and timers cascade to lower levels as their deadlines approach, so that scheduling a
+// timer costs O(1) and each timer is moved at most LEVELS times before it expires. Timers cannot be cancelled: their
+// owner is expected to ignore expirations that are no longer relevant.
+class TimerWheel {
+private:
+    // Number of levels, and number of bits of the slot index of each level.
+    static const int LEVELS = 5;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    // Timer, made of a deadline and a name.
+    typedef std::pair<int64_t, std::string> Timer;
+
+    // Attributes:
+    std::vector<Timer> _slots[LEVELS][SLOTS];
+    std::vector<std::string> _due;
+    int _counts[LEVELS];
+    int64_t _now;
+
+    // Number of milliseconds covered by a slot of the given level.
+    static int64_t span_of(int level);
+
+    // Put the timer in the slot where it is to be found when its deadline approaches.
+    void place(const Timer& timer);
+
+    // Move the timers of the current slot of the given level to lower levels.
+    void cascade(int level);
+
+    // Delete copy constructor and assignment operator:
+    TimerWheel(const TimerWheel& other) = delete;
+    TimerWheel& operator=(const TimerWheel& other) = delete;
+public:
+    // Constructor:
+    TimerWheel(int64_t now);
+
+    // Number of scheduled timers.
+    int size() const;
+
+    // Current time of the wheel.
+    int64_t now() const;
+
+    // Schedule a timer for the name. Timers whose deadlines are not in the future expire on the next advance.
+    void schedule(const std::string& name, int64_t deadline);
+
+    // Advance the current time of the wheel to now and return the names of the timers that expired, in order of
+    // deadlines.
+    std::vector<std::string> advance(int64_t now);
+
+    // Erase all the timers.
+    void clear();
+};
+
+#endif
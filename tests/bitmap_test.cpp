@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bitmap.h"
+
+class BitmapTest: public ::testing::Test {
+protected:
+    Bitmap sparse, dense;
+
+    virtual void SetUp() {
+        for (int i = 0; i < 100; i++)
+            sparse.set(i * 1000);
+        for (int i = 0; i < 10000; i++)
+            dense.set(i * 3);
+    }
+};
+
+TEST_F(BitmapTest, empty) {
+    EXPECT_FALSE(sparse.empty());
+    sparse.clear();
+    EXPECT_TRUE(sparse.empty());
+    EXPECT_TRUE(Bitmap().empty());
+}
+
+TEST_F(BitmapTest, test) {
+    EXPECT_TRUE(sparse.test(0));
+    EXPECT_TRUE(sparse.test(42000));
+    EXPECT_FALSE(sparse.test(42001));
+    EXPECT_FALSE(sparse.test(100000));
+    EXPECT_TRUE(dense.test(29997));
+    EXPECT_FALSE(dense.test(29998));
+    EXPECT_FALSE(dense.test(30000));
+}
+
+TEST_F(BitmapTest, set) {
+    EXPECT_FALSE(sparse.set(42000));
+    EXPECT_TRUE(sparse.set(42001));
+    EXPECT_TRUE(sparse.set(2147483647));
+    EXPECT_EQ(sparse.count(), 102);
+    EXPECT_TRUE(sparse.test(2147483647));
+    EXPECT_FALSE(dense.set(3));
+    EXPECT_TRUE(dense.set(4));
+    EXPECT_EQ(dense.count(), 10001);
+}
+
+TEST_F(BitmapTest, unset) {
+    EXPECT_FALSE(sparse.unset(42001));
+    EXPECT_TRUE(sparse.unset(42000));
+    EXPECT_FALSE(sparse.test(42000));
+    EXPECT_EQ(sparse.count(), 99);
+    for (int i = 0; i < 10000; i += 2)
+        EXPECT_TRUE(dense.unset(i * 3));
+    EXPECT_EQ(dense.count(), 5000);
+    EXPECT_FALSE(dense.test(0));
+    EXPECT_TRUE(dense.test(3));
+}
+
+TEST_F(BitmapTest, count) {
+    EXPECT_EQ(sparse.count(), 100);
+    EXPECT_EQ(dense.count(), 10000);
+    EXPECT_EQ(Bitmap().count(), 0);
+}
+
+TEST_F(BitmapTest, count_range) {
+    EXPECT_EQ(sparse.count_range(0, 1000), 1);
+    EXPECT_EQ(sparse.count_range(0, 1001), 2);
+    EXPECT_EQ(sparse.count_range(1, 100000), 99);
+    EXPECT_EQ(sparse.count_range(42, 42), 0);
+    EXPECT_EQ(dense.count_range(0, 30000), 10000);
+    EXPECT_EQ(dense.count_range(1, 64), 21);
+    EXPECT_EQ(dense.count_range(100, 70000), 9966);
+}
+
+TEST_F(BitmapTest, first_set) {
+    EXPECT_EQ(sparse.first_set(), 0);
+    sparse.unset(0);
+    EXPECT_EQ(sparse.first_set(), 1000);
+    dense.unset(0);
+    EXPECT_EQ(dense.first_set(), 3);
+    EXPECT_EQ(Bitmap().first_set(), -1);
+}
+
+TEST_F(BitmapTest, indexes) {
+    std::vector<int> indexes = sparse.indexes();
+    ASSERT_EQ(int(indexes.size()), 100);
+    EXPECT_EQ(indexes.front(), 0);
+    EXPECT_EQ(indexes[42], 42000);
+    EXPECT_EQ(indexes.back(), 99000);
+    indexes = dense.indexes();
+    ASSERT_EQ(int(indexes.size()), 10000);
+    EXPECT_EQ(indexes[42], 126);
+}
+
+TEST_F(BitmapTest, and_with) {
+    sparse.and_with(dense);
+    EXPECT_EQ(sparse.count(), 10);
+    EXPECT_TRUE(sparse.test(27000));
+    EXPECT_FALSE(sparse.test(1000));
+    dense.and_with(dense);
+    EXPECT_EQ(dense.count(), 10000);
+    dense.and_with(Bitmap());
+    EXPECT_TRUE(dense.empty());
+}
+
+TEST_F(BitmapTest, or_with) {
+    dense.or_with(sparse);
+    EXPECT_EQ(dense.count(), 10090);
+    EXPECT_TRUE(dense.test(1000));
+    EXPECT_TRUE(dense.test(99000));
+    dense.or_with(dense);
+    EXPECT_EQ(dense.count(), 10090);
+}
+
+TEST_F(BitmapTest, xor_with) {
+    dense.xor_with(sparse);
+    EXPECT_EQ(dense.count(), 10080);
+    EXPECT_FALSE(dense.test(0));
+    EXPECT_TRUE(dense.test(1000));
+    dense.xor_with(sparse);
+    EXPECT_EQ(dense.count(), 10000);
+    dense.xor_with(dense);
+    EXPECT_TRUE(dense.empty());
+}
@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "bloom_filter.h"
+#include "str_utils.h"
+
+class BloomFilterTest: public ::testing::Test {
+protected:
+    BloomFilter filter;
+
+    virtual void SetUp() {
+        filter = BloomFilter(10000, 0.01);
+        for (int i = 0; i < 10000; i++)
+            filter.add(str_utils::hash(std::to_string(i)));
+    }
+};
+
+TEST_F(BloomFilterTest, sizing) {
+    EXPECT_EQ(filter.bit_count(), 96256);
+    EXPECT_EQ(filter.hash_count(), 7);
+    EXPECT_EQ(BloomFilter().bit_count(), 0);
+    EXPECT_LT(BloomFilter::bits_for(10000, 0.01), 96256);
+    EXPECT_GT(BloomFilter::bits_for(2000000000, 0.01), BloomFilter::MAX_BITS);
+}
+
+TEST_F(BloomFilterTest, add) {
+    EXPECT_FALSE(filter.add(str_utils::hash("0")));
+    EXPECT_TRUE(BloomFilter(10, 0.01).add(str_utils::hash("0")));
+    EXPECT_FALSE(BloomFilter().add(str_utils::hash("0")));
+}
+
+TEST_F(BloomFilterTest, count) {
+    EXPECT_GE(filter.count(), 9900);
+    EXPECT_LE(filter.count(), 10000);
+    filter.clear();
+    EXPECT_EQ(filter.count(), 0);
+}
+
+TEST_F(BloomFilterTest, might_contain) {
+    for (int i = 0; i < 10000; i++)
+        EXPECT_TRUE(filter.might_contain(str_utils::hash(std::to_string(i))));
+    int false_positives = 0;
+    for (int i = 10000; i < 110000; i++)
+        if (filter.might_contain(str_utils::hash(std::to_string(i))))
+            false_positives++;
+    EXPECT_LT(false_positives, 2000);
+    EXPECT_FALSE(BloomFilter().might_contain(str_utils::hash("0")));
+}
+
+TEST_F(BloomFilterTest, clear) {
+    filter.clear();
+    for (int i = 0; i < 10000; i++)
+        EXPECT_FALSE(filter.might_contain(str_utils::hash(std::to_string(i))));
+}
@@ -23,6 +23,9 @@ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWIS
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <sstream>
+#include <string>
+
 #include "gtest/gtest.h"
 
 #include "context.h"
@@ -35,6 +38,23 @@ protected:
     virtual void SetUp() {
         context = Context::get_instance("", 3, 0.001, true);
     }
+
+    std::string list_of_integers(int size) {
+        std::string list = "[";
+        for (int i = 0; i < size; i++)
+            list += (i > 0 ? ", " : "") + std::to_string(i);
+        return list + "]";
+    }
+
+    int64_t memory_usage_of_variables() {
+        std::string names = context->execute("Context listVariables;");
+        std::stringstream stream(names.substr(1, names.size() - 2));
+        int64_t memory_usage = 0;
+        std::string name;
+        while (std::getline(stream, name, ','))
+            memory_usage += std::stoll(context->execute(name + " memoryUsage;"));
+        return memory_usage;
+    }
 };
 
 //////////////////////////////////////////////////////// Context ///////////////////////////////////////////////////////
@@ -82,6 +102,379 @@ TEST_F(ContextTest, Context_deleteVariablesOfNamespace) {
     EXPECT_EQ(context->execute("Context listVariables;"), "[numeric]");
 }
 
+TEST_F(ContextTest, Context_expireVariable_afterMilliseconds) {
+    EXPECT_EQ(context->execute("Context expireVariable: i afterMilliseconds: 1000;"), EXC_UNEXISTENT_VARIABLE);
+    context->execute("Integer create: i withValue: 42;");
+    context->execute("Integer create: j withValue: 42;");
+    context->execute("Integer create: std::k withValue: 42;");
+    EXPECT_EQ(context->execute("Context expireVariable: i afterMilliseconds: 0;"), "null");
+    EXPECT_EQ(context->execute("i get;"), EXC_UNEXISTENT_VARIABLE);
+    EXPECT_EQ(context->execute("Context expireVariable: std::k afterMilliseconds: 0;"), "null");
+    context->expire_variables();
+    EXPECT_EQ(context->execute("Context listNamespaces;"), "[]");
+    EXPECT_EQ(context->execute("Context expireVariable: j afterMilliseconds: 100000;"), "null");
+    EXPECT_EQ(context->execute("j get;"), "42");
+    EXPECT_EQ(context->execute("Context listVariables;"), "[j]");
+    EXPECT_EQ(context->execute("Integer create: i withValue: 21;"), "null");
+    EXPECT_EQ(context->execute("i get;"), "21");
+
+    // invalid milliseconds:
+    EXPECT_EQ(context->execute("Context expireVariable: j afterMilliseconds: -1;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Context_ttlOfVariable) {
+    EXPECT_EQ(context->execute("Context ttlOfVariable: i;"), EXC_UNEXISTENT_VARIABLE);
+    context->execute("Integer create: i withValue: 42;");
+    EXPECT_EQ(context->execute("Context ttlOfVariable: i;"), "-1");
+    context->execute("Context expireVariable: i afterMilliseconds: 100000;");
+    int ttl = std::stoi(context->execute("Context ttlOfVariable: i;"));
+    EXPECT_TRUE(ttl > 99000 && ttl <= 100000);
+    context->execute("Context deleteVariable: i;");
+    context->execute("Integer create: i withValue: 42;");
+    EXPECT_EQ(context->execute("Context ttlOfVariable: i;"), "-1");
+    context->execute("Vector<Integer> create: v withTTL: 100000;");
+    ttl = std::stoi(context->execute("Context ttlOfVariable: v;"));
+    EXPECT_TRUE(ttl > 99000 && ttl <= 100000);
+    context->execute("Integer createIfNotExists: i withValue: 21 withTTL: 0;");
+    EXPECT_EQ(context->execute("i get;"), "42");
+    context->execute("Integer create: j withValue: 21 withTTL: 0;");
+    EXPECT_EQ(context->execute("j get;"), EXC_UNEXISTENT_VARIABLE);
+
+    // invalid variable:
+    EXPECT_EQ(context->execute("Context ttlOfVariable: 42;"), EXC_INVALID_ARGUMENT);
+
+    // invalid time to live:
+    EXPECT_EQ(context->execute("Integer create: k withValue: 21 withTTL: -1;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Context_getAll) {
+    EXPECT_EQ(context->execute("Context getAll: [];"), "[]");
+    context->execute("Boolean create: std::t withValue: true;");
+    context->execute("Integer create: i withValue: 42;");
+    context->execute("Vector<String> create: names;");
+    context->execute("names pushBack: \"knuckle, ball\";");
+    EXPECT_EQ(context->execute("Context getAll: [i, std::t, names, j, i];"), "[42,true,[\"knuckle, ball\"],null,42]");
+
+    // invalid variable:
+    EXPECT_EQ(context->execute("Context getAll: i;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("Context getAll: [i, 42];"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Context_keyspaceStats) {
+    EXPECT_EQ(context->execute("Context keyspaceStats;"),
+              "((\"size\",0),(\"buckets\",4),(\"loadFactor\",0.000),(\"isRehashing\",false),"
+              "(\"rehashProgress\",1.000))");
+    context->execute("Integer create: i withValue: 42;");
+    context->execute("Integer create: j withValue: 42;");
+    context->execute("Integer create: k withValue: 42;");
+    context->execute("Integer create: l withValue: 42;");
+    EXPECT_EQ(context->execute("Context keyspaceStats;"),
+              "((\"size\",4),(\"buckets\",12),(\"loadFactor\",0.500),(\"isRehashing\",true),"
+              "(\"rehashProgress\",0.250))");
+    for (int i = 0; i < 3; i++)
+        context->execute("Context listVariables;");
+    EXPECT_EQ(context->execute("Context keyspaceStats;"),
+              "((\"size\",4),(\"buckets\",8),(\"loadFactor\",0.500),(\"isRehashing\",false),"
+              "(\"rehashProgress\",1.000))");
+}
+
+TEST_F(ContextTest, Context_memoryByNamespace) {
+    EXPECT_EQ(context->execute("Context memoryByNamespace;"), "()");
+    context->execute("Vector<Integer> create: std::v;");
+    context->execute("std::v pushBackAll: " + list_of_integers(1000) + ";");
+    context->execute("Integer create: uni::i withValue: 42;");
+    context->execute("Integer create: i withValue: 42;");
+    int64_t memory_usage = std::stoll(context->execute("std::v memoryUsage;"));
+    EXPECT_GT(memory_usage, 1000 * int64_t(sizeof(IntegerInstance)));
+    EXPECT_EQ(context->execute("Context memoryByNamespace;"), "((std," + std::to_string(memory_usage) + "),(uni," +
+                                                             context->execute("uni::i memoryUsage;") + "))");
+}
+
+TEST_F(ContextTest, Context_biggestVariables) {
+    EXPECT_EQ(context->execute("Context biggestVariables: 2;"), "()");
+    context->execute("Vector<Integer> create: v;");
+    context->execute("v pushBackAll: " + list_of_integers(1000) + ";");
+    context->execute("Vector<Integer> create: w;");
+    context->execute("w pushBackAll: " + list_of_integers(10) + ";");
+    context->execute("Integer create: i withValue: 42;");
+    EXPECT_EQ(context->execute("Context biggestVariables: 2;"), "((v," + context->execute("v memoryUsage;") + "),(w," +
+                                                                context->execute("w memoryUsage;") + "))");
+    EXPECT_EQ(context->execute("Context biggestVariables: 0;"), "()");
+
+    // invalid count:
+    EXPECT_EQ(context->execute("Context biggestVariables: -1;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Context_poolStats) {
+    context->execute("Vector<Character> create: v;");
+    context->execute("v pushBackAll: ['k', 'n', 'u', 'c', 'k', 'l', 'e'];");
+    std::string pool_stats = context->execute("Context poolStats;");
+    std::string::size_type pool = pool_stats.find("(\"Character\",((\"blockSize\",");
+    ASSERT_NE(pool, std::string::npos);
+    EXPECT_NE(pool_stats.find("(\"blocks\",256),(\"usedBlocks\",0)))", pool), std::string::npos);
+    for (int i = 0; i < 5; i++)
+        context->execute("v pushBackAll: ['k', 'n', 'u', 'c', 'k', 'l', 'e'];");
+    pool_stats = context->execute("Context poolStats;");
+    pool = pool_stats.find("(\"Character\",((\"blockSize\",");
+    ASSERT_NE(pool, std::string::npos);
+    EXPECT_NE(pool_stats.find("(\"blocks\",256),(\"usedBlocks\",42)))", pool), std::string::npos);
+}
+
+TEST_F(ContextTest, Context_internStats) {
+    EXPECT_EQ(context->execute("Context internStats;"), "((\"strings\",0),(\"bytes\",0))");
+    context->set_interning_strings(true);
+    context->execute("Vector<String> create: v;");
+    context->execute("v pushBackAll: [\"" + std::string(100, 'k') + "\", \"" + std::string(100, 'k') + "\"];");
+    context->set_interning_strings(false);
+    std::string intern_stats = context->execute("Context internStats;");
+    EXPECT_EQ(intern_stats.find("((\"strings\",1),(\"bytes\","), 0);
+    EXPECT_GT(std::stoll(intern_stats.substr(intern_stats.rfind(",") + 1)), 100);
+    context->execute("Context deleteVariable: v;");
+    EXPECT_EQ(context->execute("Context internStats;"), "((\"strings\",0),(\"bytes\",0))");
+}
+
+TEST_F(ContextTest, Variable_memoryUsage) {
+    context->execute("Vector<Integer> create: v;");
+    int64_t memory_usage = std::stoll(context->execute("v memoryUsage;"));
+    EXPECT_GT(memory_usage, 0);
+    context->execute("v pushBackAll: " + list_of_integers(1000) + ";");
+    EXPECT_GT(std::stoll(context->execute("v memoryUsage;")), memory_usage + 1000 * int64_t(sizeof(IntegerInstance)));
+    memory_usage = std::stoll(context->execute("v memoryUsage;"));
+    context->execute("v get;");
+    context->execute("v clear;");
+    EXPECT_LE(std::stoll(context->execute("v memoryUsage;")), memory_usage - 1000 * int64_t(sizeof(IntegerInstance)));
+    EXPECT_EQ(context->execute("u memoryUsage;"), EXC_UNEXISTENT_VARIABLE);
+
+    // elements shared with other variables are counted by each of them:
+    context->execute("Set<Float> create: a;");
+    context->execute("a addAll: " + list_of_integers(100) + ";");
+    context->execute("Set<Float> create: b;");
+    context->execute("b storeUnionOf: a and: a;");
+    EXPECT_EQ(context->execute("b memoryUsage;"), context->execute("a memoryUsage;"));
+    context->execute("a clear;");
+    context->execute("b clear;");
+    EXPECT_EQ(context->execute("b memoryUsage;"), context->execute("a memoryUsage;"));
+    memory_usage = std::stoll(context->execute("b memoryUsage;"));
+    context->execute("b add: 2.5;");
+    EXPECT_GT(std::stoll(context->execute("b memoryUsage;")), memory_usage);
+    context->execute("b remove: 2.5;");
+    EXPECT_EQ(std::stoll(context->execute("b memoryUsage;")), memory_usage);
+}
+
+TEST_F(ContextTest, Variable_packing) {
+    context->execute("Vector<Integer> create: v;");
+    context->execute("v pushBackAll: " + list_of_integers(32) + ";");
+    context->execute("Vector<Integer> create: w;");
+    context->execute("w pushBackAll: " + list_of_integers(33) + ";");
+    EXPECT_LT(std::stoll(context->execute("v memoryUsage;")) + 32 * int64_t(sizeof(IntegerInstance)),
+              std::stoll(context->execute("w memoryUsage;")));
+    EXPECT_EQ(context->execute("v first: 3;"), "[0,1,2]");
+    EXPECT_EQ(context->execute("w last: 3;"), "[30,31,32]");
+    context->execute("Set<String> create: s;");
+    context->execute("s addAll: [\"knuckle\", \"ball\"];");
+    int64_t memory_usage = std::stoll(context->execute("s memoryUsage;"));
+    context->execute("s add: \"" + std::string(65, 'k') + "\";");
+    context->execute("s remove: \"" + std::string(65, 'k') + "\";");
+    EXPECT_GT(std::stoll(context->execute("s memoryUsage;")), memory_usage);
+    EXPECT_EQ(context->execute("s get;"), "{\"ball\",\"knuckle\"}");
+    context->execute("Dictionary<Character, Float> create: d;");
+    context->execute("d associateValue: 2.5 withKey: 'b';");
+    context->execute("d associateValue: -1 withKey: 'a';");
+    EXPECT_EQ(context->execute("d get;"), "(('a',-1.000),('b',2.500))");
+    EXPECT_EQ(context->execute("d getValueForKey: 'b';"), "2.500");
+    EXPECT_EQ(context->execute("d getValueForKey: 'c';"), "null");
+    EXPECT_EQ(context->execute("d size;"), "2");
+
+    // reads are answered from the packed elements:
+    context->execute("v popBack;");
+    context->execute("v pushBack: 7;");
+    EXPECT_EQ(context->execute("v size;"), "32");
+    EXPECT_EQ(context->execute("v isEmpty?;"), "false");
+    EXPECT_EQ(context->execute("v contains? 7;"), "true");
+    EXPECT_EQ(context->execute("v contains? 31;"), "false");
+    EXPECT_EQ(context->execute("v count: 7;"), "2");
+    EXPECT_EQ(context->execute("v firstIndexOf: 7;"), "7");
+    EXPECT_EQ(context->execute("v firstIndexOf: 32;"), "-1");
+    EXPECT_EQ(context->execute("v atIndex: 31;"), "7");
+    EXPECT_EQ(context->execute("v atIndex: 32;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("v contains?;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+    EXPECT_EQ(context->execute("s contains? \"ball\";"), "true");
+    EXPECT_EQ(context->execute("s contains? \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("s size;"), "2");
+    EXPECT_EQ(context->execute("d containsKey? 'a';"), "true");
+    EXPECT_EQ(context->execute("d containsKey? 'c';"), "false");
+    EXPECT_EQ(context->execute("d keys;"), "['a','b']");
+    EXPECT_EQ(context->execute("d values;"), "[-1.000,2.500]");
+    EXPECT_EQ(context->execute("d isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, Variable_packingWrites) {
+    context->execute("Vector<Integer> create: v;");
+    context->execute("v pushBackAll: " + list_of_integers(31) + ";");
+    int64_t memory_usage = std::stoll(context->execute("v memoryUsage;"));
+    context->execute("v pushBack: 31;");
+    EXPECT_LT(std::stoll(context->execute("v memoryUsage;")), memory_usage + int64_t(sizeof(IntegerInstance)));
+    context->execute("v pushBack: 32;");
+    EXPECT_GT(std::stoll(context->execute("v memoryUsage;")), memory_usage + 32 * int64_t(sizeof(IntegerInstance)));
+    EXPECT_EQ(context->execute("v last: 3;"), "[30,31,32]");
+
+    context->execute("Set<String> create: s;");
+    context->execute("s add: \"knuckle\";");
+    context->execute("s add: \"ball\";");
+    context->execute("s add: \"knuckle\";");
+    context->execute("s add: \"bat\";");
+    context->execute("s remove: \"bat\";");
+    context->execute("s remove: \"glove\";");
+    EXPECT_EQ(context->execute("s get;"), "{\"ball\",\"knuckle\"}");
+    EXPECT_LT(std::stoll(context->execute("s memoryUsage;")),
+              int64_t(sizeof(SetInstance) + 2 * sizeof(StringInstance)));
+
+    context->execute("Dictionary<String, Integer> create: d;");
+    context->execute("d associateValue: 1 withKey: \"knuckle\";");
+    context->execute("d associateValue: 2 withKey: \"ball\";");
+    context->execute("d associateValue: 3 withKey: \"knuckle\";");
+    EXPECT_EQ(context->execute("d incrementValueForKey: \"ball\" by: 40;"), "42");
+    EXPECT_EQ(context->execute("d incrementValueForKey: \"bat\" by: 7;"), "7");
+    EXPECT_EQ(context->execute("d decrementValueForKey: \"bat\" by: 8;"), "-1");
+    EXPECT_EQ(context->execute("d incrementValueForKey: \"bat\" by: \"one\";"), EXC_INVALID_ARGUMENT);
+    context->execute("d removeKey: \"knuckle\";");
+    context->execute("d removeKey: \"glove\";");
+    EXPECT_EQ(context->execute("d get;"), "((\"ball\",42),(\"bat\",-1))");
+    EXPECT_LT(std::stoll(context->execute("d memoryUsage;")),
+              int64_t(sizeof(DictionaryInstance) + 2 * sizeof(StringInstance)));
+    context->execute("Dictionary<Integer, Float> create: f;");
+    context->execute("f associateValue: 0.5 withKey: 1;");
+    EXPECT_EQ(context->execute("f incrementValueForKey: 1 by: 0.25;"), "0.750");
+    EXPECT_EQ(context->execute("f decrementValueForKey: 2 by: 1;"), "-1.000");
+    EXPECT_EQ(context->execute("f get;"), "((1,0.750),(2,-1.000))");
+}
+
+TEST_F(ContextTest, Variable_interning) {
+    std::string status = "\"" + std::string(40, 'k') + "\"";
+    std::string statuses = "[" + status;
+    for (int i = 1; i < 100; i++)
+        statuses += ", " + status;
+    statuses += "]";
+    context->execute("Vector<String> create: v;");
+    context->execute("v pushBackAll: " + statuses + ";");
+    context->set_interning_strings(true);
+    context->execute("Vector<String> create: w;");
+    context->execute("w pushBackAll: " + statuses + ";");
+    context->execute("Set<String> create: s;");
+    context->execute("s addAll: " + statuses + ";");
+    context->set_interning_strings(false);
+    EXPECT_LT(std::stoll(context->execute("w memoryUsage;")) + 99 * 40,
+              std::stoll(context->execute("v memoryUsage;")));
+    EXPECT_EQ(context->execute("w get;"), context->execute("v get;"));
+    EXPECT_EQ(context->execute("w count: " + status + ";"), "100");
+    EXPECT_EQ(context->execute("s get;"), "{" + status + "}");
+}
+
+TEST_F(ContextTest, Context_maxMemory_interning) {
+    std::string strings = "[";
+    for (int i = 0; i < 1000; i++)
+        strings += (i > 0 ? ", \"" : "\"") + std::string(100, 'k') + std::to_string(i) + "\"";
+    strings += "]";
+    context->set_interning_strings(true);
+    context->execute("Vector<String> create: v0;");
+    context->execute("v0 pushBackAll: " + strings + ";");
+    context->set_interning_strings(false);
+
+    // interned strings are not charged to the variables, but count towards the limit:
+    EXPECT_LT(memory_usage_of_variables(), 1000 * 100);
+    context->set_max_memory(memory_usage_of_variables() + 1000 * 50, "lru", "");
+    context->execute("Vector<Integer> create: v1;");
+    context->execute("v1 pushBackAll: " + list_of_integers(10) + ";");
+    EXPECT_EQ(context->execute("v0 size;"), EXC_UNEXISTENT_VARIABLE);
+    EXPECT_EQ(context->execute("v1 size;"), "10");
+    EXPECT_EQ(context->execute("Context internStats;"), "((\"strings\",0),(\"bytes\",0))");
+}
+
+TEST_F(ContextTest, Context_maxMemory_lru) {
+    size_t max_memory = 400000;
+    context->set_max_memory(max_memory, "lru", "");
+    for (int i = 0; i < 10; i++) {
+        context->execute("Vector<Integer> create: v" + std::to_string(i) + ";");
+        context->execute("v" + std::to_string(i) + " pushBackAll: " + list_of_integers(1000) + ";");
+        context->execute("v0 size;");
+    }
+    EXPECT_LE(memory_usage_of_variables(), max_memory);
+    EXPECT_EQ(context->execute("v0 size;"), "1000");
+    EXPECT_EQ(context->execute("v1 size;"), EXC_UNEXISTENT_VARIABLE);
+    EXPECT_EQ(context->execute("v9 size;"), "1000");
+
+    // statements that do not grow the memory used never evict:
+    context->set_max_memory(1, "lru", "");
+    EXPECT_EQ(context->execute("v9 size;"), "1000");
+    EXPECT_EQ(context->execute("v9 popBack;"), "999");
+    EXPECT_EQ(context->execute("v9 size;"), "999");
+    context->execute("v9 pushBack: 1;");
+    EXPECT_EQ(context->execute("v9 size;"), EXC_UNEXISTENT_VARIABLE);
+
+    // invalid policy:
+    EXPECT_THROW(context->set_max_memory(max_memory, "fifo", ""), const char*);
+}
+
+TEST_F(ContextTest, Context_maxMemory_lfu) {
+    size_t max_memory = 400000;
+    context->set_max_memory(max_memory, "lfu", "");
+    context->execute("Vector<Integer> create: v0;");
+    for (int i = 0; i < 100; i++)
+        context->execute("v0 size;");
+    for (int i = 0; i < 10; i++) {
+        context->execute("Vector<Integer> create: v" + std::to_string(i) + ";");
+        context->execute("v" + std::to_string(i) + " pushBackAll: " + list_of_integers(1000) + ";");
+    }
+    EXPECT_LE(memory_usage_of_variables(), max_memory);
+    EXPECT_EQ(context->execute("v0 size;"), "1000");
+    EXPECT_EQ(context->execute("v1 size;"), EXC_UNEXISTENT_VARIABLE);
+}
+
+TEST_F(ContextTest, Context_maxMemory_ttl) {
+    size_t max_memory = 400000;
+    context->set_max_memory(max_memory, "ttl", "");
+    context->execute("Vector<Integer> create: v;");
+    context->execute("v pushBackAll: " + list_of_integers(1000) + ";");
+    for (int i = 0; i < 10; i++) {
+        context->execute("Vector<Integer> create: v" + std::to_string(i) + " withTTL: " +
+                         std::to_string(100000 - i * 1000) + ";");
+        context->execute("v" + std::to_string(i) + " pushBackAll: " + list_of_integers(1000) + ";");
+    }
+    EXPECT_LE(memory_usage_of_variables(), max_memory);
+    EXPECT_EQ(context->execute("v size;"), "1000");
+    EXPECT_EQ(context->execute("v0 size;"), "1000");
+    EXPECT_EQ(context->execute("v8 size;"), EXC_UNEXISTENT_VARIABLE);
+}
+
+TEST_F(ContextTest, Context_maxMemory_ttl_without_deadlines) {
+    size_t max_memory = 400000;
+    context->set_max_memory(max_memory, "ttl", "");
+    for (int i = 0; i < 10; i++) {
+        context->execute("Vector<Integer> create: v" + std::to_string(i) + ";");
+        context->execute("v" + std::to_string(i) + " pushBackAll: " + list_of_integers(1000) + ";");
+        context->execute("v0 size;");
+    }
+    EXPECT_LE(memory_usage_of_variables(), max_memory);
+    EXPECT_EQ(context->execute("v0 size;"), "1000");
+    EXPECT_EQ(context->execute("v1 size;"), EXC_UNEXISTENT_VARIABLE);
+    EXPECT_EQ(context->execute("v9 size;"), "1000");
+}
+
+TEST_F(ContextTest, Context_maxMemory_namespace) {
+    size_t max_memory = 400000;
+    context->set_max_memory(max_memory, "lru", "cache");
+    context->execute("Vector<Integer> create: v;");
+    context->execute("v pushBackAll: " + list_of_integers(1000) + ";");
+    for (int i = 0; i < 10; i++) {
+        context->execute("Vector<Integer> create: cache::v" + std::to_string(i) + ";");
+        context->execute("cache::v" + std::to_string(i) + " pushBackAll: " + list_of_integers(1000) + ";");
+    }
+    EXPECT_LE(memory_usage_of_variables(), max_memory);
+    EXPECT_EQ(context->execute("v size;"), "1000");
+    EXPECT_EQ(context->execute("cache::v0 size;"), EXC_UNEXISTENT_VARIABLE);
+    EXPECT_EQ(context->execute("cache::v9 size;"), "1000");
+}
+
 TEST_F(ContextTest, Context_getFloatPrecision) {
     EXPECT_EQ(context->execute("Context getFloatPrecision;"), "3");
 }
@@ -151,6 +544,20 @@ TEST_F(ContextTest, Boolean_isFalse) {
     EXPECT_EQ(context->execute("f isFalse?;"), "true");
 }
 
+TEST_F(ContextTest, Boolean_getAndSet) {
+    EXPECT_EQ(context->execute("Boolean create: f withValue: false;"), "null");
+    EXPECT_EQ(context->execute("f getAndSet: true;"), "false");
+    EXPECT_EQ(context->execute("f get;"), "true");
+}
+
+TEST_F(ContextTest, Boolean_compareAndSet_to) {
+    EXPECT_EQ(context->execute("Boolean create: f withValue: false;"), "null");
+    EXPECT_EQ(context->execute("f compareAndSet: true to: false;"), "false");
+    EXPECT_EQ(context->execute("f get;"), "false");
+    EXPECT_EQ(context->execute("f compareAndSet: false to: true;"), "true");
+    EXPECT_EQ(context->execute("f get;"), "true");
+}
+
 /////////////////////////////////////////////////////// Character //////////////////////////////////////////////////////
 
 TEST_F(ContextTest, Character_create_withValue) {
@@ -262,6 +669,20 @@ TEST_F(ContextTest, Character_isGreaterThanOrEqualTo) {
     EXPECT_EQ(context->execute("numeric isGreaterThanOrEqualTo? '2';"), "false");
 }
 
+TEST_F(ContextTest, Character_getAndSet) {
+    EXPECT_EQ(context->execute("Character create: alphabetic withValue: 'b';"), "null");
+    EXPECT_EQ(context->execute("alphabetic getAndSet: 'a';"), "'b'");
+    EXPECT_EQ(context->execute("alphabetic get;"), "'a'");
+}
+
+TEST_F(ContextTest, Character_compareAndSet_to) {
+    EXPECT_EQ(context->execute("Character create: alphabetic withValue: 'b';"), "null");
+    EXPECT_EQ(context->execute("alphabetic compareAndSet: 'a' to: 'c';"), "false");
+    EXPECT_EQ(context->execute("alphabetic get;"), "'b'");
+    EXPECT_EQ(context->execute("alphabetic compareAndSet: 'b' to: 'c';"), "true");
+    EXPECT_EQ(context->execute("alphabetic get;"), "'c'");
+}
+
 /////////////////////////////////////////////////////// Integer ////////////////////////////////////////////////////////
 
 TEST_F(ContextTest, Integer_create_withValue) {
@@ -377,6 +798,34 @@ TEST_F(ContextTest, Integer_divideBy) {
     EXPECT_EQ(context->execute("i get;"), "-20");
 }
 
+TEST_F(ContextTest, Integer_addAndGet) {
+    EXPECT_EQ(context->execute("Integer create: i withValue: 42;"), "null");
+    EXPECT_EQ(context->execute("i addAndGet: 8;"), "50");
+    EXPECT_EQ(context->execute("i addAndGet: -10;"), "40");
+    EXPECT_EQ(context->execute("i get;"), "40");
+}
+
+TEST_F(ContextTest, Integer_getAndAdd) {
+    EXPECT_EQ(context->execute("Integer create: i withValue: 42;"), "null");
+    EXPECT_EQ(context->execute("i getAndAdd: 8;"), "42");
+    EXPECT_EQ(context->execute("i getAndAdd: -10;"), "50");
+    EXPECT_EQ(context->execute("i get;"), "40");
+}
+
+TEST_F(ContextTest, Integer_getAndSet) {
+    EXPECT_EQ(context->execute("Integer create: i withValue: 42;"), "null");
+    EXPECT_EQ(context->execute("i getAndSet: 7;"), "42");
+    EXPECT_EQ(context->execute("i get;"), "7");
+}
+
+TEST_F(ContextTest, Integer_compareAndSet_to) {
+    EXPECT_EQ(context->execute("Integer create: i withValue: 42;"), "null");
+    EXPECT_EQ(context->execute("i compareAndSet: 41 to: 7;"), "false");
+    EXPECT_EQ(context->execute("i get;"), "42");
+    EXPECT_EQ(context->execute("i compareAndSet: 42 to: 7;"), "true");
+    EXPECT_EQ(context->execute("i get;"), "7");
+}
+
 //////////////////////////////////////////////////////// Float /////////////////////////////////////////////////////////
 
 TEST_F(ContextTest, Float_create_withValue) {
@@ -456,6 +905,32 @@ TEST_F(ContextTest, Float_divideBy) {
     EXPECT_EQ(context->execute("f get;"), "42.500");
 }
 
+TEST_F(ContextTest, Float_addAndGet) {
+    EXPECT_EQ(context->execute("Float create: f withValue: 4.2;"), "null");
+    EXPECT_EQ(context->execute("f addAndGet: 0.8;"), "5.000");
+    EXPECT_EQ(context->execute("f get;"), "5.000");
+}
+
+TEST_F(ContextTest, Float_getAndAdd) {
+    EXPECT_EQ(context->execute("Float create: f withValue: 4.2;"), "null");
+    EXPECT_EQ(context->execute("f getAndAdd: 0.8;"), "4.200");
+    EXPECT_EQ(context->execute("f get;"), "5.000");
+}
+
+TEST_F(ContextTest, Float_getAndSet) {
+    EXPECT_EQ(context->execute("Float create: f withValue: 4.2;"), "null");
+    EXPECT_EQ(context->execute("f getAndSet: 0.7;"), "4.200");
+    EXPECT_EQ(context->execute("f get;"), "0.700");
+}
+
+TEST_F(ContextTest, Float_compareAndSet_to) {
+    EXPECT_EQ(context->execute("Float create: f withValue: 4.2;"), "null");
+    EXPECT_EQ(context->execute("f compareAndSet: 4.3 to: 0.7;"), "false");
+    EXPECT_EQ(context->execute("f get;"), "4.200");
+    EXPECT_EQ(context->execute("f compareAndSet: 4.2 to: 0.7;"), "true");
+    EXPECT_EQ(context->execute("f get;"), "0.700");
+}
+
 //////////////////////////////////////////////////////// String ////////////////////////////////////////////////////////
 
 TEST_F(ContextTest, String_create) {
@@ -700,6 +1175,20 @@ TEST_F(ContextTest, String_clear) {
     EXPECT_EQ(context->execute("str get;"), "\"\"");
 }
 
+TEST_F(ContextTest, String_getAndSet) {
+    EXPECT_EQ(context->execute("String create: str withValue: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("str getAndSet: \"ball\";"), "\"knuckle\"");
+    EXPECT_EQ(context->execute("str get;"), "\"ball\"");
+}
+
+TEST_F(ContextTest, String_compareAndSet_to) {
+    EXPECT_EQ(context->execute("String create: str withValue: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("str compareAndSet: \"ball\" to: \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("str get;"), "\"knuckle\"");
+    EXPECT_EQ(context->execute("str compareAndSet: \"knuckle\" to: \"knuckleball\";"), "true");
+    EXPECT_EQ(context->execute("str get;"), "\"knuckleball\"");
+}
+
 //////////////////////////////////////////////////////// Vector ////////////////////////////////////////////////////////
 
 TEST_F(ContextTest, Vector_create) {
@@ -879,6 +1368,17 @@ TEST_F(ContextTest, Vector_sliceFromIndex_toIndex) {
     EXPECT_EQ(context->execute("prices sliceFromIndex: 0 toIndex: 42;"), EXC_INVALID_ARGUMENT);
 }
 
+TEST_F(ContextTest, Vector_getFrom_count) {
+    EXPECT_EQ(context->execute("Vector<Integer> create: prices;"), "null");
+    EXPECT_EQ(context->execute("prices getFrom: 0 count: 2;"), "[]");
+    EXPECT_EQ(context->execute("prices pushBackAll: [42, 21, 84, 63];"), "null");
+    EXPECT_EQ(context->execute("prices getFrom: 0 count: 2;"), "[42,21]");
+    EXPECT_EQ(context->execute("prices getFrom: 2 count: 2;"), "[84,63]");
+    EXPECT_EQ(context->execute("prices getFrom: 3 count: 2;"), "[63]");
+    EXPECT_EQ(context->execute("prices getFrom: 4 count: 2;"), "[]");
+    EXPECT_EQ(context->execute("prices getFrom: 1 count: 0;"), "[]");
+}
+
 TEST_F(ContextTest, Vector_pushBack) {
     EXPECT_EQ(context->execute("Vector<Integer> create: prices;"), "null");
     EXPECT_EQ(context->execute("prices pushBack: 42;"), "null");
@@ -887,6 +1387,16 @@ TEST_F(ContextTest, Vector_pushBack) {
     EXPECT_EQ(context->execute("prices get;"), "[42,21]");
 }
 
+TEST_F(ContextTest, Vector_pushBackAll) {
+    EXPECT_EQ(context->execute("Vector<Integer> create: prices;"), "null");
+    EXPECT_EQ(context->execute("prices pushBackAll: [];"), "null");
+    EXPECT_EQ(context->execute("prices get;"), "[]");
+    EXPECT_EQ(context->execute("prices pushBackAll: [42];"), "null");
+    EXPECT_EQ(context->execute("prices get;"), "[42]");
+    EXPECT_EQ(context->execute("prices pushBackAll: [ 21, 42,84 ];"), "null");
+    EXPECT_EQ(context->execute("prices get;"), "[42,21,42,84]");
+}
+
 TEST_F(ContextTest, Vector_pushFront) {
     EXPECT_EQ(context->execute("Vector<Integer> create: prices;"), "null");
     EXPECT_EQ(context->execute("prices pushFront: 42;"), "null");
@@ -1122,6 +1632,35 @@ TEST_F(ContextTest, Set_size) {
     EXPECT_EQ(context->execute("ids size;"), "3");
 }
 
+TEST_F(ContextTest, Set_scanFirst) {
+    EXPECT_EQ(context->execute("Set<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores scanFirst: 2;"), "({},null)");
+    EXPECT_EQ(context->execute("scores addAll: [84, 21, 42];"), "null");
+    EXPECT_EQ(context->execute("scores scanFirst: 2;"), "({21,42},84)");
+    EXPECT_EQ(context->execute("scores scanFirst: 3;"), "({21,42,84},null)");
+}
+
+TEST_F(ContextTest, Set_scanFrom_count) {
+    EXPECT_EQ(context->execute("Set<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores addAll: [84, 21, 42, 63];"), "null");
+    EXPECT_EQ(context->execute("scores scanFrom: 42 count: 2;"), "({42,63},84)");
+    EXPECT_EQ(context->execute("scores scanFrom: 43 count: 2;"), "({63,84},null)");
+    EXPECT_EQ(context->execute("scores scanFrom: 85 count: 2;"), "({},null)");
+
+    // the cursor survives the removal of the element it points to:
+    EXPECT_EQ(context->execute("scores remove: 84;"), "null");
+    EXPECT_EQ(context->execute("scores add: 90;"), "null");
+    EXPECT_EQ(context->execute("scores scanFrom: 84 count: 2;"), "({90},null)");
+
+    // float cursors are not rounded to the float precision:
+    EXPECT_EQ(context->execute("Context setFloatComparisonTolerance: 1e-6;"), "null");
+    EXPECT_EQ(context->execute("Set<Float> create: ratios;"), "null");
+    EXPECT_EQ(context->execute("ratios addAll: [1.0001, 1.0002, 2.5];"), "null");
+    EXPECT_EQ(context->execute("ratios scanFirst: 1;"), "({1.000},1.00020003)");
+    EXPECT_EQ(context->execute("ratios scanFrom: 1.00020003 count: 1;"), "({1.000},2.5)");
+    EXPECT_EQ(context->execute("ratios scanFrom: 2.5 count: 1;"), "({2.500},null)");
+}
+
 TEST_F(ContextTest, Set_add) {
     EXPECT_EQ(context->execute("Set<String> create: ids;"), "null");
     EXPECT_EQ(context->execute("ids add: \"knuckle\";"), "null");
@@ -1130,6 +1669,14 @@ TEST_F(ContextTest, Set_add) {
     EXPECT_EQ(context->execute("ids get;"), "{\"ball\",\"knuckle\"}");
 }
 
+TEST_F(ContextTest, Set_addAll) {
+    EXPECT_EQ(context->execute("Set<String> create: ids;"), "null");
+    EXPECT_EQ(context->execute("ids addAll: [\"knuckle\"];"), "null");
+    EXPECT_EQ(context->execute("ids get;"), "{\"knuckle\"}");
+    EXPECT_EQ(context->execute("ids addAll: [\"ball\", \"knuckle\", \"knuckle, ball\", \"]\"];"), "null");
+    EXPECT_EQ(context->execute("ids get;"), "{\"]\",\"ball\",\"knuckle\",\"knuckle, ball\"}");
+}
+
 TEST_F(ContextTest, Set_remove) {
     EXPECT_EQ(context->execute("Set<String> create: ids;"), "null");
     EXPECT_EQ(context->execute("ids add: \"knuckle\";"), "null");
@@ -1146,6 +1693,359 @@ TEST_F(ContextTest, Set_clear) {
     EXPECT_EQ(context->execute("ids clear;"), "null");
     EXPECT_EQ(context->execute("ids get;"), "{}");
 }
+TEST_F(ContextTest, Set_unionWith) {
+    EXPECT_EQ(context->execute("Set<Integer> create: odds;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: primes;"), "null");
+    EXPECT_EQ(context->execute("odds unionWith: primes;"), "{}");
+    for (int i = 1; i < 10; i += 2)
+        EXPECT_EQ(context->execute("odds add: " + std::to_string(i) + ";"), "null");
+    EXPECT_EQ(context->execute("primes add: 2;"), "null");
+    EXPECT_EQ(context->execute("primes add: 3;"), "null");
+    EXPECT_EQ(context->execute("odds unionWith: primes;"), "{1,2,3,5,7,9}");
+    EXPECT_EQ(context->execute("primes unionWith: odds;"), "{1,2,3,5,7,9}");
+    EXPECT_EQ(context->execute("odds unionWith: odds;"), "{1,3,5,7,9}");
+    EXPECT_EQ(context->execute("odds size;"), "5");
+}
+
+TEST_F(ContextTest, Set_intersectWith) {
+    EXPECT_EQ(context->execute("Set<Integer> create: odds;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: primes;"), "null");
+    for (int i = 1; i < 1000; i += 2)
+        EXPECT_EQ(context->execute("odds add: " + std::to_string(i) + ";"), "null");
+    EXPECT_EQ(context->execute("odds intersectWith: primes;"), "{}");
+    EXPECT_EQ(context->execute("primes add: 2;"), "null");
+    EXPECT_EQ(context->execute("primes add: 3;"), "null");
+    EXPECT_EQ(context->execute("primes add: 997;"), "null");
+    EXPECT_EQ(context->execute("odds intersectWith: primes;"), "{3,997}");
+    EXPECT_EQ(context->execute("primes intersectWith: odds;"), "{3,997}");
+    EXPECT_EQ(context->execute("primes intersectWith: primes;"), "{2,3,997}");
+}
+
+TEST_F(ContextTest, Set_differenceWith) {
+    EXPECT_EQ(context->execute("Set<Integer> create: odds;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: primes;"), "null");
+    for (int i = 1; i < 1000; i += 2)
+        EXPECT_EQ(context->execute("odds add: " + std::to_string(i) + ";"), "null");
+    EXPECT_EQ(context->execute("primes add: 2;"), "null");
+    EXPECT_EQ(context->execute("primes add: 3;"), "null");
+    EXPECT_EQ(context->execute("primes add: 997;"), "null");
+    EXPECT_EQ(context->execute("primes differenceWith: odds;"), "{2}");
+    EXPECT_EQ(context->execute("odds differenceWith: primes;").substr(0, 8), "{1,5,7,9");
+    EXPECT_EQ(context->execute("odds differenceWith: odds;"), "{}");
+    EXPECT_EQ(context->execute("odds size;"), "500");
+}
+
+TEST_F(ContextTest, Set_storeUnionOf_and) {
+    EXPECT_EQ(context->execute("Set<Integer> create: odds;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: primes;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: numbers;"), "null");
+    EXPECT_EQ(context->execute("odds add: 1;"), "null");
+    EXPECT_EQ(context->execute("odds add: 3;"), "null");
+    EXPECT_EQ(context->execute("primes add: 2;"), "null");
+    EXPECT_EQ(context->execute("primes add: 3;"), "null");
+    EXPECT_EQ(context->execute("numbers add: 42;"), "null");
+    EXPECT_EQ(context->execute("numbers storeUnionOf: odds and: primes;"), "null");
+    EXPECT_EQ(context->execute("numbers get;"), "{1,2,3}");
+    EXPECT_EQ(context->execute("odds storeUnionOf: odds and: primes;"), "null");
+    EXPECT_EQ(context->execute("odds get;"), "{1,2,3}");
+}
+
+TEST_F(ContextTest, Set_storeIntersectionOf_and) {
+    EXPECT_EQ(context->execute("Set<Integer> create: odds;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: primes;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: numbers;"), "null");
+    EXPECT_EQ(context->execute("odds add: 1;"), "null");
+    EXPECT_EQ(context->execute("odds add: 3;"), "null");
+    EXPECT_EQ(context->execute("primes add: 2;"), "null");
+    EXPECT_EQ(context->execute("primes add: 3;"), "null");
+    EXPECT_EQ(context->execute("numbers add: 42;"), "null");
+    EXPECT_EQ(context->execute("numbers storeIntersectionOf: odds and: primes;"), "null");
+    EXPECT_EQ(context->execute("numbers get;"), "{3}");
+    EXPECT_EQ(context->execute("odds storeIntersectionOf: odds and: primes;"), "null");
+    EXPECT_EQ(context->execute("odds get;"), "{3}");
+}
+
+TEST_F(ContextTest, Set_storeDifferenceOf_and) {
+    EXPECT_EQ(context->execute("Set<Integer> create: odds;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: primes;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: numbers;"), "null");
+    EXPECT_EQ(context->execute("odds add: 1;"), "null");
+    EXPECT_EQ(context->execute("odds add: 3;"), "null");
+    EXPECT_EQ(context->execute("primes add: 2;"), "null");
+    EXPECT_EQ(context->execute("primes add: 3;"), "null");
+    EXPECT_EQ(context->execute("numbers add: 42;"), "null");
+    EXPECT_EQ(context->execute("numbers storeDifferenceOf: odds and: primes;"), "null");
+    EXPECT_EQ(context->execute("numbers get;"), "{1}");
+    EXPECT_EQ(context->execute("primes storeDifferenceOf: primes and: odds;"), "null");
+    EXPECT_EQ(context->execute("primes get;"), "{2}");
+}
+
+TEST_F(ContextTest, Set_intset) {
+    EXPECT_EQ(context->execute("Set<Integer> create: small;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: large;"), "null");
+    EXPECT_EQ(context->execute("small addAll: [512, -1, 3, 512];"), "null");
+    EXPECT_EQ(context->execute("large addAll: " + list_of_integers(512) + ";"), "null");
+    int64_t memory_usage = std::stoll(context->execute("large memoryUsage;"));
+    EXPECT_LT(memory_usage, 512 * int64_t(sizeof(IntegerInstance)));
+    EXPECT_EQ(context->execute("large add: 512;"), "null");
+    EXPECT_GT(std::stoll(context->execute("large memoryUsage;")),
+              memory_usage + 512 * int64_t(sizeof(IntegerInstance)));
+    EXPECT_EQ(context->execute("large size;"), "513");
+    EXPECT_EQ(context->execute("large contains? 512;"), "true");
+
+    // operations with a full set keep the receiver an integer set:
+    memory_usage = std::stoll(context->execute("small memoryUsage;"));
+    EXPECT_EQ(context->execute("small intersectWith: large;"), "{3,512}");
+    EXPECT_EQ(context->execute("large intersectWith: small;"), "{3,512}");
+    EXPECT_EQ(context->execute("small differenceWith: large;"), "{-1}");
+    EXPECT_EQ(context->execute("small unionWith: large;").substr(0, 7), "{-1,0,1");
+    EXPECT_EQ(std::stoll(context->execute("small memoryUsage;")), memory_usage);
+    EXPECT_EQ(context->execute("small storeIntersectionOf: large and: small;"), "null");
+    EXPECT_EQ(context->execute("small get;"), "{3,512}");
+    EXPECT_LE(std::stoll(context->execute("small memoryUsage;")), memory_usage);
+    EXPECT_EQ(context->execute("Set<Integer> create: union;"), "null");
+    EXPECT_EQ(context->execute("union storeUnionOf: small and: large;"), "null");
+    EXPECT_EQ(context->execute("union size;"), "513");
+    EXPECT_EQ(context->execute("union contains? 512;"), "true");
+    EXPECT_EQ(context->execute("small scanFrom: 4 count: 1;"), "({512},null)");
+    EXPECT_EQ(context->execute("small remove: 512;"), "null");
+    EXPECT_EQ(context->execute("small scanFirst: 0;"), "({},3)");
+}
+
+////////////////////////////////////////////////////// SortedSet ///////////////////////////////////////////////////////
+
+TEST_F(ContextTest, SortedSet_create) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores get;"), "{}");
+}
+
+TEST_F(ContextTest, SortedSet_createIfNotExists) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> createIfNotExists: scores;"), "null");
+    EXPECT_EQ(context->execute("scores get;"), "{}");
+    EXPECT_EQ(context->execute("SortedSet<Integer> createIfNotExists: scores;"), "null");
+    EXPECT_EQ(context->execute("scores get;"), "{}");
+}
+
+TEST_F(ContextTest, SortedSet_get) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores add: -7;"), "null");
+    EXPECT_EQ(context->execute("scores add: 13;"), "null");
+    EXPECT_EQ(context->execute("scores get;"), "{-7,13,42}");
+}
+
+TEST_F(ContextTest, SortedSet_isEmpty) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, SortedSet_contains) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores contains? 42;"), "false");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores contains? 42;"), "true");
+}
+
+TEST_F(ContextTest, SortedSet_size) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores size;"), "0");
+    EXPECT_EQ(context->execute("scores add: 1;"), "null");
+    EXPECT_EQ(context->execute("scores add: 2;"), "null");
+    EXPECT_EQ(context->execute("scores add: 3;"), "null");
+    EXPECT_EQ(context->execute("scores size;"), "3");
+    EXPECT_EQ(context->execute("scores add: 1;"), "null");
+    EXPECT_EQ(context->execute("scores size;"), "3");
+}
+
+TEST_F(ContextTest, SortedSet_add) {
+    EXPECT_EQ(context->execute("SortedSet<String> create: players;"), "null");
+    EXPECT_EQ(context->execute("players add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("players get;"), "{\"knuckle\"}");
+    EXPECT_EQ(context->execute("players add: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("players get;"), "{\"ball\",\"knuckle\"}");
+}
+
+TEST_F(ContextTest, SortedSet_addAll) {
+    EXPECT_EQ(context->execute("SortedSet<Character> create: players;"), "null");
+    EXPECT_EQ(context->execute("players addAll: ['k', ',', 'b'];"), "null");
+    EXPECT_EQ(context->execute("players get;"), "{',','b','k'}");
+    EXPECT_EQ(context->execute("players addAll: ['b','a'];"), "null");
+    EXPECT_EQ(context->execute("players get;"), "{',','a','b','k'}");
+}
+
+TEST_F(ContextTest, SortedSet_remove) {
+    EXPECT_EQ(context->execute("SortedSet<String> create: players;"), "null");
+    EXPECT_EQ(context->execute("players add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("players add: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("players remove: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("players get;"), "{\"ball\"}");
+    EXPECT_EQ(context->execute("players remove: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("players get;"), "{\"ball\"}");
+}
+
+TEST_F(ContextTest, SortedSet_rankOf) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores add: 7;"), "null");
+    EXPECT_EQ(context->execute("scores add: 13;"), "null");
+    EXPECT_EQ(context->execute("scores rankOf: 7;"), "0");
+    EXPECT_EQ(context->execute("scores rankOf: 13;"), "1");
+    EXPECT_EQ(context->execute("scores rankOf: 42;"), "2");
+    EXPECT_EQ(context->execute("scores rankOf: 43;"), "-1");
+}
+
+TEST_F(ContextTest, SortedSet_atRank) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores add: 7;"), "null");
+    EXPECT_EQ(context->execute("scores add: 13;"), "null");
+    EXPECT_EQ(context->execute("scores atRank: 0;"), "7");
+    EXPECT_EQ(context->execute("scores atRank: 1;"), "13");
+    EXPECT_EQ(context->execute("scores atRank: 2;"), "42");
+
+    // invalid rank:
+    EXPECT_EQ(context->execute("scores atRank: 3;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("scores atRank: -1;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, SortedSet_rangeFromRank_toRank) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores add: 7;"), "null");
+    EXPECT_EQ(context->execute("scores add: 13;"), "null");
+    EXPECT_EQ(context->execute("scores add: 99;"), "null");
+    EXPECT_EQ(context->execute("scores rangeFromRank: 1 toRank: 3;"), "{13,42}");
+    EXPECT_EQ(context->execute("scores rangeFromRank: 0 toRank: 4;"), "{7,13,42,99}");
+    EXPECT_EQ(context->execute("scores rangeFromRank: 2 toRank: 2;"), "{}");
+
+    // invalid ranks:
+    EXPECT_EQ(context->execute("scores rangeFromRank: -1 toRank: 2;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("scores rangeFromRank: 0 toRank: 5;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("scores rangeFromRank: 3 toRank: 2;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, SortedSet_countBetween_and) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores add: 42;"), "null");
+    EXPECT_EQ(context->execute("scores add: 7;"), "null");
+    EXPECT_EQ(context->execute("scores add: 13;"), "null");
+    EXPECT_EQ(context->execute("scores add: 99;"), "null");
+    EXPECT_EQ(context->execute("scores countBetween: 7 and: 42;"), "3");
+    EXPECT_EQ(context->execute("scores countBetween: 8 and: 98;"), "2");
+    EXPECT_EQ(context->execute("scores countBetween: 100 and: 200;"), "0");
+    EXPECT_EQ(context->execute("scores countBetween: 42 and: 7;"), "0");
+}
+
+TEST_F(ContextTest, SortedSet_clear) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores add: 1;"), "null");
+    EXPECT_EQ(context->execute("scores add: 2;"), "null");
+    EXPECT_EQ(context->execute("scores clear;"), "null");
+    EXPECT_EQ(context->execute("scores get;"), "{}");
+}
+
+/////////////////////////////////////////////////////// Multiset ///////////////////////////////////////////////////////
+
+TEST_F(ContextTest, Multiset_create) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{}");
+}
+
+TEST_F(ContextTest, Multiset_createIfNotExists) {
+    EXPECT_EQ(context->execute("Multiset<String> createIfNotExists: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("Multiset<String> createIfNotExists: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{\"knuckleball\"}");
+}
+
+TEST_F(ContextTest, Multiset_get) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{\"curveball\",\"knuckleball\",\"knuckleball\"}");
+}
+
+TEST_F(ContextTest, Multiset_isEmpty) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, Multiset_contains) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches contains? \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches contains? \"knuckleball\";"), "true");
+}
+
+TEST_F(ContextTest, Multiset_size) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches size;"), "0");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("pitches size;"), "3");
+}
+
+TEST_F(ContextTest, Multiset_countOf) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches countOf: \"knuckleball\";"), "0");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("pitches countOf: \"knuckleball\";"), "2");
+    EXPECT_EQ(context->execute("pitches countOf: \"curveball\";"), "1");
+}
+
+TEST_F(ContextTest, Multiset_add) {
+    EXPECT_EQ(context->execute("Multiset<Float> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches add: 4.2;"), "null");
+    EXPECT_EQ(context->execute("pitches add: 4.2;"), "null");
+    EXPECT_EQ(context->execute("pitches add: 2.1;"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{2.100,4.200,4.200}");
+}
+
+TEST_F(ContextTest, Multiset_addAll) {
+    EXPECT_EQ(context->execute("Multiset<Float> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches addAll: [4.2, 4.2, 2.1];"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{2.100,4.200,4.200}");
+    EXPECT_EQ(context->execute("pitches size;"), "3");
+}
+
+TEST_F(ContextTest, Multiset_remove) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches remove: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{\"knuckleball\"}");
+    EXPECT_EQ(context->execute("pitches remove: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches remove: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{}");
+    EXPECT_EQ(context->execute("pitches size;"), "0");
+}
+
+TEST_F(ContextTest, Multiset_removeAll) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("pitches removeAll: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{\"curveball\"}");
+    EXPECT_EQ(context->execute("pitches size;"), "1");
+}
+
+TEST_F(ContextTest, Multiset_clear) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("pitches clear;"), "null");
+    EXPECT_EQ(context->execute("pitches get;"), "{}");
+    EXPECT_EQ(context->execute("pitches size;"), "0");
+}
 
 ////////////////////////////////////////////////////// Dictionary //////////////////////////////////////////////////////
 
@@ -1217,6 +2117,38 @@ TEST_F(ContextTest, Dictionary_getValueForKey) {
     EXPECT_EQ(context->execute("ages getValueForKey: \"\";"), "null");
 }
 
+TEST_F(ContextTest, Dictionary_getValuesForKeys) {
+    EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
+    EXPECT_EQ(context->execute("ages getValuesForKeys: [];"), "[]");
+    EXPECT_EQ(context->execute("ages associateValue: 21 withKey: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("ages associateValue: 42 withKey: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("ages getValuesForKeys: [\"ball\", \"\", \"knuckle\", \"ball\"];"), "[42,null,21,42]");
+}
+
+TEST_F(ContextTest, Dictionary_scanFirst) {
+    EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
+    EXPECT_EQ(context->execute("ages scanFirst: 1;"), "((),null)");
+    EXPECT_EQ(context->execute("ages associateValues: [21, 42] withKeys: [\"knuckle\", \"ball\"];"), "null");
+    EXPECT_EQ(context->execute("ages scanFirst: 1;"), "(((\"ball\",42)),\"knuckle\")");
+    EXPECT_EQ(context->execute("ages scanFirst: 2;"), "(((\"ball\",42),(\"knuckle\",21)),null)");
+}
+
+TEST_F(ContextTest, Dictionary_scanFrom_count) {
+    EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
+    EXPECT_EQ(context->execute("ages associateValues: [21, 42, 84] withKeys: [\"knuckle\", \"ball\", \"pitch\"];"),
+              "null");
+    EXPECT_EQ(context->execute("ages scanFrom: \"knuckle\" count: 1;"), "(((\"knuckle\",21)),\"pitch\")");
+    EXPECT_EQ(context->execute("ages scanFrom: \"c\" count: 5;"), "(((\"knuckle\",21),(\"pitch\",84)),null)");
+    EXPECT_EQ(context->execute("ages scanFrom: \"z\" count: 5;"), "((),null)");
+
+    // float cursors are not rounded to the float precision:
+    EXPECT_EQ(context->execute("Context setFloatComparisonTolerance: 1e-6;"), "null");
+    EXPECT_EQ(context->execute("Dictionary<Float, Integer> create: ranks;"), "null");
+    EXPECT_EQ(context->execute("ranks associateValues: [1, 2] withKeys: [1.0001, 1.0002];"), "null");
+    EXPECT_EQ(context->execute("ranks scanFirst: 1;"), "(((1.000,1)),1.00020003)");
+    EXPECT_EQ(context->execute("ranks scanFrom: 1.00020003 count: 1;"), "(((1.000,2)),null)");
+}
+
 TEST_F(ContextTest, Dictionary_associateValue_withKey) {
     EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
     EXPECT_EQ(context->execute("ages associateValue: 42 withKey: \"knuckle\";"), "null");
@@ -1225,6 +2157,16 @@ TEST_F(ContextTest, Dictionary_associateValue_withKey) {
     EXPECT_EQ(context->execute("ages get;"), "((\"ball\",21),(\"knuckle\",42))");
 }
 
+TEST_F(ContextTest, Dictionary_associateValues_withKeys) {
+    EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
+    EXPECT_EQ(context->execute("ages associateValues: [] withKeys: [];"), "null");
+    EXPECT_EQ(context->execute("ages get;"), "()");
+    EXPECT_EQ(context->execute("ages associateValues: [42, 21] withKeys: [\"knuckle\", \"ball\"];"), "null");
+    EXPECT_EQ(context->execute("ages get;"), "((\"ball\",21),(\"knuckle\",42))");
+    EXPECT_EQ(context->execute("ages associateValues: [1, 2] withKeys: [\"ball\", \"ball\"];"), "null");
+    EXPECT_EQ(context->execute("ages get;"), "((\"ball\",2),(\"knuckle\",42))");
+}
+
 TEST_F(ContextTest, Dictionary_removeKey) {
     EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
     EXPECT_EQ(context->execute("ages associateValue: 21 withKey: \"knuckle\";"), "null");
@@ -1235,6 +2177,42 @@ TEST_F(ContextTest, Dictionary_removeKey) {
     EXPECT_EQ(context->execute("ages get;"), "((\"ball\",42),(\"knuckle\",21))");
 }
 
+TEST_F(ContextTest, Dictionary_incrementValueForKey_by) {
+    // integer values:
+    EXPECT_EQ(context->execute("Dictionary<String, Integer> create: hits;"), "null");
+    EXPECT_EQ(context->execute("hits incrementValueForKey: \"knuckle\" by: 1;"), "1");
+    EXPECT_EQ(context->execute("hits incrementValueForKey: \"knuckle\" by: 41;"), "42");
+    EXPECT_EQ(context->execute("hits incrementValueForKey: \"ball\" by: 7;"), "7");
+    EXPECT_EQ(context->execute("hits get;"), "((\"ball\",7),(\"knuckle\",42))");
+
+    // float values:
+    EXPECT_EQ(context->execute("Dictionary<String, Float> create: latencies;"), "null");
+    EXPECT_EQ(context->execute("latencies incrementValueForKey: \"knuckle\" by: 0.5;"), "0.500");
+    EXPECT_EQ(context->execute("latencies incrementValueForKey: \"knuckle\" by: 1.25;"), "1.750");
+    EXPECT_EQ(context->execute("latencies get;"), "((\"knuckle\",1.750))");
+
+    // non-numeric values:
+    EXPECT_EQ(context->execute("Dictionary<String, String> create: names;"), "null");
+    EXPECT_EQ(context->execute("names incrementValueForKey: \"knuckle\" by: 1;"), EXC_INVALID_MESSAGE);
+}
+
+TEST_F(ContextTest, Dictionary_decrementValueForKey_by) {
+    // integer values:
+    EXPECT_EQ(context->execute("Dictionary<String, Integer> create: stock;"), "null");
+    EXPECT_EQ(context->execute("stock decrementValueForKey: \"knuckle\" by: 1;"), "-1");
+    EXPECT_EQ(context->execute("stock associateValue: 42 withKey: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("stock decrementValueForKey: \"ball\" by: 2;"), "40");
+    EXPECT_EQ(context->execute("stock get;"), "((\"ball\",40),(\"knuckle\",-1))");
+
+    // float values:
+    EXPECT_EQ(context->execute("Dictionary<String, Float> create: balances;"), "null");
+    EXPECT_EQ(context->execute("balances decrementValueForKey: \"knuckle\" by: 0.5;"), "-0.500");
+
+    // non-numeric values:
+    EXPECT_EQ(context->execute("Dictionary<String, Boolean> create: flags;"), "null");
+    EXPECT_EQ(context->execute("flags decrementValueForKey: \"knuckle\" by: 1;"), EXC_INVALID_MESSAGE);
+}
+
 TEST_F(ContextTest, Dictionary_clear) {
     EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
     EXPECT_EQ(context->execute("ages associateValue: 21 withKey: \"knuckle\";"), "null");
@@ -1244,6 +2222,750 @@ TEST_F(ContextTest, Dictionary_clear) {
     EXPECT_EQ(context->execute("ages get;"), "()");
 }
 
+/////////////////////////////////////////////////// Multidictionary ////////////////////////////////////////////////////
+
+TEST_F(ContextTest, Multidictionary_create) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings get;"), "()");
+}
+
+TEST_F(ContextTest, Multidictionary_createIfNotExists) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> createIfNotExists: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> createIfNotExists: innings;"), "null");
+    EXPECT_EQ(context->execute("innings get;"), "((\"knuckleball\",42))");
+}
+
+TEST_F(ContextTest, Multidictionary_get) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 7 withKey: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("innings get;"), "((\"curveball\",7),(\"knuckleball\",42),(\"knuckleball\",21))");
+}
+
+TEST_F(ContextTest, Multidictionary_isEmpty) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, Multidictionary_containsKey) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings containsKey? \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings containsKey? \"knuckleball\";"), "true");
+}
+
+TEST_F(ContextTest, Multidictionary_size) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings size;"), "0");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 7 withKey: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("innings size;"), "3");
+}
+
+TEST_F(ContextTest, Multidictionary_keys) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 7 withKey: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("innings keys;"), "[\"curveball\",\"knuckleball\"]");
+}
+
+TEST_F(ContextTest, Multidictionary_values) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 7 withKey: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("innings values;"), "[7,42,21]");
+}
+
+TEST_F(ContextTest, Multidictionary_getValuesForKey) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings getValuesForKey: \"knuckleball\";"), "[]");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings getValuesForKey: \"knuckleball\";"), "[42,21]");
+}
+
+TEST_F(ContextTest, Multidictionary_countValuesForKey) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings countValuesForKey: \"knuckleball\";"), "0");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings countValuesForKey: \"knuckleball\";"), "2");
+}
+
+TEST_F(ContextTest, Multidictionary_associateValue_withKey) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings get;"), "((\"knuckleball\",42),(\"knuckleball\",42))");
+}
+
+TEST_F(ContextTest, Multidictionary_removeValue_withKey) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings removeValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings getValuesForKey: \"knuckleball\";"), "[21,42]");
+    EXPECT_EQ(context->execute("innings removeValue: 7 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings removeValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings removeValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings containsKey? \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("innings size;"), "0");
+}
+
+TEST_F(ContextTest, Multidictionary_removeKey) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 21 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 7 withKey: \"curveball\";"), "null");
+    EXPECT_EQ(context->execute("innings removeKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings get;"), "((\"curveball\",7))");
+    EXPECT_EQ(context->execute("innings size;"), "1");
+}
+
+TEST_F(ContextTest, Multidictionary_clear) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings associateValue: 42 withKey: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("innings clear;"), "null");
+    EXPECT_EQ(context->execute("innings get;"), "()");
+    EXPECT_EQ(context->execute("innings size;"), "0");
+}
+
+//////////////////////////////////////////////////// PriorityQueue /////////////////////////////////////////////////////
+
+TEST_F(ContextTest, PriorityQueue_create) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen get;"), "[]");
+}
+
+TEST_F(ContextTest, PriorityQueue_createIfNotExists) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> createIfNotExists: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("PriorityQueue<String> createIfNotExists: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen get;"), "[\"knuckleball\"]");
+}
+
+TEST_F(ContextTest, PriorityQueue_get) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckle\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"ball\" withPriority: 7;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: 21;"), "null");
+    EXPECT_EQ(context->execute("bullpen get;"), "[\"ball\",\"knuckleball\",\"knuckle\"]");
+    EXPECT_EQ(context->execute("bullpen size;"), "3");
+}
+
+TEST_F(ContextTest, PriorityQueue_isEmpty) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, PriorityQueue_size) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen size;"), "0");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen size;"), "2");
+}
+
+TEST_F(ContextTest, PriorityQueue_push_withPriority) {
+    EXPECT_EQ(context->execute("PriorityQueue<Integer> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: 1 withPriority: 4.2;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: 2 withPriority: -4.2;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: 3 withPriority: 4.2;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: 4 withPriority: 0;"), "null");
+    EXPECT_EQ(context->execute("bullpen get;"), "[2,4,1,3]");
+}
+
+TEST_F(ContextTest, PriorityQueue_peekMin) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen peekMin;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckle\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"ball\" withPriority: 7;"), "null");
+    EXPECT_EQ(context->execute("bullpen peekMin;"), "\"ball\"");
+    EXPECT_EQ(context->execute("bullpen size;"), "2");
+}
+
+TEST_F(ContextTest, PriorityQueue_popMin) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen popMin;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckle\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"ball\" withPriority: 7;"), "null");
+    EXPECT_EQ(context->execute("bullpen popMin;"), "\"ball\"");
+    EXPECT_EQ(context->execute("bullpen popMin;"), "\"knuckle\"");
+    EXPECT_EQ(context->execute("bullpen popMin;"), "null");
+}
+
+TEST_F(ContextTest, PriorityQueue_clear) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: 42;"), "null");
+    EXPECT_EQ(context->execute("bullpen clear;"), "null");
+    EXPECT_EQ(context->execute("bullpen get;"), "[]");
+}
+
+//////////////////////////////////////////////////////// Stream ////////////////////////////////////////////////////////
+
+TEST_F(ContextTest, Stream_create) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays get;"), "()");
+}
+
+TEST_F(ContextTest, Stream_createIfNotExists) {
+    EXPECT_EQ(context->execute("Stream<String> createIfNotExists: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckleball\";"), "0");
+    EXPECT_EQ(context->execute("Stream<String> createIfNotExists: plays;"), "null");
+    EXPECT_EQ(context->execute("plays get;"), "((0,\"knuckleball\"))");
+}
+
+TEST_F(ContextTest, Stream_get) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays get;"), "((0,\"knuckle\"),(1,\"ball\"))");
+}
+
+TEST_F(ContextTest, Stream_isEmpty) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("plays append: \"knuckleball\";"), "0");
+    EXPECT_EQ(context->execute("plays isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, Stream_size) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays size;"), "0");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays size;"), "2");
+}
+
+TEST_F(ContextTest, Stream_firstId) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays firstId;"), "-1");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays firstId;"), "0");
+    EXPECT_EQ(context->execute("plays trimBefore: 1;"), "null");
+    EXPECT_EQ(context->execute("plays firstId;"), "1");
+}
+
+TEST_F(ContextTest, Stream_lastId) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays lastId;"), "-1");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays lastId;"), "1");
+}
+
+TEST_F(ContextTest, Stream_append) {
+    EXPECT_EQ(context->execute("Stream<Integer> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: 42;"), "0");
+    EXPECT_EQ(context->execute("plays append: 42;"), "1");
+    EXPECT_EQ(context->execute("plays clear;"), "null");
+    EXPECT_EQ(context->execute("plays append: 42;"), "2");
+    EXPECT_EQ(context->execute("plays get;"), "((2,42))");
+}
+
+TEST_F(ContextTest, Stream_readFrom_count) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays append: \"knuckleball\";"), "2");
+    EXPECT_EQ(context->execute("plays readFrom: 1 count: 1;"), "((1,\"ball\"))");
+    EXPECT_EQ(context->execute("plays readFrom: 1 count: 42;"), "((1,\"ball\"),(2,\"knuckleball\"))");
+    EXPECT_EQ(context->execute("plays readFrom: 3 count: 42;"), "()");
+    EXPECT_EQ(context->execute("plays readFrom: 0 count: 0;"), "()");
+    EXPECT_EQ(context->execute("plays size;"), "3");
+}
+
+TEST_F(ContextTest, Stream_readNext_forConsumer) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays append: \"knuckleball\";"), "2");
+    EXPECT_EQ(context->execute("plays readNext: 2 forConsumer: \"scores\";"), "((0,\"knuckle\"),(1,\"ball\"))");
+    EXPECT_EQ(context->execute("plays readNext: 2 forConsumer: \"stats\";"), "((0,\"knuckle\"),(1,\"ball\"))");
+    EXPECT_EQ(context->execute("plays readNext: 2 forConsumer: \"scores\";"), "((2,\"knuckleball\"))");
+    EXPECT_EQ(context->execute("plays readNext: 2 forConsumer: \"scores\";"), "()");
+    EXPECT_EQ(context->execute("plays append: \"curveball\";"), "3");
+    EXPECT_EQ(context->execute("plays readNext: 2 forConsumer: \"scores\";"), "((3,\"curveball\"))");
+    EXPECT_EQ(context->execute("plays size;"), "4");
+}
+
+TEST_F(ContextTest, Stream_offsetOf) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays offsetOf: \"scores\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays readNext: 1 forConsumer: \"scores\";"), "((0,\"knuckle\"))");
+    EXPECT_EQ(context->execute("plays offsetOf: \"scores\";"), "1");
+    EXPECT_EQ(context->execute("plays offsetOf: \"stats\";"), "0");
+}
+
+TEST_F(ContextTest, Stream_setOffset_forConsumer) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays setOffset: 1 forConsumer: \"scores\";"), "null");
+    EXPECT_EQ(context->execute("plays offsetOf: \"scores\";"), "1");
+    EXPECT_EQ(context->execute("plays readNext: 42 forConsumer: \"scores\";"), "((1,\"ball\"))");
+}
+
+TEST_F(ContextTest, Stream_trimBefore) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("plays append: \"ball\";"), "1");
+    EXPECT_EQ(context->execute("plays trimBefore: 1;"), "null");
+    EXPECT_EQ(context->execute("plays get;"), "((1,\"ball\"))");
+    EXPECT_EQ(context->execute("plays readNext: 42 forConsumer: \"scores\";"), "((1,\"ball\"))");
+    EXPECT_EQ(context->execute("plays trimBefore: 42;"), "null");
+    EXPECT_EQ(context->execute("plays get;"), "()");
+    EXPECT_EQ(context->execute("plays append: \"knuckleball\";"), "2");
+}
+
+TEST_F(ContextTest, Stream_clear) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays append: \"knuckleball\";"), "0");
+    EXPECT_EQ(context->execute("plays readNext: 1 forConsumer: \"scores\";"), "((0,\"knuckleball\"))");
+    EXPECT_EQ(context->execute("plays clear;"), "null");
+    EXPECT_EQ(context->execute("plays get;"), "()");
+    EXPECT_EQ(context->execute("plays offsetOf: \"scores\";"), "0");
+}
+
+//////////////////////////////////////////////////////// Bitmap ////////////////////////////////////////////////////////
+
+TEST_F(ContextTest, Bitmap_create) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{}");
+}
+
+TEST_F(ContextTest, Bitmap_createIfNotExists) {
+    EXPECT_EQ(context->execute("Bitmap createIfNotExists: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{}");
+    EXPECT_EQ(context->execute("Bitmap createIfNotExists: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{}");
+}
+
+TEST_F(ContextTest, Bitmap_get) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 7;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 100000;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{7,42,100000}");
+}
+
+TEST_F(ContextTest, Bitmap_isEmpty) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, Bitmap_getBit) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors getBit: 42;"), "false");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors getBit: 42;"), "true");
+    EXPECT_EQ(context->execute("visitors getBit: 43;"), "false");
+}
+
+TEST_F(ContextTest, Bitmap_setBit) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 0;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{0,42}");
+}
+
+TEST_F(ContextTest, Bitmap_clearBit) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 7;"), "null");
+    EXPECT_EQ(context->execute("visitors clearBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors clearBit: 43;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{7}");
+}
+
+TEST_F(ContextTest, Bitmap_countOnes) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors countOnes;"), "0");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 7;"), "null");
+    EXPECT_EQ(context->execute("visitors countOnes;"), "2");
+}
+
+TEST_F(ContextTest, Bitmap_countOnesFrom_to) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 7;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 100000;"), "null");
+    EXPECT_EQ(context->execute("visitors countOnesFrom: 0 to: 42;"), "1");
+    EXPECT_EQ(context->execute("visitors countOnesFrom: 7 to: 43;"), "2");
+    EXPECT_EQ(context->execute("visitors countOnesFrom: 8 to: 200000;"), "2");
+    EXPECT_EQ(context->execute("visitors countOnesFrom: 42 to: 42;"), "0");
+    EXPECT_EQ(context->execute("visitors countOnesFrom: 43 to: 42;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Bitmap_firstSet) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors firstSet;"), "-1");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 7;"), "null");
+    EXPECT_EQ(context->execute("visitors firstSet;"), "7");
+}
+
+TEST_F(ContextTest, Bitmap_andWith) {
+    EXPECT_EQ(context->execute("Bitmap create: monday;"), "null");
+    EXPECT_EQ(context->execute("Bitmap create: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday setBit: 1;"), "null");
+    EXPECT_EQ(context->execute("monday setBit: 2;"), "null");
+    EXPECT_EQ(context->execute("tuesday setBit: 2;"), "null");
+    EXPECT_EQ(context->execute("tuesday setBit: 3;"), "null");
+    EXPECT_EQ(context->execute("monday andWith: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday get;"), "{2}");
+    EXPECT_EQ(context->execute("tuesday get;"), "{2,3}");
+}
+
+TEST_F(ContextTest, Bitmap_orWith) {
+    EXPECT_EQ(context->execute("Bitmap create: monday;"), "null");
+    EXPECT_EQ(context->execute("Bitmap create: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday setBit: 1;"), "null");
+    EXPECT_EQ(context->execute("monday setBit: 2;"), "null");
+    EXPECT_EQ(context->execute("tuesday setBit: 2;"), "null");
+    EXPECT_EQ(context->execute("tuesday setBit: 3;"), "null");
+    EXPECT_EQ(context->execute("monday orWith: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday get;"), "{1,2,3}");
+    EXPECT_EQ(context->execute("tuesday get;"), "{2,3}");
+}
+
+TEST_F(ContextTest, Bitmap_xorWith) {
+    EXPECT_EQ(context->execute("Bitmap create: monday;"), "null");
+    EXPECT_EQ(context->execute("Bitmap create: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday setBit: 1;"), "null");
+    EXPECT_EQ(context->execute("monday setBit: 2;"), "null");
+    EXPECT_EQ(context->execute("tuesday setBit: 2;"), "null");
+    EXPECT_EQ(context->execute("tuesday setBit: 3;"), "null");
+    EXPECT_EQ(context->execute("monday xorWith: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday get;"), "{1,3}");
+    EXPECT_EQ(context->execute("tuesday get;"), "{2,3}");
+}
+
+TEST_F(ContextTest, Bitmap_clear) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 42;"), "null");
+    EXPECT_EQ(context->execute("visitors setBit: 7;"), "null");
+    EXPECT_EQ(context->execute("visitors clear;"), "null");
+    EXPECT_EQ(context->execute("visitors get;"), "{}");
+}
+
+////////////////////////////////////////////////////// TimeSeries //////////////////////////////////////////////////////
+
+TEST_F(ContextTest, TimeSeries_create) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds get;"), "()");
+}
+
+TEST_F(ContextTest, TimeSeries_createIfNotExists) {
+    EXPECT_EQ(context->execute("TimeSeries createIfNotExists: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("TimeSeries createIfNotExists: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds get;"), "((1000,42.000))");
+}
+
+TEST_F(ContextTest, TimeSeries_get) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 4.2 at: 1010;"), "null");
+    EXPECT_EQ(context->execute("speeds get;"), "((1000,42.000),(1010,4.200))");
+}
+
+TEST_F(ContextTest, TimeSeries_isEmpty) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, TimeSeries_size) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds size;"), "0");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds size;"), "2");
+}
+
+TEST_F(ContextTest, TimeSeries_append_at) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 85.5 at: -10;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 85.5 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: -1.25 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1500;"), "null");
+    EXPECT_EQ(context->execute("speeds get;"), "((-10,85.500),(1000,85.500),(1000,-1.250),(1500,42.000))");
+}
+
+TEST_F(ContextTest, TimeSeries_rangeFrom_to) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 85.5 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 90 at: 1010;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 70.25 at: 1020;"), "null");
+    EXPECT_EQ(context->execute("speeds rangeFrom: 1005 to: 1020;"), "((1010,90.000))");
+    EXPECT_EQ(context->execute("speeds rangeFrom: 1000 to: 1021;"), "((1000,85.500),(1010,90.000),(1020,70.250))");
+    EXPECT_EQ(context->execute("speeds rangeFrom: 1020 to: 1000;"), "()");
+}
+
+TEST_F(ContextTest, TimeSeries_avgFrom_to_bucket) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 80 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 90 at: 1010;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 70 at: 1020;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 60 at: 1045;"), "null");
+    EXPECT_EQ(context->execute("speeds avgFrom: 1000 to: 1100 bucket: 20;"),
+              "((1000,85.000),(1020,70.000),(1040,60.000))");
+    EXPECT_EQ(context->execute("speeds avgFrom: 1010 to: 1045 bucket: 100;"), "((1010,80.000))");
+}
+
+TEST_F(ContextTest, TimeSeries_clear) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds clear;"), "null");
+    EXPECT_EQ(context->execute("speeds get;"), "()");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 0;"), "null");
+}
+
+///////////////////////////////////////////////////// HyperLogLog //////////////////////////////////////////////////////
+
+TEST_F(ContextTest, HyperLogLog_create) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors estimate;"), "0");
+}
+
+TEST_F(ContextTest, HyperLogLog_createIfNotExists) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> createIfNotExists: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors estimate;"), "0");
+    EXPECT_EQ(context->execute("HyperLogLog<String> createIfNotExists: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors estimate;"), "0");
+}
+
+TEST_F(ContextTest, HyperLogLog_isEmpty) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("visitors add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("visitors isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, HyperLogLog_add) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("visitors add: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("visitors add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("visitors estimate;"), "2");
+}
+
+TEST_F(ContextTest, HyperLogLog_estimate) {
+    EXPECT_EQ(context->execute("HyperLogLog<Integer> create: ids;"), "null");
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(context->execute("ids add: " + std::to_string(i % 100) + ";"), "null");
+    EXPECT_EQ(context->execute("ids estimate;"), "100");
+}
+
+TEST_F(ContextTest, HyperLogLog_mergeWith) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: monday;"), "null");
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("monday add: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("tuesday add: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("tuesday add: \"pitch\";"), "null");
+    EXPECT_EQ(context->execute("monday mergeWith: tuesday;"), "null");
+    EXPECT_EQ(context->execute("monday estimate;"), "3");
+    EXPECT_EQ(context->execute("tuesday estimate;"), "2");
+
+    // sketches agree across changes of the float precision:
+    EXPECT_EQ(context->execute("HyperLogLog<Float> create: before;"), "null");
+    EXPECT_EQ(context->execute("HyperLogLog<Float> create: after;"), "null");
+    EXPECT_EQ(context->execute("Context setFloatPrecision: 2;"), "null");
+    EXPECT_EQ(context->execute("before add: 1.001;"), "null");
+    EXPECT_EQ(context->execute("before add: 1.002;"), "null");
+    EXPECT_EQ(context->execute("before add: 1.003;"), "null");
+    EXPECT_EQ(context->execute("before estimate;"), "3");
+    EXPECT_EQ(context->execute("Context setFloatPrecision: 6;"), "null");
+    EXPECT_EQ(context->execute("after add: 1.001;"), "null");
+    EXPECT_EQ(context->execute("after add: 1.004;"), "null");
+    EXPECT_EQ(context->execute("after mergeWith: before;"), "null");
+    EXPECT_EQ(context->execute("after estimate;"), "4");
+}
+
+TEST_F(ContextTest, HyperLogLog_clear) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("visitors clear;"), "null");
+    EXPECT_EQ(context->execute("visitors estimate;"), "0");
+}
+
+///////////////////////////////////////////////////// BloomFilter //////////////////////////////////////////////////////
+
+TEST_F(ContextTest, BloomFilter_create_withCapacity_falsePositiveRate) {
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("seen size;"), "0");
+}
+
+TEST_F(ContextTest, BloomFilter_createIfNotExists_withCapacity_falsePositiveRate) {
+    EXPECT_EQ(context->execute("BloomFilter<String> createIfNotExists: seen withCapacity: 1000 "
+                               "falsePositiveRate: 0.01;"), "null");
+    EXPECT_EQ(context->execute("seen add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("BloomFilter<String> createIfNotExists: seen withCapacity: 1000 "
+                               "falsePositiveRate: 0.01;"), "null");
+    EXPECT_EQ(context->execute("seen size;"), "1");
+}
+
+TEST_F(ContextTest, BloomFilter_isEmpty) {
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("seen isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("seen add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("seen isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, BloomFilter_size) {
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("seen size;"), "0");
+    EXPECT_EQ(context->execute("seen add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("seen add: \"ball\";"), "null");
+    EXPECT_EQ(context->execute("seen add: \"knuckle\";"), "null");
+    EXPECT_EQ(context->execute("seen size;"), "2");
+}
+
+TEST_F(ContextTest, BloomFilter_add) {
+    EXPECT_EQ(context->execute("BloomFilter<Integer> create: ids withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("ids add: 42;"), "null");
+    EXPECT_EQ(context->execute("ids add: 42;"), "null");
+    EXPECT_EQ(context->execute("ids mightContain? 42;"), "true");
+}
+
+TEST_F(ContextTest, BloomFilter_mightContain) {
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("seen mightContain? \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("seen add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("seen mightContain? \"knuckleball\";"), "true");
+
+    // the answer does not depend on the float precision:
+    EXPECT_EQ(context->execute("BloomFilter<Float> create: ratios withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("ratios add: 1.2345;"), "null");
+    EXPECT_EQ(context->execute("ratios add: -0.0;"), "null");
+    EXPECT_EQ(context->execute("Context setFloatPrecision: 6;"), "null");
+    EXPECT_EQ(context->execute("ratios mightContain? 1.2345;"), "true");
+    EXPECT_EQ(context->execute("ratios mightContain? 0.0;"), "true");
+    EXPECT_EQ(context->execute("ratios size;"), "2");
+}
+
+TEST_F(ContextTest, BloomFilter_clear) {
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("seen add: \"knuckleball\";"), "null");
+    EXPECT_EQ(context->execute("seen clear;"), "null");
+    EXPECT_EQ(context->execute("seen mightContain? \"knuckleball\";"), "false");
+    EXPECT_EQ(context->execute("seen size;"), "0");
+}
+
+//////////////////////////////////////////////////// CountMinSketch ////////////////////////////////////////////////////
+
+TEST_F(ContextTest, CountMinSketch_create_withWidth_depth) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits total;"), "0");
+    EXPECT_EQ(context->execute("hits topK;"), EXC_INVALID_MESSAGE);
+}
+
+TEST_F(ContextTest, CountMinSketch_create_withWidth_depth_topK) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4 topK: 2;"), "null");
+    EXPECT_EQ(context->execute("hits total;"), "0");
+    EXPECT_EQ(context->execute("hits topK;"), "[]");
+}
+
+TEST_F(ContextTest, CountMinSketch_createIfNotExists_withWidth_depth) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> createIfNotExists: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits increment: \"knuckleball\" by: 1;"), "1");
+    EXPECT_EQ(context->execute("CountMinSketch<String> createIfNotExists: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits total;"), "1");
+}
+
+TEST_F(ContextTest, CountMinSketch_createIfNotExists_withWidth_depth_topK) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> createIfNotExists: hits withWidth: 1024 depth: 4 topK: 2;"),
+              "null");
+    EXPECT_EQ(context->execute("hits increment: \"knuckleball\" by: 1;"), "1");
+    EXPECT_EQ(context->execute("CountMinSketch<String> createIfNotExists: hits withWidth: 1024 depth: 4 topK: 2;"),
+              "null");
+    EXPECT_EQ(context->execute("hits topK;"), "[\"knuckleball\"]");
+}
+
+TEST_F(ContextTest, CountMinSketch_isEmpty) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits isEmpty?;"), "true");
+    EXPECT_EQ(context->execute("hits increment: \"knuckleball\" by: 1;"), "1");
+    EXPECT_EQ(context->execute("hits isEmpty?;"), "false");
+}
+
+TEST_F(ContextTest, CountMinSketch_total) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits increment: \"knuckle\" by: 40;"), "40");
+    EXPECT_EQ(context->execute("hits increment: \"ball\" by: 2;"), "2");
+    EXPECT_EQ(context->execute("hits total;"), "42");
+}
+
+TEST_F(ContextTest, CountMinSketch_increment_by) {
+    EXPECT_EQ(context->execute("CountMinSketch<Integer> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits increment: 42 by: 1;"), "1");
+    EXPECT_EQ(context->execute("hits increment: 42 by: 41;"), "42");
+    EXPECT_EQ(context->execute("hits increment: 7 by: 0;"), "0");
+}
+
+TEST_F(ContextTest, CountMinSketch_estimate) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits estimate: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("hits increment: \"knuckle\" by: 42;"), "42");
+    EXPECT_EQ(context->execute("hits estimate: \"knuckle\";"), "42");
+
+    // estimates do not depend on the float precision:
+    EXPECT_EQ(context->execute("CountMinSketch<Float> create: ratios withWidth: 1024 depth: 4 topK: 2;"), "null");
+    EXPECT_EQ(context->execute("Context setFloatPrecision: 2;"), "null");
+    EXPECT_EQ(context->execute("ratios increment: 1.001 by: 1;"), "1");
+    EXPECT_EQ(context->execute("ratios increment: 1.002 by: 2;"), "2");
+    EXPECT_EQ(context->execute("Context setFloatPrecision: 6;"), "null");
+    EXPECT_EQ(context->execute("ratios estimate: 1.001;"), "1");
+    EXPECT_EQ(context->execute("ratios estimate: 1.002;"), "2");
+    EXPECT_EQ(context->execute("ratios topK;"), "[1.002000,1.001000]");
+}
+
+TEST_F(ContextTest, CountMinSketch_topK) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4 topK: 2;"), "null");
+    EXPECT_EQ(context->execute("hits increment: \"knuckle\" by: 1;"), "1");
+    EXPECT_EQ(context->execute("hits increment: \"ball\" by: 3;"), "3");
+    EXPECT_EQ(context->execute("hits increment: \"pitch\" by: 2;"), "2");
+    EXPECT_EQ(context->execute("hits topK;"), "[\"ball\",\"pitch\"]");
+    EXPECT_EQ(context->execute("hits increment: \"knuckle\" by: 4;"), "5");
+    EXPECT_EQ(context->execute("hits topK;"), "[\"knuckle\",\"ball\"]");
+}
+
+TEST_F(ContextTest, CountMinSketch_clear) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4 topK: 2;"), "null");
+    EXPECT_EQ(context->execute("hits increment: \"knuckle\" by: 42;"), "42");
+    EXPECT_EQ(context->execute("hits clear;"), "null");
+    EXPECT_EQ(context->execute("hits estimate: \"knuckle\";"), "0");
+    EXPECT_EQ(context->execute("hits total;"), "0");
+    EXPECT_EQ(context->execute("hits topK;"), "[]");
+}
+
 ///////////////////////////////////////////////////// Syntax errors ////////////////////////////////////////////////////
 
 TEST_F(ContextTest, SyntaxError_for_invalid_actor) {
@@ -1326,9 +3048,50 @@ TEST_F(ContextTest, RuntimeError_for_wrong_number_of_arguments) {
     EXPECT_EQ(context->execute("Set<String> create: ids;"), "null");
     EXPECT_EQ(context->execute("ids isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
 
+    // SortedSet
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("scores isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // Multiset
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("pitches isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
     // Dictionary
     EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
     EXPECT_EQ(context->execute("ages isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // Multidictionary
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("innings isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // PriorityQueue
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("bullpen isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // Stream
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("plays isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // Bitmap
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("visitors isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // TimeSeries
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("speeds isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // HyperLogLog
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: uniques;"), "null");
+    EXPECT_EQ(context->execute("uniques isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // BloomFilter
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("seen isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
+
+    // CountMinSketch
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("hits isEmpty? 42;"), EXC_WRONG_NUMBER_OF_ARGUMENTS);
 }
 
 TEST_F(ContextTest, RuntimeError_for_variable_name_already_used) {
@@ -1366,9 +3129,53 @@ TEST_F(ContextTest, RuntimeError_for_variable_name_already_used) {
     EXPECT_EQ(context->execute("Set<String> create: ids;"), "null");
     EXPECT_EQ(context->execute("Set<String> create: ids;"), EXC_VARIABLE_NAME_ALREADY_USED);
 
+    // SortedSet
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // Multiset
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
     // Dictionary
     EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), "null");
     EXPECT_EQ(context->execute("Dictionary<String, Integer> create: ages;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // Multidictionary
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"),
+              EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // PriorityQueue
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // Stream
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // Bitmap
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // TimeSeries
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // HyperLogLog
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: uniques;"), "null");
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: uniques;"), EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // BloomFilter
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              EXC_VARIABLE_NAME_ALREADY_USED);
+
+    // CountMinSketch
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"),
+              EXC_VARIABLE_NAME_ALREADY_USED);
 }
 
 TEST_F(ContextTest, Boolean_RuntimeError_for_invalid_argument) {
@@ -1384,6 +3191,13 @@ TEST_F(ContextTest, Boolean_RuntimeError_for_invalid_argument) {
 
     // set:
     EXPECT_EQ(context->execute("t set: 0;"), EXC_INVALID_ARGUMENT);
+
+    // getAndSet:
+    EXPECT_EQ(context->execute("t getAndSet: 42;"), EXC_INVALID_ARGUMENT);
+
+    // compareAndSet:to:
+    EXPECT_EQ(context->execute("t compareAndSet: 42 to: false;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("t compareAndSet: true to: 42;"), EXC_INVALID_ARGUMENT);
 }
     
 TEST_F(ContextTest, Character_RuntimeError_for_invalid_argument) {
@@ -1414,6 +3228,13 @@ TEST_F(ContextTest, Character_RuntimeError_for_invalid_argument) {
     
     // isGreaterThanOrEqualTo?
     EXPECT_EQ(context->execute("numeric isGreaterThanOrEqualTo? 0;"), EXC_INVALID_ARGUMENT);
+
+    // getAndSet:
+    EXPECT_EQ(context->execute("numeric getAndSet: 42;"), EXC_INVALID_ARGUMENT);
+
+    // compareAndSet:to:
+    EXPECT_EQ(context->execute("numeric compareAndSet: 42 to: '1';"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("numeric compareAndSet: '0' to: 42;"), EXC_INVALID_ARGUMENT);
 }
 
 TEST_F(ContextTest, Integer_RuntimeError_for_invalid_argument) {
@@ -1456,6 +3277,19 @@ TEST_F(ContextTest, Integer_RuntimeError_for_invalid_argument) {
 
     // divideBy:
     EXPECT_EQ(context->execute("i divideBy: '2';"), EXC_INVALID_ARGUMENT);
+
+    // addAndGet:
+    EXPECT_EQ(context->execute("i addAndGet: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // getAndAdd:
+    EXPECT_EQ(context->execute("i getAndAdd: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // getAndSet:
+    EXPECT_EQ(context->execute("i getAndSet: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // compareAndSet:to:
+    EXPECT_EQ(context->execute("i compareAndSet: \"42\" to: 43;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("i compareAndSet: 42 to: \"43\";"), EXC_INVALID_ARGUMENT);
 }
 
 TEST_F(ContextTest, Float_RuntimeError_for_invalid_argument) {
@@ -1498,6 +3332,19 @@ TEST_F(ContextTest, Float_RuntimeError_for_invalid_argument) {
 
     // divideBy:
     EXPECT_EQ(context->execute("f divideBy: false;"), EXC_INVALID_ARGUMENT);
+
+    // addAndGet:
+    EXPECT_EQ(context->execute("f addAndGet: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // getAndAdd:
+    EXPECT_EQ(context->execute("f getAndAdd: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // getAndSet:
+    EXPECT_EQ(context->execute("f getAndSet: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // compareAndSet:to:
+    EXPECT_EQ(context->execute("f compareAndSet: \"42\" to: 43.0;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("f compareAndSet: 42.0 to: \"43\";"), EXC_INVALID_ARGUMENT);
 }
 
 TEST_F(ContextTest, String_RuntimeError_for_invalid_argument) {
@@ -1579,6 +3426,13 @@ TEST_F(ContextTest, String_RuntimeError_for_invalid_argument) {
     // eraseFromIndex:toIndex:
     EXPECT_EQ(context->execute("str eraseFromIndex: \"42\" toIndex: 43;"), EXC_INVALID_ARGUMENT);
     EXPECT_EQ(context->execute("str eraseFromIndex: 42 toIndex: \"43\";"), EXC_INVALID_ARGUMENT);
+
+    // getAndSet:
+    EXPECT_EQ(context->execute("str getAndSet: 42;"), EXC_INVALID_ARGUMENT);
+
+    // compareAndSet:to:
+    EXPECT_EQ(context->execute("str compareAndSet: 42 to: \"knuckle\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("str compareAndSet: \"knuckleball\" to: 42;"), EXC_INVALID_ARGUMENT);
 }
 
 TEST_F(ContextTest, Vector_RuntimeError_for_invalid_argument) {
@@ -1668,6 +3522,16 @@ TEST_F(ContextTest, Vector_RuntimeError_for_invalid_argument) {
     // replaceAll:with:
     EXPECT_EQ(context->execute("prices replaceAll: \"42\" with: 42;"), EXC_INVALID_ARGUMENT);
     EXPECT_EQ(context->execute("prices replaceAll: 42 with: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // pushBackAll:
+    EXPECT_EQ(context->execute("prices pushBackAll: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("prices pushBackAll: [42, \"knuckleball\"];"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("prices get;"), "[]");
+
+    // getFrom:count:
+    EXPECT_EQ(context->execute("prices getFrom: \"42\" count: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("prices getFrom: 1 count: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("prices getFrom: 0 count: -1;"), EXC_INVALID_ARGUMENT);
 }
 
 TEST_F(ContextTest, Set_RuntimeError_for_invalid_argument) {
@@ -1687,6 +3551,105 @@ TEST_F(ContextTest, Set_RuntimeError_for_invalid_argument) {
 
     // remove:
     EXPECT_EQ(context->execute("ids remove: 42;"), EXC_INVALID_ARGUMENT);
+
+    // unionWith:
+    EXPECT_EQ(context->execute("Set<Integer> create: scores;"), "null");
+    EXPECT_EQ(context->execute("Vector<String> create: names;"), "null");
+    EXPECT_EQ(context->execute("ids unionWith: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ids unionWith: scores;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ids unionWith: names;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ids unionWith: unexistent;"), EXC_UNEXISTENT_VARIABLE);
+
+    // intersectWith:
+    EXPECT_EQ(context->execute("ids intersectWith: scores;"), EXC_INVALID_ARGUMENT);
+
+    // differenceWith:
+    EXPECT_EQ(context->execute("ids differenceWith: scores;"), EXC_INVALID_ARGUMENT);
+
+    // storeUnionOf:and:
+    EXPECT_EQ(context->execute("ids storeUnionOf: ids and: scores;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ids storeUnionOf: scores and: ids;"), EXC_INVALID_ARGUMENT);
+
+    // storeIntersectionOf:and:
+    EXPECT_EQ(context->execute("ids storeIntersectionOf: ids and: scores;"), EXC_INVALID_ARGUMENT);
+
+    // storeDifferenceOf:and:
+    EXPECT_EQ(context->execute("ids storeDifferenceOf: ids and: scores;"), EXC_INVALID_ARGUMENT);
+
+    // addAll:
+    EXPECT_EQ(context->execute("ids addAll: \"knuckleball\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ids addAll: [\"knuckleball\", 42];"), EXC_INVALID_ARGUMENT);
+
+    // scanFirst:
+    EXPECT_EQ(context->execute("ids scanFirst: -1;"), EXC_INVALID_ARGUMENT);
+
+    // scanFrom:count:
+    EXPECT_EQ(context->execute("ids scanFrom: 42 count: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ids scanFrom: \"knuckleball\" count: -1;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, SortedSet_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: scores;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("SortedSet<Integer> create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("SortedSet<Integer> createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // contains?
+    EXPECT_EQ(context->execute("scores contains? true;"), EXC_INVALID_ARGUMENT);
+
+    // add:
+    EXPECT_EQ(context->execute("scores add: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // remove:
+    EXPECT_EQ(context->execute("scores remove: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // rankOf:
+    EXPECT_EQ(context->execute("scores rankOf: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // atRank:
+    EXPECT_EQ(context->execute("scores atRank: \"0\";"), EXC_INVALID_ARGUMENT);
+
+    // rangeFromRank:toRank:
+    EXPECT_EQ(context->execute("scores rangeFromRank: \"0\" toRank: 0;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("scores rangeFromRank: 0 toRank: \"0\";"), EXC_INVALID_ARGUMENT);
+
+    // countBetween:and:
+    EXPECT_EQ(context->execute("scores countBetween: \"0\" and: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("scores countBetween: 0 and: \"42\";"), EXC_INVALID_ARGUMENT);
+
+    // addAll:
+    EXPECT_EQ(context->execute("scores addAll: [42, \"knuckleball\"];"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Multiset_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("Multiset<String> create: pitches;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("Multiset<String> create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("Multiset<String> createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // contains?
+    EXPECT_EQ(context->execute("pitches contains? 42;"), EXC_INVALID_ARGUMENT);
+
+    // countOf:
+    EXPECT_EQ(context->execute("pitches countOf: 42;"), EXC_INVALID_ARGUMENT);
+
+    // add:
+    EXPECT_EQ(context->execute("pitches add: 42;"), EXC_INVALID_ARGUMENT);
+
+    // remove:
+    EXPECT_EQ(context->execute("pitches remove: 42;"), EXC_INVALID_ARGUMENT);
+
+    // removeAll:
+    EXPECT_EQ(context->execute("pitches removeAll: 42;"), EXC_INVALID_ARGUMENT);
+
+    // addAll:
+    EXPECT_EQ(context->execute("pitches addAll: [\"knuckleball\", 42];"), EXC_INVALID_ARGUMENT);
 }
 
 TEST_F(ContextTest, Dictionary_RuntimeError_for_invalid_argument) {
@@ -1709,6 +3672,251 @@ TEST_F(ContextTest, Dictionary_RuntimeError_for_invalid_argument) {
 
     // removeKey:
     EXPECT_EQ(context->execute("ages removeKey: 42;"), EXC_INVALID_ARGUMENT);
+
+    // incrementValueForKey:by:
+    EXPECT_EQ(context->execute("ages incrementValueForKey: 42 by: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages incrementValueForKey: \"knuckleball\" by: \"1\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages get;"), "()");
+
+    // decrementValueForKey:by:
+    EXPECT_EQ(context->execute("ages decrementValueForKey: 42 by: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages decrementValueForKey: \"knuckleball\" by: \"1\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages get;"), "()");
+
+    // associateValues:withKeys:
+    EXPECT_EQ(context->execute("ages associateValues: 42 withKeys: [\"knuckleball\"];"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages associateValues: [42] withKeys: [42];"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages associateValues: [42, 21] withKeys: [\"knuckleball\"];"), EXC_INVALID_ARGUMENT);
+
+    // getValuesForKeys:
+    EXPECT_EQ(context->execute("ages getValuesForKeys: \"knuckleball\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages getValuesForKeys: [\"knuckleball\", 42];"), EXC_INVALID_ARGUMENT);
+
+    // scanFirst:
+    EXPECT_EQ(context->execute("ages scanFirst: \"knuckleball\";"), EXC_INVALID_ARGUMENT);
+
+    // scanFrom:count:
+    EXPECT_EQ(context->execute("ages scanFrom: 42 count: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("ages scanFrom: \"knuckleball\" count: -1;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Multidictionary_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: innings;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("Multidictionary<String, Integer> createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // containsKey?
+    EXPECT_EQ(context->execute("innings containsKey? true;"), EXC_INVALID_ARGUMENT);
+
+    // getValuesForKey:
+    EXPECT_EQ(context->execute("innings getValuesForKey: 42;"), EXC_INVALID_ARGUMENT);
+
+    // countValuesForKey:
+    EXPECT_EQ(context->execute("innings countValuesForKey: 42;"), EXC_INVALID_ARGUMENT);
+
+    // associateValue:withKey:
+    EXPECT_EQ(context->execute("innings associateValue: \"knuckleball\" withKey: 42;"), EXC_INVALID_ARGUMENT);
+
+    // removeValue:withKey:
+    EXPECT_EQ(context->execute("innings removeValue: \"knuckleball\" withKey: 42;"), EXC_INVALID_ARGUMENT);
+
+    // removeKey:
+    EXPECT_EQ(context->execute("innings removeKey: 42;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, PriorityQueue_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: bullpen;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("PriorityQueue<String> create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("PriorityQueue<String> createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // push:withPriority:
+    EXPECT_EQ(context->execute("bullpen push: 42 withPriority: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("bullpen push: \"knuckleball\" withPriority: \"42\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("bullpen size;"), "0");
+}
+
+TEST_F(ContextTest, Stream_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("Stream<String> create: plays;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("Stream<String> create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("Stream<String> createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // append:
+    EXPECT_EQ(context->execute("plays append: 42;"), EXC_INVALID_ARGUMENT);
+
+    // readFrom:count:
+    EXPECT_EQ(context->execute("plays readFrom: \"0\" count: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("plays readFrom: -1 count: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("plays readFrom: 0 count: -1;"), EXC_INVALID_ARGUMENT);
+
+    // readNext:forConsumer:
+    EXPECT_EQ(context->execute("plays readNext: \"1\" forConsumer: \"scores\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("plays readNext: 1 forConsumer: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("plays readNext: -1 forConsumer: \"scores\";"), EXC_INVALID_ARGUMENT);
+
+    // offsetOf:
+    EXPECT_EQ(context->execute("plays offsetOf: 42;"), EXC_INVALID_ARGUMENT);
+
+    // setOffset:forConsumer:
+    EXPECT_EQ(context->execute("plays setOffset: \"0\" forConsumer: \"scores\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("plays setOffset: 0 forConsumer: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("plays setOffset: -1 forConsumer: \"scores\";"), EXC_INVALID_ARGUMENT);
+
+    // trimBefore:
+    EXPECT_EQ(context->execute("plays trimBefore: \"0\";"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, Bitmap_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("Bitmap create: visitors;"), "null");
+    EXPECT_EQ(context->execute("Set<Integer> create: ids;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("Bitmap create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("Bitmap createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // getBit:
+    EXPECT_EQ(context->execute("visitors getBit: \"42\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors getBit: -1;"), EXC_INVALID_ARGUMENT);
+
+    // setBit:
+    EXPECT_EQ(context->execute("visitors setBit: \"42\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors setBit: -1;"), EXC_INVALID_ARGUMENT);
+
+    // clearBit:
+    EXPECT_EQ(context->execute("visitors clearBit: \"42\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors clearBit: -1;"), EXC_INVALID_ARGUMENT);
+
+    // countOnesFrom:to:
+    EXPECT_EQ(context->execute("visitors countOnesFrom: \"0\" to: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors countOnesFrom: 0 to: \"42\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors countOnesFrom: -1 to: 42;"), EXC_INVALID_ARGUMENT);
+
+    // andWith:
+    EXPECT_EQ(context->execute("visitors andWith: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors andWith: ids;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors andWith: buyers;"), EXC_UNEXISTENT_VARIABLE);
+
+    // orWith:
+    EXPECT_EQ(context->execute("visitors orWith: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors orWith: ids;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors orWith: buyers;"), EXC_UNEXISTENT_VARIABLE);
+
+    // xorWith:
+    EXPECT_EQ(context->execute("visitors xorWith: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors xorWith: ids;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors xorWith: buyers;"), EXC_UNEXISTENT_VARIABLE);
+}
+
+TEST_F(ContextTest, TimeSeries_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("TimeSeries create: speeds;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("TimeSeries create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("TimeSeries createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // append:at:
+    EXPECT_EQ(context->execute("speeds append: \"42\" at: 1000;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("speeds append: 42 at: 10.5;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("speeds append: 42 at: 1000;"), "null");
+    EXPECT_EQ(context->execute("speeds append: 42 at: 999;"), EXC_INVALID_ARGUMENT);
+
+    // rangeFrom:to:
+    EXPECT_EQ(context->execute("speeds rangeFrom: \"0\" to: 1000;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("speeds rangeFrom: 0 to: 1000.5;"), EXC_INVALID_ARGUMENT);
+
+    // avgFrom:to:bucket:
+    EXPECT_EQ(context->execute("speeds avgFrom: \"0\" to: 1000 bucket: 10;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("speeds avgFrom: 0 to: 1000 bucket: 0;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("speeds avgFrom: 0 to: 1000 bucket: -10;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, HyperLogLog_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: visitors;"), "null");
+    EXPECT_EQ(context->execute("HyperLogLog<Integer> create: ids;"), "null");
+    EXPECT_EQ(context->execute("Set<String> create: names;"), "null");
+
+    // create:
+    EXPECT_EQ(context->execute("HyperLogLog<String> create: 42;"), EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:
+    EXPECT_EQ(context->execute("HyperLogLog<String> createIfNotExists: 42;"), EXC_INVALID_ARGUMENT);
+
+    // add:
+    EXPECT_EQ(context->execute("visitors add: 42;"), EXC_INVALID_ARGUMENT);
+
+    // mergeWith:
+    EXPECT_EQ(context->execute("visitors mergeWith: 42;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors mergeWith: ids;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors mergeWith: names;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("visitors mergeWith: buyers;"), EXC_UNEXISTENT_VARIABLE);
+}
+
+TEST_F(ContextTest, BloomFilter_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("BloomFilter<String> create: seen withCapacity: 1000 falsePositiveRate: 0.01;"),
+              "null");
+
+    // create:withCapacity:falsePositiveRate:
+    EXPECT_EQ(context->execute("BloomFilter<String> create: 42 withCapacity: 1000 falsePositiveRate: 0.01;"),
+              EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("BloomFilter<String> create: ids withCapacity: 0.5 falsePositiveRate: 0.01;"),
+              EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("BloomFilter<String> create: ids withCapacity: 0 falsePositiveRate: 0.01;"),
+              EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("BloomFilter<String> create: ids withCapacity: 1000 falsePositiveRate: 0;"),
+              EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("BloomFilter<String> create: ids withCapacity: 1000 falsePositiveRate: 1;"),
+              EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:withCapacity:falsePositiveRate:
+    EXPECT_EQ(context->execute("BloomFilter<String> createIfNotExists: 42 withCapacity: 1000 "
+                               "falsePositiveRate: 0.01;"), EXC_INVALID_ARGUMENT);
+
+    // add:
+    EXPECT_EQ(context->execute("seen add: 42;"), EXC_INVALID_ARGUMENT);
+
+    // mightContain?
+    EXPECT_EQ(context->execute("seen mightContain? 42;"), EXC_INVALID_ARGUMENT);
+}
+
+TEST_F(ContextTest, CountMinSketch_RuntimeError_for_invalid_argument) {
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: hits withWidth: 1024 depth: 4;"), "null");
+
+    // create:withWidth:depth:
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: 42 withWidth: 1024 depth: 4;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: ids withWidth: 0 depth: 4;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: ids withWidth: 1024 depth: 0.5;"),
+              EXC_INVALID_ARGUMENT);
+
+    // create:withWidth:depth:topK:
+    EXPECT_EQ(context->execute("CountMinSketch<String> create: ids withWidth: 1024 depth: 4 topK: -1;"),
+              EXC_INVALID_ARGUMENT);
+
+    // createIfNotExists:withWidth:depth:
+    EXPECT_EQ(context->execute("CountMinSketch<String> createIfNotExists: 42 withWidth: 1024 depth: 4;"),
+              EXC_INVALID_ARGUMENT);
+
+    // increment:by:
+    EXPECT_EQ(context->execute("hits increment: 42 by: 1;"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("hits increment: \"knuckleball\" by: \"1\";"), EXC_INVALID_ARGUMENT);
+    EXPECT_EQ(context->execute("hits increment: \"knuckleball\" by: -1;"), EXC_INVALID_ARGUMENT);
+
+    // estimate:
+    EXPECT_EQ(context->execute("hits estimate: 42;"), EXC_INVALID_ARGUMENT);
 }
 
 ///////////////////////////////////////////////////// Corner cases /////////////////////////////////////////////////////
@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "count_min_sketch.h"
+
+class CountMinSketchTest: public ::testing::Test {
+protected:
+    CountMinSketch sketch;
+
+    virtual void SetUp() {
+        sketch = CountMinSketch(1024, 4, 3);
+        for (int i = 0; i < 1000; i++)
+            sketch.increment(std::to_string(i), 1 + i % 10);
+        sketch.increment("knuckle", 1000);
+        sketch.increment("ball", 2000);
+    }
+};
+
+TEST_F(CountMinSketchTest, dimensions) {
+    EXPECT_EQ(sketch.width(), 1024);
+    EXPECT_EQ(sketch.depth(), 4);
+    EXPECT_EQ(sketch.k(), 3);
+}
+
+TEST_F(CountMinSketchTest, total) {
+    EXPECT_EQ(sketch.total(), 8500);
+    sketch.increment("knuckle", 42);
+    EXPECT_EQ(sketch.total(), 8542);
+}
+
+TEST_F(CountMinSketchTest, increment) {
+    EXPECT_GE(sketch.increment("knuckle", 1), 1001);
+    EXPECT_GE(sketch.increment("pitch", 0), 0);
+}
+
+TEST_F(CountMinSketchTest, estimate) {
+    int overestimated = 0;
+    for (int i = 0; i < 1000; i++) {
+        int estimate = sketch.estimate(std::to_string(i));
+        EXPECT_GE(estimate, 1 + i % 10);
+        if (estimate > 1 + i % 10)
+            overestimated++;
+    }
+    EXPECT_LT(overestimated, 100);
+    EXPECT_GE(sketch.estimate("knuckle"), 1000);
+    EXPECT_LE(sketch.estimate("knuckle"), 1020);
+}
+
+TEST_F(CountMinSketchTest, top) {
+    auto top = sketch.top();
+    ASSERT_EQ(int(top.size()), 3);
+    EXPECT_EQ(top[0].first, "ball");
+    EXPECT_EQ(top[1].first, "knuckle");
+    EXPECT_GE(top[2].second, 10);
+    EXPECT_TRUE(CountMinSketch(1024, 4).top().empty());
+    CountMinSketch replaced(1024, 4, 2);
+    replaced.increment("knuckle", 5);
+    replaced.increment("ball", 3);
+    replaced.increment("pitch", 4);
+    replaced.increment("ball", 2);
+    top = replaced.top();
+    ASSERT_EQ(int(top.size()), 2);
+    EXPECT_EQ(top[0], std::make_pair(std::string("knuckle"), 5));
+    EXPECT_EQ(top[1], std::make_pair(std::string("ball"), 5));
+}
+
+TEST_F(CountMinSketchTest, clear) {
+    sketch.clear();
+    EXPECT_EQ(sketch.total(), 0);
+    EXPECT_EQ(sketch.estimate("knuckle"), 0);
+    EXPECT_TRUE(sketch.top().empty());
+}
@@ -294,6 +294,44 @@ TEST(Grammar, is_not_set_type) {
     EXPECT_FALSE(Grammar::is_set_type("Set<Integer> "));
 }
 
+TEST(Grammar, is_sorted_set_type) {
+    EXPECT_TRUE(Grammar::is_sorted_set_type("SortedSet<Boolean>"));
+    EXPECT_TRUE(Grammar::is_sorted_set_type("SortedSet< Character>"));
+    EXPECT_TRUE(Grammar::is_sorted_set_type("SortedSet<Integer >"));
+    EXPECT_TRUE(Grammar::is_sorted_set_type("SortedSet< String >"));
+}
+
+TEST(Grammar, is_not_sorted_set_type) {
+    EXPECT_FALSE(Grammar::is_sorted_set_type(""));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("SortedSet"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("Set<Integer>"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("SortedSet <Integer>"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("SortedSet<SortedSet<Integer>>"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("SortedSet<Integer, Integer>"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("sortedSet<Integer>"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type(" SortedSet<Integer>"));
+    EXPECT_FALSE(Grammar::is_sorted_set_type("SortedSet<Integer> "));
+}
+
+TEST(Grammar, is_multiset_type) {
+    EXPECT_TRUE(Grammar::is_multiset_type("Multiset<Boolean>"));
+    EXPECT_TRUE(Grammar::is_multiset_type("Multiset< Character>"));
+    EXPECT_TRUE(Grammar::is_multiset_type("Multiset<Integer >"));
+    EXPECT_TRUE(Grammar::is_multiset_type("Multiset< String >"));
+}
+
+TEST(Grammar, is_not_multiset_type) {
+    EXPECT_FALSE(Grammar::is_multiset_type(""));
+    EXPECT_FALSE(Grammar::is_multiset_type("Multiset"));
+    EXPECT_FALSE(Grammar::is_multiset_type("Set<Integer>"));
+    EXPECT_FALSE(Grammar::is_multiset_type("Multiset <Integer>"));
+    EXPECT_FALSE(Grammar::is_multiset_type("Multiset<Multiset<Integer>>"));
+    EXPECT_FALSE(Grammar::is_multiset_type("Multiset<Integer, Integer>"));
+    EXPECT_FALSE(Grammar::is_multiset_type("multiset<Integer>"));
+    EXPECT_FALSE(Grammar::is_multiset_type(" Multiset<Integer>"));
+    EXPECT_FALSE(Grammar::is_multiset_type("Multiset<Integer> "));
+}
+
 TEST(Grammar, is_dictionary_type) {
     EXPECT_TRUE(Grammar::is_dictionary_type("Dictionary<String, Boolean>"));
     EXPECT_TRUE(Grammar::is_dictionary_type("Dictionary< String, Integer>"));
@@ -314,10 +352,70 @@ TEST(Grammar, is_not_dictionary_type) {
     EXPECT_FALSE(Grammar::is_dictionary_type("Dictionary<String, Integer> "));
 }
 
+TEST(Grammar, is_multidictionary_type) {
+    EXPECT_TRUE(Grammar::is_multidictionary_type("Multidictionary<String, Boolean>"));
+    EXPECT_TRUE(Grammar::is_multidictionary_type("Multidictionary< String, Integer>"));
+    EXPECT_TRUE(Grammar::is_multidictionary_type("Multidictionary<String, Float >"));
+    EXPECT_TRUE(Grammar::is_multidictionary_type("Multidictionary< String , String >"));
+}
+
+TEST(Grammar, is_not_multidictionary_type) {
+    EXPECT_FALSE(Grammar::is_multidictionary_type(""));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("Multidictionary"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("Dictionary<String, Integer>"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("Multidictionary <String, Integer>"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("Multidictionary<String, Set<Integer>>"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("Multidictionary<Integer>"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("multidictionary<String, Integer>"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type(" Multidictionary<String, Integer>"));
+    EXPECT_FALSE(Grammar::is_multidictionary_type("Multidictionary<String, Integer> "));
+}
+
+TEST(Grammar, is_priority_queue_type) {
+    EXPECT_TRUE(Grammar::is_priority_queue_type("PriorityQueue<Boolean>"));
+    EXPECT_TRUE(Grammar::is_priority_queue_type("PriorityQueue< Character>"));
+    EXPECT_TRUE(Grammar::is_priority_queue_type("PriorityQueue<Integer >"));
+    EXPECT_TRUE(Grammar::is_priority_queue_type("PriorityQueue< String >"));
+}
+
+TEST(Grammar, is_not_priority_queue_type) {
+    EXPECT_FALSE(Grammar::is_priority_queue_type(""));
+    EXPECT_FALSE(Grammar::is_priority_queue_type("PriorityQueue"));
+    EXPECT_FALSE(Grammar::is_priority_queue_type("PriorityQueue <Integer>"));
+    EXPECT_FALSE(Grammar::is_priority_queue_type("PriorityQueue<PriorityQueue<Integer>>"));
+    EXPECT_FALSE(Grammar::is_priority_queue_type("PriorityQueue<Integer, Integer>"));
+    EXPECT_FALSE(Grammar::is_priority_queue_type("priorityQueue<Integer>"));
+    EXPECT_FALSE(Grammar::is_priority_queue_type(" PriorityQueue<Integer>"));
+    EXPECT_FALSE(Grammar::is_priority_queue_type("PriorityQueue<Integer> "));
+}
+
+TEST(Grammar, is_stream_type) {
+    EXPECT_TRUE(Grammar::is_stream_type("Stream<Boolean>"));
+    EXPECT_TRUE(Grammar::is_stream_type("Stream< Character>"));
+    EXPECT_TRUE(Grammar::is_stream_type("Stream<Integer >"));
+    EXPECT_TRUE(Grammar::is_stream_type("Stream< String >"));
+}
+
+TEST(Grammar, is_not_stream_type) {
+    EXPECT_FALSE(Grammar::is_stream_type(""));
+    EXPECT_FALSE(Grammar::is_stream_type("Stream"));
+    EXPECT_FALSE(Grammar::is_stream_type("Stream <Integer>"));
+    EXPECT_FALSE(Grammar::is_stream_type("Stream<Stream<Integer>>"));
+    EXPECT_FALSE(Grammar::is_stream_type("Stream<Integer, Integer>"));
+    EXPECT_FALSE(Grammar::is_stream_type("stream<Integer>"));
+    EXPECT_FALSE(Grammar::is_stream_type(" Stream<Integer>"));
+    EXPECT_FALSE(Grammar::is_stream_type("Stream<Integer> "));
+}
+
 TEST(Grammar, is_container_type) {
     EXPECT_TRUE(Grammar::is_container_type("Vector<Boolean>"));
     EXPECT_TRUE(Grammar::is_container_type("Set<Character>"));
+    EXPECT_TRUE(Grammar::is_container_type("SortedSet<Integer>"));
+    EXPECT_TRUE(Grammar::is_container_type("Multiset<Integer>"));
     EXPECT_TRUE(Grammar::is_container_type("Dictionary<String, Float>"));
+    EXPECT_TRUE(Grammar::is_container_type("Multidictionary<String, Float>"));
+    EXPECT_TRUE(Grammar::is_container_type("PriorityQueue<String>"));
+    EXPECT_TRUE(Grammar::is_container_type("Stream<String>"));
 }
 
 TEST(Grammar, is_not_container_type) {
@@ -326,6 +424,104 @@ TEST(Grammar, is_not_container_type) {
     EXPECT_FALSE(Grammar::is_container_type("Integer"));
     EXPECT_FALSE(Grammar::is_container_type("Float"));
     EXPECT_FALSE(Grammar::is_container_type("String"));
+    EXPECT_FALSE(Grammar::is_container_type("Bitmap"));
+    EXPECT_FALSE(Grammar::is_container_type("TimeSeries"));
+    EXPECT_FALSE(Grammar::is_container_type("HyperLogLog<String>"));
+    EXPECT_FALSE(Grammar::is_container_type("BloomFilter<String>"));
+    EXPECT_FALSE(Grammar::is_container_type("CountMinSketch<String>"));
+}
+
+TEST(Grammar, is_bitmap_type) {
+    EXPECT_TRUE(Grammar::is_bitmap_type("Bitmap"));
+}
+
+TEST(Grammar, is_not_bitmap_type) {
+    EXPECT_FALSE(Grammar::is_bitmap_type(""));
+    EXPECT_FALSE(Grammar::is_bitmap_type("bitmap"));
+    EXPECT_FALSE(Grammar::is_bitmap_type("BITMAP"));
+    EXPECT_FALSE(Grammar::is_bitmap_type("Bitmap<Integer>"));
+    EXPECT_FALSE(Grammar::is_bitmap_type(" Bitmap"));
+    EXPECT_FALSE(Grammar::is_bitmap_type("Bitmap "));
+}
+
+TEST(Grammar, is_time_series_type) {
+    EXPECT_TRUE(Grammar::is_time_series_type("TimeSeries"));
+}
+
+TEST(Grammar, is_not_time_series_type) {
+    EXPECT_FALSE(Grammar::is_time_series_type(""));
+    EXPECT_FALSE(Grammar::is_time_series_type("timeSeries"));
+    EXPECT_FALSE(Grammar::is_time_series_type("TIMESERIES"));
+    EXPECT_FALSE(Grammar::is_time_series_type("TimeSeries<Float>"));
+    EXPECT_FALSE(Grammar::is_time_series_type(" TimeSeries"));
+    EXPECT_FALSE(Grammar::is_time_series_type("TimeSeries "));
+}
+
+TEST(Grammar, is_hyperloglog_type) {
+    EXPECT_TRUE(Grammar::is_hyperloglog_type("HyperLogLog<Boolean>"));
+    EXPECT_TRUE(Grammar::is_hyperloglog_type("HyperLogLog< Character>"));
+    EXPECT_TRUE(Grammar::is_hyperloglog_type("HyperLogLog<Integer >"));
+    EXPECT_TRUE(Grammar::is_hyperloglog_type("HyperLogLog< String >"));
+}
+
+TEST(Grammar, is_not_hyperloglog_type) {
+    EXPECT_FALSE(Grammar::is_hyperloglog_type(""));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type("HyperLogLog"));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type("HyperLogLog <String>"));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type("HyperLogLog<Set<String>>"));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type("HyperLogLog<String, Integer>"));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type("hyperLogLog<String>"));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type(" HyperLogLog<String>"));
+    EXPECT_FALSE(Grammar::is_hyperloglog_type("HyperLogLog<String> "));
+}
+
+TEST(Grammar, is_bloom_filter_type) {
+    EXPECT_TRUE(Grammar::is_bloom_filter_type("BloomFilter<Boolean>"));
+    EXPECT_TRUE(Grammar::is_bloom_filter_type("BloomFilter< Character>"));
+    EXPECT_TRUE(Grammar::is_bloom_filter_type("BloomFilter<Integer >"));
+    EXPECT_TRUE(Grammar::is_bloom_filter_type("BloomFilter< String >"));
+}
+
+TEST(Grammar, is_not_bloom_filter_type) {
+    EXPECT_FALSE(Grammar::is_bloom_filter_type(""));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type("BloomFilter"));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type("BloomFilter <String>"));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type("BloomFilter<Set<String>>"));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type("BloomFilter<String, Integer>"));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type("bloomFilter<String>"));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type(" BloomFilter<String>"));
+    EXPECT_FALSE(Grammar::is_bloom_filter_type("BloomFilter<String> "));
+}
+
+TEST(Grammar, is_count_min_sketch_type) {
+    EXPECT_TRUE(Grammar::is_count_min_sketch_type("CountMinSketch<Boolean>"));
+    EXPECT_TRUE(Grammar::is_count_min_sketch_type("CountMinSketch< Character>"));
+    EXPECT_TRUE(Grammar::is_count_min_sketch_type("CountMinSketch<Integer >"));
+    EXPECT_TRUE(Grammar::is_count_min_sketch_type("CountMinSketch< String >"));
+}
+
+TEST(Grammar, is_not_count_min_sketch_type) {
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type(""));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type("CountMinSketch"));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type("CountMinSketch <String>"));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type("CountMinSketch<Set<String>>"));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type("CountMinSketch<String, Integer>"));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type("countMinSketch<String>"));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type(" CountMinSketch<String>"));
+    EXPECT_FALSE(Grammar::is_count_min_sketch_type("CountMinSketch<String> "));
+}
+
+TEST(Grammar, is_probabilistic_type) {
+    EXPECT_TRUE(Grammar::is_probabilistic_type("HyperLogLog<String>"));
+    EXPECT_TRUE(Grammar::is_probabilistic_type("BloomFilter<Integer>"));
+    EXPECT_TRUE(Grammar::is_probabilistic_type("CountMinSketch<String>"));
+}
+
+TEST(Grammar, is_not_probabilistic_type) {
+    EXPECT_FALSE(Grammar::is_probabilistic_type("String"));
+    EXPECT_FALSE(Grammar::is_probabilistic_type("Set<String>"));
+    EXPECT_FALSE(Grammar::is_probabilistic_type("Bitmap"));
+    EXPECT_FALSE(Grammar::is_probabilistic_type("TimeSeries"));
 }
 
 TEST(Grammar, is_type) {
@@ -336,7 +532,17 @@ TEST(Grammar, is_type) {
     EXPECT_TRUE(Grammar::is_type("String"));
     EXPECT_TRUE(Grammar::is_type("Vector<Boolean>"));
     EXPECT_TRUE(Grammar::is_type("Set<Character>"));
+    EXPECT_TRUE(Grammar::is_type("SortedSet<Integer>"));
+    EXPECT_TRUE(Grammar::is_type("Multiset<Integer>"));
     EXPECT_TRUE(Grammar::is_type("Dictionary<String, Integer>"));
+    EXPECT_TRUE(Grammar::is_type("Multidictionary<String, Integer>"));
+    EXPECT_TRUE(Grammar::is_type("PriorityQueue<String>"));
+    EXPECT_TRUE(Grammar::is_type("Stream<String>"));
+    EXPECT_TRUE(Grammar::is_type("Bitmap"));
+    EXPECT_TRUE(Grammar::is_type("TimeSeries"));
+    EXPECT_TRUE(Grammar::is_type("HyperLogLog<String>"));
+    EXPECT_TRUE(Grammar::is_type("BloomFilter<String>"));
+    EXPECT_TRUE(Grammar::is_type("CountMinSketch<String>"));
 }
 
 TEST(Grammar, is_not_type) {
@@ -385,7 +591,17 @@ TEST(Grammar, is_reserverd_word) {
     EXPECT_TRUE(Grammar::is_reserved_word("String"));
     EXPECT_TRUE(Grammar::is_reserved_word("Vector"));
     EXPECT_TRUE(Grammar::is_reserved_word("Set"));
+    EXPECT_TRUE(Grammar::is_reserved_word("SortedSet"));
+    EXPECT_TRUE(Grammar::is_reserved_word("Multiset"));
     EXPECT_TRUE(Grammar::is_reserved_word("Dictionary"));
+    EXPECT_TRUE(Grammar::is_reserved_word("Multidictionary"));
+    EXPECT_TRUE(Grammar::is_reserved_word("PriorityQueue"));
+    EXPECT_TRUE(Grammar::is_reserved_word("Stream"));
+    EXPECT_TRUE(Grammar::is_reserved_word("Bitmap"));
+    EXPECT_TRUE(Grammar::is_reserved_word("TimeSeries"));
+    EXPECT_TRUE(Grammar::is_reserved_word("HyperLogLog"));
+    EXPECT_TRUE(Grammar::is_reserved_word("BloomFilter"));
+    EXPECT_TRUE(Grammar::is_reserved_word("CountMinSketch"));
 }
 
 TEST(Grammar, is_not_reserverd_word) {
@@ -418,7 +634,16 @@ TEST(Grammar, is_not_identifier) {
     EXPECT_FALSE(Grammar::is_identifier("String"));
     EXPECT_FALSE(Grammar::is_identifier("Vector"));
     EXPECT_FALSE(Grammar::is_identifier("Set"));
+    EXPECT_FALSE(Grammar::is_identifier("Multiset"));
     EXPECT_FALSE(Grammar::is_identifier("Dictionary"));
+    EXPECT_FALSE(Grammar::is_identifier("Multidictionary"));
+    EXPECT_FALSE(Grammar::is_identifier("PriorityQueue"));
+    EXPECT_FALSE(Grammar::is_identifier("Stream"));
+    EXPECT_FALSE(Grammar::is_identifier("Bitmap"));
+    EXPECT_FALSE(Grammar::is_identifier("TimeSeries"));
+    EXPECT_FALSE(Grammar::is_identifier("HyperLogLog"));
+    EXPECT_FALSE(Grammar::is_identifier("BloomFilter"));
+    EXPECT_FALSE(Grammar::is_identifier("CountMinSketch"));
     EXPECT_FALSE(Grammar::is_identifier("_id"));
     EXPECT_FALSE(Grammar::is_identifier("2016id"));
     EXPECT_FALSE(Grammar::is_identifier(" id"));
@@ -494,6 +719,29 @@ TEST(Grammar, is_not_variable) {
     EXPECT_FALSE(Grammar::is_variable("prices "));
 }
 
+TEST(Grammar, is_list_value) {
+    EXPECT_TRUE(Grammar::is_list_value("[]"));
+    EXPECT_TRUE(Grammar::is_list_value("[ ]"));
+    EXPECT_TRUE(Grammar::is_list_value("[42]"));
+    EXPECT_TRUE(Grammar::is_list_value("[42, 4.2,true]"));
+    EXPECT_TRUE(Grammar::is_list_value("[ ',' , \"knuckle, ball\" ]"));
+    EXPECT_TRUE(Grammar::is_list_value("[\"\\\"]\"]"));
+    EXPECT_TRUE(Grammar::is_list_value("[prices, std::prices, 42]"));
+}
+
+TEST(Grammar, is_not_list_value) {
+    EXPECT_FALSE(Grammar::is_list_value(""));
+    EXPECT_FALSE(Grammar::is_list_value("42"));
+    EXPECT_FALSE(Grammar::is_list_value("[42"));
+    EXPECT_FALSE(Grammar::is_list_value("[42,]"));
+    EXPECT_FALSE(Grammar::is_list_value("[,42]"));
+    EXPECT_FALSE(Grammar::is_list_value("[42 21]"));
+    EXPECT_FALSE(Grammar::is_list_value("[Integer]"));
+    EXPECT_FALSE(Grammar::is_list_value("[isEmpty?]"));
+    EXPECT_FALSE(Grammar::is_list_value("[[42]]"));
+    EXPECT_FALSE(Grammar::is_list_value(" [42]"));
+}
+
 TEST(Grammar, is_actor) {
     EXPECT_TRUE(Grammar::is_actor("Connection"));
     EXPECT_TRUE(Grammar::is_actor("Context"));
@@ -504,7 +752,17 @@ TEST(Grammar, is_actor) {
     EXPECT_TRUE(Grammar::is_actor("String"));
     EXPECT_TRUE(Grammar::is_actor("Vector<Boolean>"));
     EXPECT_TRUE(Grammar::is_actor("Set<Float>"));
+    EXPECT_TRUE(Grammar::is_actor("SortedSet<Float>"));
+    EXPECT_TRUE(Grammar::is_actor("Multiset<Float>"));
     EXPECT_TRUE(Grammar::is_actor("Dictionary<String, Integer>"));
+    EXPECT_TRUE(Grammar::is_actor("Multidictionary<String, Integer>"));
+    EXPECT_TRUE(Grammar::is_actor("PriorityQueue<String>"));
+    EXPECT_TRUE(Grammar::is_actor("Stream<String>"));
+    EXPECT_TRUE(Grammar::is_actor("Bitmap"));
+    EXPECT_TRUE(Grammar::is_actor("TimeSeries"));
+    EXPECT_TRUE(Grammar::is_actor("HyperLogLog<String>"));
+    EXPECT_TRUE(Grammar::is_actor("BloomFilter<String>"));
+    EXPECT_TRUE(Grammar::is_actor("CountMinSketch<String>"));
     EXPECT_TRUE(Grammar::is_actor("prices"));
     EXPECT_TRUE(Grammar::is_actor("prices2016"));
     EXPECT_TRUE(Grammar::is_actor("prices_2016"));
@@ -552,6 +810,7 @@ TEST(Grammar, is_keyword_message_argument) {
     EXPECT_TRUE(Grammar::is_keyword_message_argument("42"));
     EXPECT_TRUE(Grammar::is_keyword_message_argument("std"));
     EXPECT_TRUE(Grammar::is_keyword_message_argument("std::prices"));
+    EXPECT_TRUE(Grammar::is_keyword_message_argument("[42, 21]"));
 }
 
 TEST(Grammar, is_not_keyword_message_argument) {
@@ -617,6 +876,7 @@ TEST(Grammar, is_statement) {
     EXPECT_TRUE(Grammar::is_statement("Integer create: i withValue: 42;"));
     EXPECT_TRUE(Grammar::is_statement("Dictionary<String, Integer> create: ages;"));
     EXPECT_TRUE(Grammar::is_statement("i isEqualTo? 42;"));
+    EXPECT_TRUE(Grammar::is_statement("prices pushBackAll: [42, 21];"));
 }
 
 TEST(Grammar, is_statement_corner_cases) {
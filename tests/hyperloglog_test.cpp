@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "hyperloglog.h"
+#include "str_utils.h"
+
+class HyperLogLogTest: public ::testing::Test {
+protected:
+    HyperLogLog small, large;
+
+    virtual void SetUp() {
+        for (int i = 0; i < 1000; i++)
+            small.add(str_utils::hash(std::to_string(i)));
+        for (int i = 0; i < 100000; i++)
+            large.add(str_utils::hash(std::to_string(i)));
+    }
+};
+
+TEST_F(HyperLogLogTest, empty) {
+    EXPECT_TRUE(HyperLogLog().empty());
+    EXPECT_FALSE(small.empty());
+    EXPECT_FALSE(large.empty());
+    large.clear();
+    EXPECT_TRUE(large.empty());
+}
+
+TEST_F(HyperLogLogTest, is_sparse) {
+    EXPECT_TRUE(HyperLogLog().is_sparse());
+    EXPECT_TRUE(small.is_sparse());
+    EXPECT_FALSE(large.is_sparse());
+    large.clear();
+    EXPECT_TRUE(large.is_sparse());
+}
+
+TEST_F(HyperLogLogTest, add) {
+    EXPECT_FALSE(small.add(str_utils::hash("0")));
+    EXPECT_FALSE(large.add(str_utils::hash("0")));
+    EXPECT_TRUE(HyperLogLog().add(str_utils::hash("0")));
+}
+
+TEST_F(HyperLogLogTest, estimate) {
+    EXPECT_EQ(HyperLogLog().estimate(), 0);
+    EXPECT_NEAR(small.estimate(), 1000, 20);
+    EXPECT_NEAR(large.estimate(), 100000, 3000);
+    for (int i = 0; i < 1000; i++)
+        small.add(str_utils::hash(std::to_string(i)));
+    EXPECT_NEAR(small.estimate(), 1000, 20);
+}
+
+TEST_F(HyperLogLogTest, merge) {
+    HyperLogLog other;
+    for (int i = 500; i < 1500; i++)
+        other.add(str_utils::hash(std::to_string(i)));
+    other.merge(small);
+    EXPECT_TRUE(other.is_sparse());
+    EXPECT_NEAR(other.estimate(), 1500, 30);
+    other.merge(large);
+    EXPECT_FALSE(other.is_sparse());
+    EXPECT_NEAR(other.estimate(), 100000, 3000);
+    small.merge(small);
+    EXPECT_NEAR(small.estimate(), 1000, 20);
+}
@@ -35,12 +35,22 @@ protected:
     }
 };
 
+/////////////////////////////////////////////////////// Instance ///////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, Instance_type_tag) {
+    EXPECT_EQ(sizeof(Instance::Type), 1u);
+    EXPECT_EQ(BooleanInstance("true").type_tag(), Instance::BOOLEAN);
+    EXPECT_EQ(StringInstance("\"knuckleball\"").type_tag(), Instance::STRING);
+    VectorInstance prices("Integer", "create:", std::vector<std::string>({"prices"}));
+    EXPECT_EQ(prices.type_tag(), Instance::VECTOR);
+    EXPECT_EQ(prices.type(), "Vector");
+}
+
 /////////////////////////////////////////////////////// Boolean ////////////////////////////////////////////////////////
 
 TEST_F(InstanceTest, Boolean_construction_with_representation_1) {
     BooleanInstance t("true");
     EXPECT_EQ(t.type(), "Boolean");
-    EXPECT_EQ(t.name(), "");
     EXPECT_EQ(t.value(), true);
     EXPECT_EQ(t.representation(), "true");
 }
@@ -48,7 +58,6 @@ TEST_F(InstanceTest, Boolean_construction_with_representation_1) {
 TEST_F(InstanceTest, Boolean_construction_with_representation_2) {
     BooleanInstance f("false");
     EXPECT_EQ(f.type(), "Boolean");
-    EXPECT_EQ(f.name(), "");
     EXPECT_EQ(f.value(), false);
     EXPECT_EQ(f.representation(), "false");
 }
@@ -56,7 +65,6 @@ TEST_F(InstanceTest, Boolean_construction_with_representation_2) {
 TEST_F(InstanceTest, Boolean_construction_with_message_1) {
     BooleanInstance t("create:withValue:", std::vector<std::string>({"b", "true"}));
     EXPECT_EQ(t.type(), "Boolean");
-    EXPECT_EQ(t.name(), "b");
     EXPECT_EQ(t.value(), true);
     EXPECT_EQ(t.representation(), "true");
 }
@@ -64,7 +72,6 @@ TEST_F(InstanceTest, Boolean_construction_with_message_1) {
 TEST_F(InstanceTest, Boolean_construction_with_message_2) {
     BooleanInstance f("create:withValue:", std::vector<std::string>({"b", "false"}));
     EXPECT_EQ(f.type(), "Boolean");
-    EXPECT_EQ(f.name(), "b");
     EXPECT_EQ(f.value(), false);
     EXPECT_EQ(f.representation(), "false");
 }
@@ -72,7 +79,6 @@ TEST_F(InstanceTest, Boolean_construction_with_message_2) {
 TEST_F(InstanceTest, Boolean_construction_with_message_3) {
     BooleanInstance t("createIfNotExists:withValue:", std::vector<std::string>({"b", "true"}));
     EXPECT_EQ(t.type(), "Boolean");
-    EXPECT_EQ(t.name(), "b");
     EXPECT_EQ(t.value(), true);
     EXPECT_EQ(t.representation(), "true");
 }
@@ -80,7 +86,6 @@ TEST_F(InstanceTest, Boolean_construction_with_message_3) {
 TEST_F(InstanceTest, Boolean_construction_with_message_4) {
     BooleanInstance f("createIfNotExists:withValue:", std::vector<std::string>({"b", "false"}));
     EXPECT_EQ(f.type(), "Boolean");
-    EXPECT_EQ(f.name(), "b");
     EXPECT_EQ(f.value(), false);
     EXPECT_EQ(f.representation(), "false");
 }
@@ -100,7 +105,6 @@ TEST_F(InstanceTest, Boolean_invalid_constructions) {
 TEST_F(InstanceTest, Character_construction_with_representation) {
     CharacterInstance numeric("'1'");
     EXPECT_EQ(numeric.type(), "Character");
-    EXPECT_EQ(numeric.name(), "");
     EXPECT_EQ(numeric.value(), '1');
     EXPECT_EQ(numeric.representation(), "'1'");
 }
@@ -108,7 +112,6 @@ TEST_F(InstanceTest, Character_construction_with_representation) {
 TEST_F(InstanceTest, Character_construction_with_message_1) {
     CharacterInstance numeric("create:withValue:", std::vector<std::string>({"numeric", "'1'"}));
     EXPECT_EQ(numeric.type(), "Character");
-    EXPECT_EQ(numeric.name(), "numeric");
     EXPECT_EQ(numeric.value(), '1');
     EXPECT_EQ(numeric.representation(), "'1'");
 }
@@ -116,7 +119,6 @@ TEST_F(InstanceTest, Character_construction_with_message_1) {
 TEST_F(InstanceTest, Character_construction_with_message_2) {
     CharacterInstance numeric("createIfNotExists:withValue:", std::vector<std::string>({"numeric", "'1'"}));
     EXPECT_EQ(numeric.type(), "Character");
-    EXPECT_EQ(numeric.name(), "numeric");
     EXPECT_EQ(numeric.value(), '1');
     EXPECT_EQ(numeric.representation(), "'1'");
 }
@@ -136,7 +138,6 @@ TEST_F(InstanceTest, CharacterInstance_invalid_constructions) {
 TEST_F(InstanceTest, Integer_construction_with_value) {
     IntegerInstance i(42);
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -144,7 +145,6 @@ TEST_F(InstanceTest, Integer_construction_with_value) {
 TEST_F(InstanceTest, Integer_construction_with_representation_1) {
     IntegerInstance i("+42");
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -152,7 +152,6 @@ TEST_F(InstanceTest, Integer_construction_with_representation_1) {
 TEST_F(InstanceTest, Integer_construction_with_representation_2) {
     IntegerInstance i("-42");
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "");
     EXPECT_EQ(i.value(), -42);
     EXPECT_EQ(i.representation(), "-42");
 }
@@ -160,7 +159,6 @@ TEST_F(InstanceTest, Integer_construction_with_representation_2) {
 TEST_F(InstanceTest, Integer_construction_with_representation_3) {
     IntegerInstance i("42.9");
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -168,7 +166,6 @@ TEST_F(InstanceTest, Integer_construction_with_representation_3) {
 TEST_F(InstanceTest, Integer_construction_with_message_1) {
     IntegerInstance i("create:withValue:", std::vector<std::string>({"i", "42"}));
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "i");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -176,7 +173,6 @@ TEST_F(InstanceTest, Integer_construction_with_message_1) {
 TEST_F(InstanceTest, Integer_construction_with_message_2) {
     IntegerInstance i("create:withValue:", std::vector<std::string>({"i", "-42"}));
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "i");
     EXPECT_EQ(i.value(), -42);
     EXPECT_EQ(i.representation(), "-42");
 }
@@ -184,7 +180,6 @@ TEST_F(InstanceTest, Integer_construction_with_message_2) {
 TEST_F(InstanceTest, Integer_construction_with_message_3) {
     IntegerInstance i("create:withValue:", std::vector<std::string>({"i", "42.9"}));
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "i");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -192,7 +187,6 @@ TEST_F(InstanceTest, Integer_construction_with_message_3) {
 TEST_F(InstanceTest, Integer_construction_with_message_4) {
     IntegerInstance i("createIfNotExists:withValue:", std::vector<std::string>({"i", "42"}));
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "i");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -200,7 +194,6 @@ TEST_F(InstanceTest, Integer_construction_with_message_4) {
 TEST_F(InstanceTest, Integer_construction_with_message_5) {
     IntegerInstance i("createIfNotExists:withValue:", std::vector<std::string>({"i", "-42"}));
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "i");
     EXPECT_EQ(i.value(), -42);
     EXPECT_EQ(i.representation(), "-42");
 }
@@ -208,7 +201,6 @@ TEST_F(InstanceTest, Integer_construction_with_message_5) {
 TEST_F(InstanceTest, Integer_construction_with_message_6) {
     IntegerInstance i("createIfNotExists:withValue:", std::vector<std::string>({"i", "42.9"}));
     EXPECT_EQ(i.type(), "Integer");
-    EXPECT_EQ(i.name(), "i");
     EXPECT_EQ(i.value(), 42);
     EXPECT_EQ(i.representation(), "42");
 }
@@ -228,70 +220,60 @@ TEST_F(InstanceTest, Integer_invalid_constructions) {
 TEST_F(InstanceTest, Float_construction_with_value) {
     FloatInstance f(42.0);
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "");
     EXPECT_EQ(f.representation(), "42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_representation_1) {
     FloatInstance f("42");
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "");
     EXPECT_EQ(f.representation(), "42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_representation_2) {
     FloatInstance f("-42.0");
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "");
     EXPECT_EQ(f.representation(), "-42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_representation_3) {
     FloatInstance f("1e-3");
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "");
     EXPECT_EQ(f.representation(), "0.001");
 }
 
 TEST_F(InstanceTest, Float_construction_with_message_1) {
     FloatInstance f("create:withValue:", std::vector<std::string>({"f", "42"}));
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "f");
     EXPECT_EQ(f.representation(), "42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_message_2) {
     FloatInstance f("create:withValue:", std::vector<std::string>({"f", "-42.0"}));
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "f");
     EXPECT_EQ(f.representation(), "-42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_message_3) {
     FloatInstance f("create:withValue:", std::vector<std::string>({"f", "1e-3"}));
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "f");
     EXPECT_EQ(f.representation(), "0.001");
 }
 
 TEST_F(InstanceTest, Float_construction_with_message_4) {
     FloatInstance f("createIfNotExists:withValue:", std::vector<std::string>({"f", "42"}));
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "f");
     EXPECT_EQ(f.representation(), "42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_message_5) {
     FloatInstance f("createIfNotExists:withValue:", std::vector<std::string>({"f", "-42.0"}));
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "f");
     EXPECT_EQ(f.representation(), "-42.000");
 }
 
 TEST_F(InstanceTest, Float_construction_with_message_6) {
     FloatInstance f("createIfNotExists:withValue:", std::vector<std::string>({"f", "1e-3"}));
     EXPECT_EQ(f.type(), "Float");
-    EXPECT_EQ(f.name(), "f");
     EXPECT_EQ(f.representation(), "0.001");
 }
 
@@ -310,7 +292,6 @@ TEST_F(InstanceTest, Float_invalid_constructions) {
 TEST_F(InstanceTest, String_construction_with_representation_1) {
     StringInstance str("\"\"");
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "");
     EXPECT_EQ(str.value(), "");
     EXPECT_EQ(str.representation(), "\"\"");
 }
@@ -318,7 +299,6 @@ TEST_F(InstanceTest, String_construction_with_representation_1) {
 TEST_F(InstanceTest, String_construction_with_representation_2) {
     StringInstance str("\"knuckleball\"");
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "");
     EXPECT_EQ(str.value(), "knuckleball");
     EXPECT_EQ(str.representation(), "\"knuckleball\"");
 }
@@ -326,7 +306,6 @@ TEST_F(InstanceTest, String_construction_with_representation_2) {
 TEST_F(InstanceTest, String_construction_with_message_1) {
     StringInstance str("create:", std::vector<std::string>({"str"}));
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "str");
     EXPECT_EQ(str.value(), "");
     EXPECT_EQ(str.representation(), "\"\"");
 }
@@ -334,7 +313,6 @@ TEST_F(InstanceTest, String_construction_with_message_1) {
 TEST_F(InstanceTest, String_construction_with_message_2) {
     StringInstance str("createIfNotExists:", std::vector<std::string>({"str"}));
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "str");
     EXPECT_EQ(str.value(), "");
     EXPECT_EQ(str.representation(), "\"\"");
 }
@@ -342,7 +320,6 @@ TEST_F(InstanceTest, String_construction_with_message_2) {
 TEST_F(InstanceTest, String_construction_with_message_3) {
     StringInstance str("create:withValue:", std::vector<std::string>({"str", "\"knuckleball\""}));
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "str");
     EXPECT_EQ(str.value(), "knuckleball");
     EXPECT_EQ(str.representation(), "\"knuckleball\"");
 }
@@ -350,7 +327,6 @@ TEST_F(InstanceTest, String_construction_with_message_3) {
 TEST_F(InstanceTest, String_construction_with_message_4) {
     StringInstance str("create:withValue:", std::vector<std::string>({"str", "\"knuckle\\\"ball\""}));
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "str");
     EXPECT_EQ(str.value(), "knuckle\"ball");
     EXPECT_EQ(str.representation(), "\"knuckle\\\"ball\"");
 }
@@ -358,7 +334,6 @@ TEST_F(InstanceTest, String_construction_with_message_4) {
 TEST_F(InstanceTest, String_construction_with_message_5) {
     StringInstance str("createIfNotExists:withValue:", std::vector<std::string>({"str", "\"knuckleball\""}));
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "str");
     EXPECT_EQ(str.value(), "knuckleball");
     EXPECT_EQ(str.representation(), "\"knuckleball\"");
 }
@@ -366,7 +341,6 @@ TEST_F(InstanceTest, String_construction_with_message_5) {
 TEST_F(InstanceTest, String_construction_with_message_6) {
     StringInstance str("createIfNotExists:withValue:", std::vector<std::string>({"str", "\"knuckle\\\"ball\""}));
     EXPECT_EQ(str.type(), "String");
-    EXPECT_EQ(str.name(), "str");
     EXPECT_EQ(str.value(), "knuckle\"ball");
     EXPECT_EQ(str.representation(), "\"knuckle\\\"ball\"");
 }
@@ -383,12 +357,27 @@ TEST_F(InstanceTest, String_invalid_constructions) {
     EXPECT_ANY_THROW(StringInstance("createIfNotExists:withValue:", std::vector<std::string>({"\"knuckleball\"", "str"})));
 }
 
+TEST_F(InstanceTest, String_intern) {
+    // holding either an owned or a pooled value costs no more than the owned value itself:
+    EXPECT_LE(sizeof(StringInstance), sizeof(IntegerInstance) + sizeof(std::string));
+    std::string value = "\"" + std::string(40, 'k') + "\"";
+    StringInstance first(value);
+    StringInstance second(value);
+    EXPECT_GE(first.memory_usage(), sizeof(StringInstance) + 40);
+    first.intern();
+    second.intern();
+    EXPECT_EQ(first.memory_usage(), sizeof(StringInstance));
+    EXPECT_EQ(second.memory_usage(), sizeof(StringInstance));
+    EXPECT_TRUE(first.shares_value_with(second));
+    EXPECT_EQ(first.representation(), value);
+    EXPECT_EQ(second.value(), std::string(40, 'k'));
+}
+
 //////////////////////////////////////////////////////// Vector ////////////////////////////////////////////////////////
 
 TEST_F(InstanceTest, Vector_construction) {
     VectorInstance prices("Integer", "create:", std::vector<std::string>({"prices"}));
     EXPECT_EQ(prices.type(), "Vector");
-    EXPECT_EQ(prices.name(), "prices");
     EXPECT_EQ(prices.representation(), "[]");
 }
 
@@ -403,7 +392,6 @@ TEST_F(InstanceTest, Vector_invalid_constructions) {
 TEST_F(InstanceTest, Set_construction) {
     SetInstance ids("String", "create:", std::vector<std::string>({"ids"}));
     EXPECT_EQ(ids.type(), "Set");
-    EXPECT_EQ(ids.name(), "ids");
     EXPECT_EQ(ids.representation(), "{}");
 }
 
@@ -413,12 +401,39 @@ TEST_F(InstanceTest, Set_invalid_constructions) {
     EXPECT_ANY_THROW(SetInstance("String", "create:", std::vector<std::string>({"ids", "42"})));
 }
 
+////////////////////////////////////////////////////// SortedSet ///////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, SortedSet_construction) {
+    SortedSetInstance scores("Integer", "create:", std::vector<std::string>({"scores"}));
+    EXPECT_EQ(scores.type(), "SortedSet");
+    EXPECT_EQ(scores.representation(), "{}");
+}
+
+TEST_F(InstanceTest, SortedSet_invalid_constructions) {
+    EXPECT_ANY_THROW(SortedSetInstance("Integer", "create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(SortedSetInstance("Integer", "create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(SortedSetInstance("Integer", "create:", std::vector<std::string>({"scores", "42"})));
+}
+
+/////////////////////////////////////////////////////// Multiset ///////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, Multiset_construction) {
+    MultisetInstance pitches("String", "create:", std::vector<std::string>({"pitches"}));
+    EXPECT_EQ(pitches.type(), "Multiset");
+    EXPECT_EQ(pitches.representation(), "{}");
+}
+
+TEST_F(InstanceTest, Multiset_invalid_constructions) {
+    EXPECT_ANY_THROW(MultisetInstance("String", "create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(MultisetInstance("String", "create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(MultisetInstance("String", "create:", std::vector<std::string>({"pitches", "42"})));
+}
+
 ////////////////////////////////////////////////////// Dictionary //////////////////////////////////////////////////////
 
 TEST_F(InstanceTest, Dictionary_construction) {
     DictionaryInstance ages("String", "Integer", "create:", std::vector<std::string>({"ages"}));
     EXPECT_EQ(ages.type(), "Dictionary");
-    EXPECT_EQ(ages.name(), "ages");
     EXPECT_EQ(ages.representation(), "()");
 }
 
@@ -427,3 +442,137 @@ TEST_F(InstanceTest, Dictionary_invalid_constructions) {
     EXPECT_ANY_THROW(DictionaryInstance("String", "Integer", "create:", std::vector<std::string>({"42"})));
     EXPECT_ANY_THROW(DictionaryInstance("String", "Integer", "create:", std::vector<std::string>({"ages", "42"})));
 }
+
+/////////////////////////////////////////////////// Multidictionary ////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, Multidictionary_construction) {
+    MultidictionaryInstance innings("String", "Integer", "create:", std::vector<std::string>({"innings"}));
+    EXPECT_EQ(innings.type(), "Multidictionary");
+    EXPECT_EQ(innings.representation(), "()");
+}
+
+TEST_F(InstanceTest, Multidictionary_invalid_constructions) {
+    EXPECT_ANY_THROW(MultidictionaryInstance("String", "Integer", "create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(MultidictionaryInstance("String", "Integer", "create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(MultidictionaryInstance("String", "Integer", "create:",
+                                             std::vector<std::string>({"innings", "42"})));
+}
+
+//////////////////////////////////////////////////// PriorityQueue /////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, PriorityQueue_construction) {
+    PriorityQueueInstance bullpen("String", "create:", std::vector<std::string>({"bullpen"}));
+    EXPECT_EQ(bullpen.type(), "PriorityQueue");
+    EXPECT_EQ(bullpen.representation(), "[]");
+}
+
+TEST_F(InstanceTest, PriorityQueue_invalid_constructions) {
+    EXPECT_ANY_THROW(PriorityQueueInstance("String", "create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(PriorityQueueInstance("String", "create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(PriorityQueueInstance("String", "create:", std::vector<std::string>({"bullpen", "42"})));
+}
+
+//////////////////////////////////////////////////////// Stream ////////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, Stream_construction) {
+    StreamInstance plays("String", "create:", std::vector<std::string>({"plays"}));
+    EXPECT_EQ(plays.type(), "Stream");
+    EXPECT_EQ(plays.representation(), "()");
+}
+
+TEST_F(InstanceTest, Stream_invalid_constructions) {
+    EXPECT_ANY_THROW(StreamInstance("String", "create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(StreamInstance("String", "create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(StreamInstance("String", "create:", std::vector<std::string>({"plays", "42"})));
+}
+
+//////////////////////////////////////////////////////// Bitmap ////////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, Bitmap_construction) {
+    BitmapInstance visitors("create:", std::vector<std::string>({"visitors"}));
+    EXPECT_EQ(visitors.type(), "Bitmap");
+    EXPECT_EQ(visitors.representation(), "{}");
+}
+
+TEST_F(InstanceTest, Bitmap_invalid_constructions) {
+    EXPECT_ANY_THROW(BitmapInstance("create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(BitmapInstance("create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(BitmapInstance("create:", std::vector<std::string>({"visitors", "42"})));
+}
+
+////////////////////////////////////////////////////// TimeSeries //////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, TimeSeries_construction) {
+    TimeSeriesInstance speeds("create:", std::vector<std::string>({"speeds"}));
+    EXPECT_EQ(speeds.type(), "TimeSeries");
+    EXPECT_EQ(speeds.representation(), "()");
+}
+
+TEST_F(InstanceTest, TimeSeries_invalid_constructions) {
+    EXPECT_ANY_THROW(TimeSeriesInstance("create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(TimeSeriesInstance("create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(TimeSeriesInstance("create:", std::vector<std::string>({"speeds", "42"})));
+}
+
+///////////////////////////////////////////////////// HyperLogLog //////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, HyperLogLog_construction) {
+    HyperLogLogInstance visitors("String", "create:", std::vector<std::string>({"visitors"}));
+    EXPECT_EQ(visitors.type(), "HyperLogLog");
+    EXPECT_EQ(visitors.representation(), "0");
+}
+
+TEST_F(InstanceTest, HyperLogLog_invalid_constructions) {
+    EXPECT_ANY_THROW(HyperLogLogInstance("String", "create:", std::vector<std::string>()));
+    EXPECT_ANY_THROW(HyperLogLogInstance("String", "create:", std::vector<std::string>({"42"})));
+    EXPECT_ANY_THROW(HyperLogLogInstance("String", "create:", std::vector<std::string>({"visitors", "42"})));
+}
+
+///////////////////////////////////////////////////// BloomFilter //////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, BloomFilter_construction) {
+    BloomFilterInstance seen("String", "create:withCapacity:falsePositiveRate:",
+                             std::vector<std::string>({"seen", "1000", "0.01"}));
+    EXPECT_EQ(seen.type(), "BloomFilter");
+    EXPECT_EQ(seen.representation(), "0");
+}
+
+TEST_F(InstanceTest, BloomFilter_invalid_constructions) {
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:", std::vector<std::string>({"seen"})));
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:withCapacity:falsePositiveRate:",
+                                         std::vector<std::string>({"seen", "1000"})));
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:withCapacity:falsePositiveRate:",
+                                         std::vector<std::string>({"42", "1000", "0.01"})));
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:withCapacity:falsePositiveRate:",
+                                         std::vector<std::string>({"seen", "-1", "0.01"})));
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:withCapacity:falsePositiveRate:",
+                                         std::vector<std::string>({"seen", "1000", "2"})));
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:withCapacity:falsePositiveRate:",
+                                         std::vector<std::string>({"seen", "2000000000", "0.01"})));
+    EXPECT_ANY_THROW(BloomFilterInstance("String", "create:withCapacity:falsePositiveRate:",
+                                         std::vector<std::string>({"seen", "100000000", "1e-30"})));
+}
+
+//////////////////////////////////////////////////// CountMinSketch ////////////////////////////////////////////////////
+
+TEST_F(InstanceTest, CountMinSketch_construction) {
+    CountMinSketchInstance hits("String", "create:withWidth:depth:", std::vector<std::string>({"hits", "1024", "4"}));
+    EXPECT_EQ(hits.type(), "CountMinSketch");
+    EXPECT_EQ(hits.representation(), "0");
+}
+
+TEST_F(InstanceTest, CountMinSketch_invalid_constructions) {
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:", std::vector<std::string>({"hits"})));
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:withWidth:depth:",
+                                            std::vector<std::string>({"hits", "1024"})));
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:withWidth:depth:",
+                                            std::vector<std::string>({"42", "1024", "4"})));
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:withWidth:depth:",
+                                            std::vector<std::string>({"hits", "1024", "-4"})));
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:withWidth:depth:topK:",
+                                            std::vector<std::string>({"hits", "1024", "4"})));
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:withWidth:depth:",
+                                            std::vector<std::string>({"hits", "16777216", "2"})));
+    EXPECT_ANY_THROW(CountMinSketchInstance("String", "create:withWidth:depth:topK:",
+                                            std::vector<std::string>({"hits", "1024", "4", "1001"})));
+}
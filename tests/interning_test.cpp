@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "interning.h"
+
+TEST(InterningTest, intern) {
+    size_t size = interning::size();
+    const std::string* first = interning::intern("knuckleball");
+    const std::string* second = interning::intern(std::string("knuckle") + "ball");
+    const std::string* third = interning::intern("knuckle");
+    EXPECT_EQ(*first, "knuckleball");
+    EXPECT_EQ(*third, "knuckle");
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, third);
+    EXPECT_EQ(interning::size(), size + 2);
+    interning::release(first);
+    interning::release(second);
+    interning::release(third);
+}
+
+TEST(InterningTest, release) {
+    size_t size = interning::size();
+    const std::string* first = interning::intern("knuckleball");
+    const std::string* second = interning::intern("knuckleball");
+    EXPECT_EQ(interning::size(), size + 1);
+    interning::release(first);
+    EXPECT_EQ(interning::size(), size + 1);
+    EXPECT_EQ(*second, "knuckleball");
+    interning::release(second);
+    EXPECT_EQ(interning::size(), size);
+    first = interning::intern("knuckleball");
+    EXPECT_EQ(*first, "knuckleball");
+    EXPECT_EQ(interning::size(), size + 1);
+    interning::release(first);
+}
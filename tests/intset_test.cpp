@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "intset.h"
+
+TEST(IntsetTest, insert) {
+    Intset intset;
+    EXPECT_EQ(intset.size(), 0);
+    intset.insert(42);
+    intset.insert(-7);
+    intset.insert(42);
+    intset.insert(0);
+    EXPECT_EQ(intset.size(), 3);
+    EXPECT_EQ(intset.values(), std::vector<int>({-7, 0, 42}));
+    intset.insert(std::vector<int>({5, 0, 100, 5, -8}));
+    EXPECT_EQ(intset.values(), std::vector<int>({-8, -7, 0, 5, 42, 100}));
+}
+
+TEST(IntsetTest, contains) {
+    Intset intset;
+    intset.insert(std::vector<int>({3, 1, 4, 1, 5, 9, 2, 6}));
+    EXPECT_TRUE(intset.contains(1));
+    EXPECT_TRUE(intset.contains(9));
+    EXPECT_FALSE(intset.contains(7));
+    EXPECT_FALSE(intset.contains(-1));
+    EXPECT_EQ(intset.lower_bound(0), 0);
+    EXPECT_EQ(intset.lower_bound(5), 4);
+    EXPECT_EQ(intset.lower_bound(7), 6);
+    EXPECT_EQ(intset.lower_bound(10), 7);
+}
+
+TEST(IntsetTest, erase) {
+    Intset intset;
+    intset.insert(std::vector<int>({1, 2, 3}));
+    intset.erase(2);
+    intset.erase(4);
+    EXPECT_EQ(intset.values(), std::vector<int>({1, 3}));
+    intset.clear();
+    EXPECT_EQ(intset.size(), 0);
+}
+
+TEST(IntsetTest, set_operations) {
+    Intset first, second, third;
+    first.insert(std::vector<int>({1, 2, 3, 4, 5}));
+    second.insert(std::vector<int>({4, 5, 6}));
+    for (int i = 0; i < 1000; i += 2)
+        third.insert(i);
+    EXPECT_EQ(Intset::union_of(first, second).values(), std::vector<int>({1, 2, 3, 4, 5, 6}));
+    EXPECT_EQ(Intset::intersection_of(first, second).values(), std::vector<int>({4, 5}));
+    EXPECT_EQ(Intset::difference_of(first, second).values(), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(Intset::difference_of(second, first).values(), std::vector<int>({6}));
+    EXPECT_EQ(Intset::intersection_of(first, third).values(), std::vector<int>({2, 4}));
+    EXPECT_EQ(Intset::intersection_of(third, first).values(), std::vector<int>({2, 4}));
+    EXPECT_EQ(Intset::difference_of(first, third).values(), std::vector<int>({1, 3, 5}));
+    EXPECT_EQ(Intset::difference_of(third, first).size(), 498);
+    EXPECT_EQ(Intset::union_of(first, third).size(), 503);
+}
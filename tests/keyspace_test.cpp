@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "context.h"
+#include "instance.h"
+#include "keyspace.h"
+
+class KeyspaceTest: public ::testing::Test {
+protected:
+    Keyspace keyspace;
+
+    virtual void SetUp() {
+        Context::get_instance("", 3, 1e-9, true);
+        keyspace.insert("i", integer(42));
+        keyspace.insert("std::i", integer(21));
+        keyspace.insert("std::j", integer(84));
+        keyspace.insert("uni::i", integer(63));
+    }
+
+    std::shared_ptr<Instance> integer(int value) {
+        return std::make_shared<IntegerInstance>(value);
+    }
+};
+
+TEST_F(KeyspaceTest, namespace_of) {
+    EXPECT_EQ(Keyspace::namespace_of("i"), "");
+    EXPECT_EQ(Keyspace::namespace_of("std::i"), "std");
+}
+
+TEST_F(KeyspaceTest, size) {
+    EXPECT_EQ(keyspace.size(), 4);
+    keyspace.erase_namespace("std");
+    EXPECT_EQ(keyspace.size(), 2);
+}
+
+TEST_F(KeyspaceTest, find) {
+    EXPECT_EQ(keyspace.find("i")->representation(), "42");
+    EXPECT_EQ(keyspace.find("std::i")->representation(), "21");
+    EXPECT_EQ(keyspace.find("j"), nullptr);
+    EXPECT_EQ(keyspace.find("uni::j"), nullptr);
+}
+
+TEST_F(KeyspaceTest, insert) {
+    EXPECT_FALSE(keyspace.insert("std::i", integer(0)));
+    EXPECT_EQ(keyspace.find("std::i")->representation(), "21");
+    EXPECT_TRUE(keyspace.insert("std::k", integer(0)));
+    EXPECT_EQ(keyspace.names_of_namespace("std"), std::vector<std::string>({"std::i", "std::j", "std::k"}));
+}
+
+TEST_F(KeyspaceTest, erase) {
+    EXPECT_TRUE(keyspace.erase("uni::i"));
+    EXPECT_FALSE(keyspace.erase("uni::i"));
+    EXPECT_TRUE(keyspace.erase("i"));
+    EXPECT_EQ(keyspace.names(), std::vector<std::string>({"std::i", "std::j"}));
+    EXPECT_EQ(keyspace.namespaces(), std::vector<std::string>({"std"}));
+}
+
+TEST_F(KeyspaceTest, erase_namespace) {
+    keyspace.erase_namespace("std");
+    keyspace.erase_namespace("knuckleball");
+    EXPECT_EQ(keyspace.find("std::i"), nullptr);
+    EXPECT_EQ(keyspace.names(), std::vector<std::string>({"i", "uni::i"}));
+    EXPECT_EQ(keyspace.namespaces(), std::vector<std::string>({"uni"}));
+}
+
+TEST_F(KeyspaceTest, rehash) {
+    EXPECT_TRUE(keyspace.is_rehashing());
+    EXPECT_EQ(keyspace.buckets(), 12);
+    while (keyspace.rehash(1))
+        continue;
+    EXPECT_FALSE(keyspace.is_rehashing());
+    EXPECT_EQ(keyspace.buckets(), 8);
+    for (int i = 0; i < 1000; i++) {
+        keyspace.insert("k" + std::to_string(i), integer(i));
+        keyspace.rehash(1);
+    }
+    EXPECT_EQ(keyspace.size(), 1004);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(keyspace.find("k" + std::to_string(i))->representation(), std::to_string(i));
+    while (keyspace.rehash(1))
+        EXPECT_LT(keyspace.rehash_progress(), 1);
+    EXPECT_EQ(keyspace.buckets(), 1024);
+    EXPECT_FLOAT_EQ(keyspace.load_factor(), 1004.0 / 1024);
+    EXPECT_FLOAT_EQ(keyspace.rehash_progress(), 1);
+}
+
+TEST_F(KeyspaceTest, rehash_while_erasing) {
+    for (int i = 0; i < 1000; i++)
+        keyspace.insert("std::k" + std::to_string(i), integer(i));
+    while (keyspace.rehash(1))
+        continue;
+    keyspace.erase_namespace("std");
+    EXPECT_TRUE(keyspace.is_rehashing());
+    EXPECT_EQ(keyspace.find("i")->representation(), "42");
+    EXPECT_TRUE(keyspace.erase("i"));
+    EXPECT_TRUE(keyspace.insert("j", integer(21)));
+    while (keyspace.rehash(1))
+        continue;
+    EXPECT_EQ(keyspace.buckets(), 4);
+    EXPECT_EQ(keyspace.names(), std::vector<std::string>({"j", "uni::i"}));
+}
+
+TEST_F(KeyspaceTest, names_of_namespace_while_rehashing) {
+    for (int i = 0; i < 100; i++)
+        keyspace.insert("uni::k" + std::to_string(i), integer(i));
+    for (int i = 0; i < 100; i += 3) {
+        keyspace.rehash(1);
+        EXPECT_TRUE(keyspace.erase("uni::k" + std::to_string(i)));
+    }
+    while (keyspace.rehash(1))
+        continue;
+    std::vector<std::string> names({"uni::i"});
+    for (int i = 0; i < 100; i++)
+        if (i % 3 != 0)
+            names.push_back("uni::k" + std::to_string(i));
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(keyspace.names_of_namespace("uni"), names);
+    keyspace.erase("uni::i");
+    keyspace.erase_namespace("uni");
+    EXPECT_EQ(keyspace.names_of_namespace("uni"), std::vector<std::string>());
+    EXPECT_EQ(keyspace.namespaces(), std::vector<std::string>({"std"}));
+    EXPECT_EQ(keyspace.size(), 3);
+}
+
+TEST_F(KeyspaceTest, names) {
+    EXPECT_EQ(keyspace.names(), std::vector<std::string>({"i", "std::i", "std::j", "uni::i"}));
+    EXPECT_EQ(keyspace.namespaces(), std::vector<std::string>({"std", "uni"}));
+    EXPECT_EQ(keyspace.names_of_namespace("std"), std::vector<std::string>({"std::i", "std::j"}));
+    EXPECT_EQ(keyspace.names_of_namespace("knuckleball"), std::vector<std::string>());
+}
+
+TEST_F(KeyspaceTest, sample) {
+    std::vector<std::string> names = keyspace.sample(10);
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, std::vector<std::string>({"i", "std::i", "std::j", "uni::i"}));
+    EXPECT_EQ(keyspace.sample(2).size(), 2);
+    names = keyspace.sample(10, "std");
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, std::vector<std::string>({"std::i", "std::j"}));
+    EXPECT_EQ(keyspace.sample(10, "knuckleball"), std::vector<std::string>());
+    for (int i = 0; i < 1000; i++)
+        keyspace.insert("k" + std::to_string(i), integer(i));
+    EXPECT_EQ(keyspace.sample(5).size(), 5);
+    EXPECT_EQ(keyspace.sample(5, "uni"), std::vector<std::string>({"uni::i"}));
+}
+
+TEST_F(KeyspaceTest, idle_time) {
+    EXPECT_EQ(keyspace.idle_time("i"), 3);
+    EXPECT_EQ(keyspace.idle_time("uni::i"), 0);
+    keyspace.find("i");
+    EXPECT_EQ(keyspace.idle_time("i"), 0);
+    EXPECT_EQ(keyspace.idle_time("uni::i"), 1);
+    EXPECT_EQ(keyspace.idle_time("j"), -1);
+}
+
+TEST_F(KeyspaceTest, frequency) {
+    EXPECT_EQ(keyspace.frequency("i"), 5);
+    for (int i = 0; i < 1000; i++)
+        keyspace.find("i");
+    EXPECT_GT(keyspace.frequency("i"), 5);
+    EXPECT_LT(keyspace.frequency("i"), 30);
+    EXPECT_EQ(keyspace.frequency("std::i"), 4);
+    EXPECT_EQ(keyspace.frequency("j"), -1);
+}
+
+TEST_F(KeyspaceTest, memory_usage) {
+    EXPECT_EQ(keyspace.memory_usage("std::i"), 0);
+    keyspace.set_memory_usage("std::i", 100);
+    keyspace.set_memory_usage("std::i", 60);
+    EXPECT_EQ(keyspace.memory_usage("std::i"), 60);
+    keyspace.set_memory_usage("i", 40);
+    EXPECT_EQ(keyspace.memory_usage(), 100);
+    keyspace.set_memory_usage("j", 40);
+    EXPECT_EQ(keyspace.memory_usage("j"), -1);
+    keyspace.erase("std::i");
+    EXPECT_EQ(keyspace.memory_usage(), 40);
+    keyspace.erase_namespace("std");
+    keyspace.erase("i");
+    EXPECT_EQ(keyspace.memory_usage(), 0);
+}
+
+TEST_F(KeyspaceTest, memory_usage_by_namespace) {
+    keyspace.set_memory_usage("i", 10);
+    keyspace.set_memory_usage("std::i", 20);
+    keyspace.set_memory_usage("std::j", 30);
+    EXPECT_EQ(keyspace.memory_usage_by_namespace(), (std::vector<std::pair<std::string, int64_t>>({
+        std::make_pair("std", 50), std::make_pair("uni", 0)})));
+    keyspace.erase("std::i");
+    keyspace.erase_namespace("uni");
+    EXPECT_EQ(keyspace.memory_usage_by_namespace(), (std::vector<std::pair<std::string, int64_t>>({
+        std::make_pair("std", 30)})));
+}
+
+TEST_F(KeyspaceTest, biggest) {
+    keyspace.set_memory_usage("i", 10);
+    keyspace.set_memory_usage("std::i", 30);
+    keyspace.set_memory_usage("uni::i", 20);
+    EXPECT_EQ(keyspace.biggest(2), (std::vector<std::pair<std::string, int64_t>>({
+        std::make_pair("std::i", 30), std::make_pair("uni::i", 20)})));
+    EXPECT_EQ(keyspace.biggest(5), (std::vector<std::pair<std::string, int64_t>>({
+        std::make_pair("std::i", 30), std::make_pair("uni::i", 20), std::make_pair("i", 10),
+        std::make_pair("std::j", 0)})));
+    EXPECT_EQ(keyspace.biggest(0), (std::vector<std::pair<std::string, int64_t>>()));
+}
@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "context.h"
+#include "instance.h"
+#include "listpack.h"
+
+class ListpackTest: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        Context::get_instance("", 3, 1e-9, true);
+    }
+
+    std::string representation_of(const Listpack& listpack) {
+        std::string representation;
+        std::vector<std::shared_ptr<Instance>> instances = listpack.instances();
+        for (auto it = instances.begin(); it != instances.end(); it++)
+            representation += (*it)->type() + ":" + (*it)->representation() + ";";
+        return representation;
+    }
+};
+
+TEST_F(ListpackTest, push_back) {
+    Listpack listpack;
+    EXPECT_EQ(listpack.size(), 0);
+    EXPECT_EQ(listpack.bytes(), 0);
+    listpack.push_back(BooleanInstance("true"));
+    listpack.push_back(CharacterInstance("'x'"));
+    listpack.push_back(IntegerInstance(0));
+    listpack.push_back(IntegerInstance(-1));
+    listpack.push_back(IntegerInstance(300));
+    listpack.push_back(IntegerInstance(-2147483647 - 1));
+    listpack.push_back(FloatInstance(-1.5));
+    listpack.push_back(StringInstance("\"\""));
+    listpack.push_back(StringInstance("\"say \\\"hi\\\"\""));
+    EXPECT_EQ(listpack.size(), 9);
+    EXPECT_EQ(listpack.bytes(), 2 + 2 + 2 + 2 + 3 + 6 + 5 + 2 + 10);
+    EXPECT_EQ(representation_of(listpack), "Boolean:true;Character:'x';Integer:0;Integer:-1;Integer:300;"
+                                           "Integer:-2147483648;Float:-1.500;String:\"\";String:\"say \\\"hi\\\"\";");
+}
+
+TEST_F(ListpackTest, representations) {
+    Listpack listpack;
+    EXPECT_EQ(listpack.representations(), std::vector<std::string>());
+    listpack.push_back(BooleanInstance("false"));
+    listpack.push_back(CharacterInstance("'x'"));
+    listpack.push_back(IntegerInstance(-300));
+    listpack.push_back(FloatInstance(2.25));
+    listpack.push_back(StringInstance("\"say \\\"hi\\\"\""));
+    EXPECT_EQ(listpack.representations(), std::vector<std::string>({"false", "'x'", "-300", "2.250",
+                                                                    "\"say \\\"hi\\\"\""}));
+    EXPECT_EQ(listpack.representation_at(0), "false");
+    EXPECT_EQ(listpack.representation_at(2), "-300");
+    EXPECT_EQ(listpack.representation_at(4), "\"say \\\"hi\\\"\"");
+}
+
+TEST_F(ListpackTest, index_of) {
+    Listpack listpack;
+    EXPECT_EQ(listpack.index_of(IntegerInstance(1), 0, 1), -1);
+    listpack.push_back(IntegerInstance(1));
+    listpack.push_back(IntegerInstance(-7));
+    listpack.push_back(IntegerInstance(1));
+    listpack.push_back(IntegerInstance(300));
+    EXPECT_EQ(listpack.index_of(IntegerInstance(1), 0, 1), 0);
+    EXPECT_EQ(listpack.index_of(IntegerInstance(1), 1, 1), 2);
+    EXPECT_EQ(listpack.index_of(IntegerInstance(300), 0, 1), 3);
+    EXPECT_EQ(listpack.index_of(IntegerInstance(300), 0, 2), -1);
+    EXPECT_EQ(listpack.index_of(IntegerInstance(1), 3, 1), -1);
+    EXPECT_EQ(listpack.index_of(FloatInstance(-7.0), 0, 1), 1);
+    EXPECT_THROW(listpack.index_of(StringInstance("\"1\""), 0, 1), const char*);
+
+    Listpack strings;
+    strings.push_back(StringInstance("\"knuckle\""));
+    strings.push_back(StringInstance("\"ball\""));
+    EXPECT_EQ(strings.index_of(StringInstance("\"ball\""), 0, 1), 1);
+    EXPECT_EQ(strings.index_of(StringInstance("\"knuckleball\""), 0, 1), -1);
+
+    Listpack floats;
+    floats.push_back(FloatInstance(0.5));
+    EXPECT_EQ(floats.index_of(FloatInstance(0.5 + 1e-10), 0, 1), 0);
+    EXPECT_EQ(floats.index_of(FloatInstance(0.75), 0, 1), -1);
+    EXPECT_EQ(floats.index_of(IntegerInstance(0), 0, 1), -1);
+}
+
+TEST_F(ListpackTest, lower_bound) {
+    Listpack listpack;
+    EXPECT_EQ(listpack.lower_bound(IntegerInstance(1), 1), 0);
+    listpack.push_back(IntegerInstance(-7));
+    listpack.push_back(IntegerInstance(1));
+    listpack.push_back(IntegerInstance(300));
+    EXPECT_EQ(listpack.lower_bound(IntegerInstance(-8), 1), 0);
+    EXPECT_EQ(listpack.lower_bound(IntegerInstance(1), 1), 1);
+    EXPECT_EQ(listpack.lower_bound(IntegerInstance(2), 1), 2);
+    EXPECT_EQ(listpack.lower_bound(IntegerInstance(301), 1), 3);
+    EXPECT_EQ(listpack.lower_bound(IntegerInstance(1), 2), 2);
+    EXPECT_TRUE(listpack.is_equal_at(1, IntegerInstance(1)));
+    EXPECT_FALSE(listpack.is_equal_at(2, IntegerInstance(1)));
+    EXPECT_THROW(listpack.lower_bound(StringInstance("\"1\""), 1), const char*);
+
+    Listpack pairs;
+    pairs.push_back(StringInstance("\"ball\""));
+    pairs.push_back(IntegerInstance(1));
+    pairs.push_back(StringInstance("\"knuckle\""));
+    pairs.push_back(IntegerInstance(2));
+    EXPECT_EQ(pairs.lower_bound(StringInstance("\"ball\""), 2), 0);
+    EXPECT_EQ(pairs.lower_bound(StringInstance("\"knuckle\""), 2), 2);
+    EXPECT_EQ(pairs.lower_bound(StringInstance("\"knuckleball\""), 2), 4);
+}
+
+TEST_F(ListpackTest, integer_at) {
+    Listpack listpack;
+    listpack.push_back(IntegerInstance(-7));
+    listpack.push_back(FloatInstance(2.5));
+    listpack.push_back(IntegerInstance(300));
+    EXPECT_EQ(listpack.integer_at(0), -7);
+    EXPECT_FLOAT_EQ(listpack.float_at(1), 2.5);
+    EXPECT_EQ(listpack.integer_at(2), 300);
+}
+
+TEST_F(ListpackTest, insert) {
+    Listpack listpack;
+    listpack.insert(0, IntegerInstance(2));
+    listpack.insert(0, IntegerInstance(1));
+    listpack.insert(2, StringInstance("\"knuckleball\""));
+    listpack.insert(1, CharacterInstance("'x'"));
+    EXPECT_EQ(listpack.size(), 4);
+    EXPECT_EQ(representation_of(listpack), "Integer:1;Character:'x';Integer:2;String:\"knuckleball\";");
+}
+
+TEST_F(ListpackTest, replace) {
+    Listpack listpack;
+    listpack.push_back(IntegerInstance(1));
+    listpack.push_back(IntegerInstance(2));
+    listpack.push_back(IntegerInstance(3));
+    int bytes = listpack.bytes();
+    listpack.replace(1, IntegerInstance(-2));
+    EXPECT_EQ(listpack.bytes(), bytes);
+    listpack.replace(0, IntegerInstance(300));
+    EXPECT_EQ(listpack.bytes(), bytes + 1);
+    listpack.replace(2, StringInstance("\"ball\""));
+    EXPECT_EQ(listpack.size(), 3);
+    EXPECT_EQ(representation_of(listpack), "Integer:300;Integer:-2;String:\"ball\";");
+}
+
+TEST_F(ListpackTest, erase) {
+    Listpack listpack;
+    listpack.push_back(IntegerInstance(1));
+    listpack.push_back(StringInstance("\"ball\""));
+    listpack.push_back(IntegerInstance(3));
+    listpack.erase(1);
+    EXPECT_EQ(representation_of(listpack), "Integer:1;Integer:3;");
+    listpack.erase(1);
+    listpack.erase(0);
+    EXPECT_EQ(listpack.size(), 0);
+    EXPECT_EQ(listpack.bytes(), 0);
+}
+
+TEST_F(ListpackTest, is_packable) {
+    EXPECT_TRUE(Listpack::is_packable(BooleanInstance("false")));
+    EXPECT_TRUE(Listpack::is_packable(CharacterInstance("'a'")));
+    EXPECT_TRUE(Listpack::is_packable(IntegerInstance(42)));
+    EXPECT_TRUE(Listpack::is_packable(FloatInstance(4.2)));
+    EXPECT_TRUE(Listpack::is_packable(StringInstance("\"" + std::string(Listpack::MAX_STRING_SIZE, 'a') + "\"")));
+    EXPECT_FALSE(Listpack::is_packable(StringInstance("\"" + std::string(Listpack::MAX_STRING_SIZE + 1, 'a') + "\"")));
+    EXPECT_FALSE(Listpack::is_packable(VectorInstance("Integer", "create:", std::vector<std::string>({"prices"}))));
+}
+
+TEST_F(ListpackTest, clear) {
+    Listpack listpack;
+    listpack.push_back(IntegerInstance(1));
+    listpack.push_back(IntegerInstance(2));
+    listpack.clear();
+    EXPECT_EQ(listpack.size(), 0);
+    EXPECT_EQ(listpack.bytes(), 0);
+    EXPECT_EQ(representation_of(listpack), "");
+    listpack.push_back(IntegerInstance(3));
+    EXPECT_EQ(representation_of(listpack), "Integer:3;");
+}
@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "context.h"
+#include "instance.h"
+#include "order_statistic_tree.h"
+
+class OrderStatisticTreeTest: public ::testing::Test {
+protected:
+    OrderStatisticTree tree;
+
+    virtual void SetUp() {
+        Context::get_instance("", 3, 1e-9, true);
+        for (int i = 0; i < 100; i++)
+            tree.insert(std::make_shared<IntegerInstance>((i * 37) % 100 * 2));
+    }
+
+    std::shared_ptr<Instance> integer(int value) {
+        return std::make_shared<IntegerInstance>(value);
+    }
+};
+
+TEST_F(OrderStatisticTreeTest, size) {
+    EXPECT_EQ(tree.size(), 100);
+    tree.clear();
+    EXPECT_EQ(tree.size(), 0);
+}
+
+TEST_F(OrderStatisticTreeTest, contains) {
+    EXPECT_TRUE(tree.contains(integer(0)));
+    EXPECT_TRUE(tree.contains(integer(42)));
+    EXPECT_TRUE(tree.contains(integer(198)));
+    EXPECT_FALSE(tree.contains(integer(43)));
+    EXPECT_FALSE(tree.contains(integer(200)));
+}
+
+TEST_F(OrderStatisticTreeTest, insert) {
+    EXPECT_FALSE(tree.insert(integer(42)));
+    EXPECT_EQ(tree.size(), 100);
+    EXPECT_TRUE(tree.insert(integer(43)));
+    EXPECT_EQ(tree.size(), 101);
+    EXPECT_EQ(tree.rank_of(integer(43)), 22);
+    EXPECT_EQ(tree.rank_of(integer(44)), 23);
+}
+
+TEST_F(OrderStatisticTreeTest, erase) {
+    EXPECT_FALSE(tree.erase(integer(43)));
+    EXPECT_EQ(tree.size(), 100);
+    EXPECT_TRUE(tree.erase(integer(42)));
+    EXPECT_EQ(tree.size(), 99);
+    EXPECT_FALSE(tree.contains(integer(42)));
+    EXPECT_EQ(tree.rank_of(integer(44)), 21);
+}
+
+TEST_F(OrderStatisticTreeTest, rank_of) {
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(tree.rank_of(integer(2 * i)), i);
+    EXPECT_EQ(tree.rank_of(integer(1)), -1);
+}
+
+TEST_F(OrderStatisticTreeTest, at_rank) {
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(static_cast<const IntegerInstance&>(*tree.at_rank(i)).value(), 2 * i);
+    EXPECT_EQ(tree.at_rank(-1), nullptr);
+    EXPECT_EQ(tree.at_rank(100), nullptr);
+}
+
+TEST_F(OrderStatisticTreeTest, count_less_than) {
+    EXPECT_EQ(tree.count_less_than(integer(0)), 0);
+    EXPECT_EQ(tree.count_less_than(integer(42)), 21);
+    EXPECT_EQ(tree.count_less_than(integer(43)), 22);
+    EXPECT_EQ(tree.count_less_than(integer(1000)), 100);
+}
+
+TEST_F(OrderStatisticTreeTest, count_less_than_or_equal_to) {
+    EXPECT_EQ(tree.count_less_than_or_equal_to(integer(-1)), 0);
+    EXPECT_EQ(tree.count_less_than_or_equal_to(integer(42)), 22);
+    EXPECT_EQ(tree.count_less_than_or_equal_to(integer(43)), 22);
+    EXPECT_EQ(tree.count_less_than_or_equal_to(integer(1000)), 100);
+}
+
+TEST_F(OrderStatisticTreeTest, range) {
+    std::vector<std::shared_ptr<Instance>> elements = tree.range(10, 15);
+    ASSERT_EQ(elements.size(), 5);
+    for (int i = 0; i < 5; i++)
+        EXPECT_EQ(static_cast<const IntegerInstance&>(*elements[i]).value(), 2 * (10 + i));
+    EXPECT_EQ(tree.range(0, 100).size(), 100);
+    EXPECT_EQ(tree.range(42, 42).size(), 0);
+}
@@ -150,6 +150,13 @@ TEST(Parser, corner_case_4) {
     EXPECT_EQ(parser.arguments(), std::vector<std::string>({"str", "\"one two three four\""}));
 }
 
+TEST(Parser, list_argument) {
+    Parser parser("ages associateValues: [42, 21] withKeys: [\"knuckle ball\", \"knuckleball\"];");
+    EXPECT_EQ(parser.actor(), "ages");
+    EXPECT_EQ(parser.message_name(), "associateValues:withKeys:");
+    EXPECT_EQ(parser.arguments(), std::vector<std::string>({"[42, 21]", "[\"knuckle ball\", \"knuckleball\"]"}));
+}
+
 ////////////////////////////////////////////////// Invalid statements //////////////////////////////////////////////////
 
 TEST(Parser, invalid_statements) {
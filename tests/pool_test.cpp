@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "pool.h"
+
+struct Point {
+    double x, y;
+
+    Point(double x, double y) : x(x), y(y) {}
+};
+
+class PoolTest: public ::testing::Test {
+protected:
+    std::shared_ptr<Point> point(double x, double y) {
+        return std::allocate_shared<Point>(PoolAllocator<Point>("Point"), x, y);
+    }
+
+    const Pool* pool_named(const std::string& name) {
+        std::vector<const Pool*> pools = Pool::pools();
+        auto it = std::find_if(pools.begin(), pools.end(), [&name](const Pool* pool) { return pool->name() == name; });
+        return (it != pools.end()) ? *it : nullptr;
+    }
+};
+
+TEST_F(PoolTest, allocate) {
+    std::vector<std::shared_ptr<Point>> points;
+    for (int i = 0; i < 1000; i++)
+        points.push_back(point(i, -i));
+    const Pool* pool = pool_named("Point");
+    ASSERT_NE(pool, nullptr);
+    EXPECT_GE(pool->block_size(), sizeof(Point));
+    EXPECT_EQ(pool->used_blocks(), 1000);
+    EXPECT_EQ(pool->blocks(), 1024);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(points[i]->x, i);
+        EXPECT_EQ(points[i]->y, -i);
+    }
+    points.resize(500);
+    EXPECT_EQ(pool->used_blocks(), 500);
+    for (int i = 0; i < 500; i++)
+        points.push_back(point(i, i));
+    EXPECT_EQ(pool->used_blocks(), 1000);
+    EXPECT_EQ(pool->blocks(), 1024);
+    points.clear();
+    EXPECT_EQ(pool->used_blocks(), 0);
+    EXPECT_EQ(pool->blocks(), 256);
+}
+
+TEST_F(PoolTest, release_empty_slabs) {
+    std::vector<std::shared_ptr<Point>> points;
+    for (int i = 0; i < 256 * 8; i++)
+        points.push_back(point(i, i));
+    const Pool* pool = pool_named("Point");
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(pool->blocks(), 256 * 8);
+
+    // freeing every other point keeps all the slabs partially used:
+    std::vector<std::shared_ptr<Point>> halves;
+    for (int i = 0; i < 256 * 8; i += 2)
+        halves.push_back(points[i]);
+    points.clear();
+    EXPECT_EQ(pool->used_blocks(), 256 * 4);
+    EXPECT_EQ(pool->blocks(), 256 * 8);
+
+    // new points fill the holes before any slab is allocated:
+    for (int i = 0; i < 256 * 4; i++)
+        points.push_back(point(i, i));
+    EXPECT_EQ(pool->used_blocks(), 256 * 8);
+    EXPECT_EQ(pool->blocks(), 256 * 8);
+
+    // empty slabs are released, except for one spare:
+    points.clear();
+    halves.clear();
+    EXPECT_EQ(pool->used_blocks(), 0);
+    EXPECT_EQ(pool->blocks(), 256);
+    points.push_back(point(1, 1));
+    EXPECT_EQ(pool->blocks(), 256);
+}
+
+TEST_F(PoolTest, deallocate_in_any_order) {
+    std::vector<std::shared_ptr<Point>> points;
+    for (int i = 0; i < 256 * 4; i++)
+        points.push_back(point(i, i));
+    const Pool* pool = pool_named("Point");
+    ASSERT_NE(pool, nullptr);
+
+    // blocks are taken back to their own slabs, whatever the order in which they are freed:
+    for (int step = 7; step > 0; step -= 2)
+        for (int i = step; i < 256 * 4; i += 8)
+            points[i].reset();
+    EXPECT_EQ(pool->used_blocks(), 256 * 2);
+    EXPECT_EQ(pool->blocks(), 256 * 4);
+    for (int i = 256 * 4 - 2; i >= 0; i -= 2)
+        points[i].reset();
+    EXPECT_EQ(pool->used_blocks(), 0);
+    EXPECT_EQ(pool->blocks(), 256);
+    for (int i = 0; i < 256 * 2; i++)
+        points[i] = point(-i, i);
+    EXPECT_EQ(pool->blocks(), 256 * 2);
+    for (int i = 0; i < 256 * 2; i++)
+        EXPECT_EQ(points[i]->x, -i);
+}
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "context.h"
+#include "instance.h"
+#include "priority_heap.h"
+
+class PriorityHeapTest: public ::testing::Test {
+protected:
+    PriorityHeap heap;
+
+    virtual void SetUp() {
+        Context::get_instance("", 3, 1e-9, true);
+        for (int i = 0; i < 100; i++)
+            heap.push(integer((i * 37) % 100), (i * 37) % 100);
+    }
+
+    std::shared_ptr<Instance> integer(int value) {
+        return std::make_shared<IntegerInstance>(value);
+    }
+};
+
+TEST_F(PriorityHeapTest, size) {
+    EXPECT_EQ(heap.size(), 100);
+    EXPECT_FALSE(heap.empty());
+    heap.clear();
+    EXPECT_EQ(heap.size(), 0);
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST_F(PriorityHeapTest, push) {
+    heap.push(integer(-1), -1);
+    EXPECT_EQ(heap.size(), 101);
+    EXPECT_EQ(heap.top()->representation(), "-1");
+    EXPECT_EQ(heap.top_priority(), -1);
+}
+
+TEST_F(PriorityHeapTest, top) {
+    EXPECT_EQ(heap.top()->representation(), "0");
+    EXPECT_EQ(heap.top_priority(), 0);
+    heap.clear();
+    EXPECT_EQ(heap.top(), nullptr);
+}
+
+TEST_F(PriorityHeapTest, pop) {
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(heap.pop()->representation(), integer(i)->representation());
+    EXPECT_EQ(heap.pop(), nullptr);
+}
+
+TEST_F(PriorityHeapTest, pop_ties_in_insertion_order) {
+    heap.clear();
+    for (int i = 0; i < 10; i++)
+        heap.push(integer(i), i % 2);
+    for (int i = 0; i < 10; i += 2)
+        EXPECT_EQ(heap.pop()->representation(), integer(i)->representation());
+    for (int i = 1; i < 10; i += 2)
+        EXPECT_EQ(heap.pop()->representation(), integer(i)->representation());
+}
+
+TEST_F(PriorityHeapTest, elements) {
+    std::vector<std::shared_ptr<Instance>> elements = heap.elements();
+    ASSERT_EQ(int(elements.size()), 100);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(elements[i]->representation(), integer(i)->representation());
+    EXPECT_EQ(heap.size(), 100);
+}
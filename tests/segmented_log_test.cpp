@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "context.h"
+#include "instance.h"
+#include "segmented_log.h"
+
+class SegmentedLogTest: public ::testing::Test {
+protected:
+    SegmentedLog log;
+
+    virtual void SetUp() {
+        Context::get_instance("", 3, 1e-9, true);
+        for (int i = 0; i < 3000; i++)
+            log.append(integer(i * 2));
+    }
+
+    std::shared_ptr<Instance> integer(int value) {
+        return std::make_shared<IntegerInstance>(value);
+    }
+};
+
+TEST_F(SegmentedLogTest, size) {
+    EXPECT_EQ(log.size(), 3000);
+    EXPECT_FALSE(log.empty());
+    log.clear();
+    EXPECT_EQ(log.size(), 0);
+    EXPECT_TRUE(log.empty());
+}
+
+TEST_F(SegmentedLogTest, append) {
+    EXPECT_EQ(log.append(integer(42)), 3000);
+    EXPECT_EQ(log.append(integer(42)), 3001);
+    EXPECT_EQ(log.size(), 3002);
+    EXPECT_EQ(log.first_id(), 0);
+    EXPECT_EQ(log.next_id(), 3002);
+}
+
+TEST_F(SegmentedLogTest, read) {
+    std::vector<std::pair<int, std::shared_ptr<Instance>>> entries = log.read(1020, 10);
+    ASSERT_EQ(int(entries.size()), 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(entries[i].first, 1020 + i);
+        EXPECT_EQ(entries[i].second->representation(), integer((1020 + i) * 2)->representation());
+    }
+    EXPECT_EQ(int(log.read(2990, 42).size()), 10);
+    EXPECT_EQ(int(log.read(3000, 42).size()), 0);
+    EXPECT_EQ(int(log.read(0, 0).size()), 0);
+}
+
+TEST_F(SegmentedLogTest, trim_before) {
+    log.trim_before(2050);
+    EXPECT_EQ(log.size(), 950);
+    EXPECT_EQ(log.first_id(), 2050);
+    std::vector<std::pair<int, std::shared_ptr<Instance>>> entries = log.read(0, 2);
+    ASSERT_EQ(int(entries.size()), 2);
+    EXPECT_EQ(entries[0].first, 2050);
+    EXPECT_EQ(entries[1].second->representation(), integer(4102)->representation());
+    log.trim_before(42);
+    EXPECT_EQ(log.first_id(), 2050);
+    log.trim_before(4000);
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(log.first_id(), 3000);
+    EXPECT_EQ(log.append(integer(42)), 3000);
+    EXPECT_EQ(log.read(0, 1)[0].first, 3000);
+}
+
+TEST_F(SegmentedLogTest, clear) {
+    log.clear();
+    EXPECT_EQ(log.first_id(), 3000);
+    EXPECT_EQ(log.append(integer(42)), 3000);
+    EXPECT_EQ(log.size(), 1);
+    EXPECT_EQ(log.read(0, 42)[0].second->representation(), integer(42)->representation());
+}
@@ -157,3 +157,26 @@ TEST(str_utils, remove_spaces) {
     EXPECT_EQ(str_utils::remove_spaces("knuckleball"), "knuckleball");
     EXPECT_EQ(str_utils::remove_spaces(" knuckle\nball\t"), "knuckleball");
 }
+
+TEST(str_utils, find_unquoted) {
+    EXPECT_EQ(str_utils::find_unquoted("", ']', 0), 0);
+    EXPECT_EQ(str_utils::find_unquoted("[42]", ']', 0), 3);
+    EXPECT_EQ(str_utils::find_unquoted("[42]", ']', 4), 4);
+    EXPECT_EQ(str_utils::find_unquoted("[']', \"]\"]", ']', 0), 9);
+    EXPECT_EQ(str_utils::find_unquoted("[\"\\\"]\"]", ']', 0), 6);
+    EXPECT_EQ(str_utils::find_unquoted("[\"]", ']', 0), 3);
+}
+
+TEST(str_utils, split_list) {
+    EXPECT_EQ(str_utils::split_list(""), std::vector<std::string>({""}));
+    EXPECT_EQ(str_utils::split_list("knuckleball"), std::vector<std::string>({"knuckleball"}));
+    EXPECT_EQ(str_utils::split_list("knuckle, ball"), std::vector<std::string>({"knuckle", " ball"}));
+    EXPECT_EQ(str_utils::split_list("',',\"a,b\""), std::vector<std::string>({"','", "\"a,b\""}));
+    EXPECT_EQ(str_utils::split_list("\"\\\",\",42"), std::vector<std::string>({"\"\\\",\"", "42"}));
+}
+
+TEST(str_utils, hash) {
+    EXPECT_EQ(str_utils::hash("knuckleball"), str_utils::hash("knuckleball"));
+    EXPECT_NE(str_utils::hash("knuckleball"), str_utils::hash("knuckleballs"));
+    EXPECT_NE(str_utils::hash(""), str_utils::hash(" "));
+}
@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "time_series.h"
+
+class TimeSeriesTest: public ::testing::Test {
+protected:
+    TimeSeries series;
+    std::vector<std::pair<int64_t, float>> samples;
+
+    virtual void SetUp() {
+        int64_t timestamp = 1000000;
+        for (int i = 0; i < 1000; i++) {
+            timestamp += (i % 100 == 99) ? 100000 + i : 10 + (i % 7 == 0) - (i % 11 == 0);
+            float value = (i % 5 == 0) ? 21.5f : 21.5f + (i % 13) * 0.25f - (i % 3);
+            samples.push_back(std::make_pair(timestamp, value));
+            series.append(timestamp, value);
+        }
+    }
+};
+
+TEST_F(TimeSeriesTest, size) {
+    EXPECT_EQ(series.size(), 1000);
+    EXPECT_FALSE(series.empty());
+    series.clear();
+    EXPECT_EQ(series.size(), 0);
+    EXPECT_TRUE(series.empty());
+}
+
+TEST_F(TimeSeriesTest, append) {
+    EXPECT_FALSE(series.append(samples.back().first - 1, 42));
+    EXPECT_TRUE(series.append(samples.back().first, 42));
+    EXPECT_TRUE(series.append(INT64_MAX, -42));
+    EXPECT_EQ(series.size(), 1002);
+    std::vector<std::pair<int64_t, float>> last = series.range(samples.back().first + 1, INT64_MAX);
+    EXPECT_TRUE(last.empty());
+    last = series.range(samples.back().first, INT64_MAX);
+    ASSERT_EQ(int(last.size()), 2);
+    EXPECT_EQ(last[1].second, 42);
+}
+
+TEST_F(TimeSeriesTest, range) {
+    EXPECT_EQ(series.range(INT64_MIN, INT64_MAX), samples);
+    std::vector<std::pair<int64_t, float>> middle(samples.begin() + 300, samples.begin() + 700);
+    EXPECT_EQ(series.range(samples[300].first, samples[700].first), middle);
+    EXPECT_TRUE(series.range(samples[300].first, samples[300].first).empty());
+    EXPECT_TRUE(series.range(0, samples[0].first).empty());
+}
+
+TEST_F(TimeSeriesTest, average) {
+    int64_t from = samples[0].first, to = samples[250].first, bucket = 50;
+    std::vector<std::pair<int64_t, double>> averages = series.average(from, to, bucket);
+    std::vector<std::pair<int64_t, double>> expected;
+    for (int i = 0; i < 250; i++) {
+        int64_t bucket_begin = from + (samples[i].first - from) / bucket * bucket;
+        if (expected.empty() || expected.back().first != bucket_begin)
+            expected.push_back(std::make_pair(bucket_begin, 0.0));
+    }
+    ASSERT_EQ(averages.size(), expected.size());
+    for (int i = 0; i < int(expected.size()); i++) {
+        double sum = 0;
+        int count = 0;
+        for (int j = 0; j < 250; j++)
+            if (samples[j].first >= expected[i].first && samples[j].first < expected[i].first + bucket) {
+                sum += samples[j].second;
+                count++;
+            }
+        EXPECT_EQ(averages[i].first, expected[i].first);
+        EXPECT_DOUBLE_EQ(averages[i].second, sum / count);
+    }
+    EXPECT_TRUE(series.average(0, samples[0].first, bucket).empty());
+}
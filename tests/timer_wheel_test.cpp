@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2016, Rodrigo Alves Lima
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+       following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+       following disclaimer in the documentation and/or other materials provided with the distribution.
+
+    3. Neither the name of Knuckleball nor the names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "timer_wheel.h"
+
+class TimerWheelTest: public ::testing::Test {
+protected:
+    TimerWheel wheel;
+
+    TimerWheelTest() : wheel(1000) {}
+
+    virtual void SetUp() {
+        wheel.schedule("a", 1010);
+        wheel.schedule("b", 1100);
+        wheel.schedule("c", 6000);
+        wheel.schedule("d", 1010);
+    }
+};
+
+TEST_F(TimerWheelTest, size) {
+    EXPECT_EQ(wheel.size(), 4);
+    wheel.advance(1010);
+    EXPECT_EQ(wheel.size(), 2);
+    wheel.clear();
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(TimerWheelTest, now) {
+    EXPECT_EQ(wheel.now(), 1000);
+    wheel.advance(5000);
+    EXPECT_EQ(wheel.now(), 5000);
+    wheel.advance(4000);
+    EXPECT_EQ(wheel.now(), 5000);
+}
+
+TEST_F(TimerWheelTest, schedule) {
+    wheel.schedule("e", 500);
+    EXPECT_EQ(wheel.advance(1001), std::vector<std::string>({"e"}));
+    wheel.schedule("f", int64_t(1) << 40);
+    EXPECT_EQ(wheel.size(), 5);
+    wheel.schedule("g", 1001);
+    EXPECT_EQ(wheel.advance(1001), std::vector<std::string>({"g"}));
+    EXPECT_EQ(wheel.advance((int64_t(1) << 40) - 1), std::vector<std::string>({"a", "d", "b", "c"}));
+    EXPECT_EQ(wheel.advance(int64_t(1) << 40), std::vector<std::string>({"f"}));
+}
+
+TEST_F(TimerWheelTest, advance) {
+    EXPECT_EQ(wheel.advance(1009), std::vector<std::string>());
+    EXPECT_EQ(wheel.advance(1010), std::vector<std::string>({"a", "d"}));
+    EXPECT_EQ(wheel.advance(1099), std::vector<std::string>());
+    EXPECT_EQ(wheel.advance(1100), std::vector<std::string>({"b"}));
+    EXPECT_EQ(wheel.advance(5999), std::vector<std::string>());
+    EXPECT_EQ(wheel.advance(6000), std::vector<std::string>({"c"}));
+    EXPECT_EQ(wheel.size(), 0);
+    for (int i = 0; i < 5000; i++)
+        wheel.schedule(std::to_string(i), 6001 + i * 997);
+    for (int i = 0; i < 5000; i++)
+        EXPECT_EQ(wheel.advance(6001 + i * 997), std::vector<std::string>({std::to_string(i)}));
+}
+
+TEST_F(TimerWheelTest, clear) {
+    wheel.clear();
+    EXPECT_EQ(wheel.advance(10000), std::vector<std::string>());
+}